@@ -4,8 +4,10 @@
 #include <sys/types.h>
 #include <unistd.h>
 #include <algorithm>
+#include <deque>
 #include <functional>
 #include <future>
+#include <memory>
 #include <fmt/format.h>
 
 #include "com/centreon/engine/anomalydetection.hh"
@@ -26,6 +28,7 @@
 #include "com/centreon/engine/hostgroup.hh"
 #include "com/centreon/engine/logging.hh"
 #include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/profiler.hh"
 #include "com/centreon/engine/service.hh"
 #include "com/centreon/engine/servicedependency.hh"
 #include "com/centreon/engine/servicegroup.hh"
@@ -120,6 +123,71 @@ grpc::Status engine_impl::ProcessHostCheckResult(grpc::ServerContext* context
   return grpc::Status::OK;
 }
 
+/**
+ * @brief Receive a stream of passive check result batches. Each batch is
+ * enqueued as one command and applied by the main loop in a single pass.
+ *
+ * When too many batches of this stream are still waiting for the main loop,
+ * or when the command queue is too deep, we stop reading the stream until
+ * the oldest batch is applied: the gRPC flow control then slows the client
+ * down.
+ *
+ * @param context gRPC context
+ * @param reader The batches stream.
+ * @param response One status per check result, in the submission order.
+ *
+ * @return Status::OK, or UNAVAILABLE if the engine stopped before applying
+ * all the batches.
+ */
+grpc::Status engine_impl::ProcessCheckResults(
+    grpc::ServerContext* context __attribute__((unused)),
+    grpc::ServerReader<CheckResultBatch>* reader,
+    CheckResultsStatus* response) {
+  constexpr size_t max_pending_batches = 16;
+  constexpr size_t max_queue_size = 256;
+
+  struct pending_batch {
+    std::future<int> done;
+    std::shared_ptr<CheckResultsStatus> status;
+  };
+  std::deque<pending_batch> pending;
+
+  /* Wait for the oldest batch and append its statuses to the response. */
+  auto collect = [&pending, response]() {
+    pending.front().done.get();
+    CheckResultsStatus const& status(*pending.front().status);
+    response->mutable_statuses()->MergeFrom(status.statuses());
+    response->set_accepted(response->accepted() + status.accepted());
+    response->set_rejected(response->rejected() + status.rejected());
+    pending.pop_front();
+  };
+
+  try {
+    auto batch = std::make_shared<CheckResultBatch>();
+    while (reader->Read(batch.get())) {
+      auto status = std::make_shared<CheckResultsStatus>();
+      std::packaged_task<int(void)> fn([batch, status]() -> int {
+        return command_manager::instance().process_passive_check_results(
+            *batch, status.get());
+      });
+      pending.push_back({fn.get_future(), status});
+      command_manager::instance().enqueue(std::move(fn));
+      batch = std::make_shared<CheckResultBatch>();
+
+      while (!pending.empty() &&
+             (pending.size() > max_pending_batches ||
+              command_manager::instance().queue_size() > max_queue_size))
+        collect();
+    }
+    while (!pending.empty())
+      collect();
+  } catch (std::future_error const&) {
+    return grpc::Status(grpc::StatusCode::UNAVAILABLE,
+                        "engine stopped before applying check results");
+  }
+  return grpc::Status::OK;
+}
+
 /**
  * @brief When a new file arrives on the centreon server, this command is used
  * to notify engine to update its anomaly detection services with those new
@@ -145,6 +213,26 @@ grpc::Status engine_impl::NewThresholdsFile(grpc::ServerContext* context
   return grpc::Status::OK;
 }
 
+/**
+ * @brief Enable or disable the profiling of the engine hot paths. Enabling it
+ * resets the counters. The profiler is thread safe, this is not done by the
+ * main loop.
+ *
+ * @param
+ * @param request true to enable the profiling.
+ * @param response Always true.
+ *
+ * @return grpc::Status::OK
+ */
+grpc::Status engine_impl::SetProfiling(
+    grpc::ServerContext* context __attribute__((unused)),
+    const ::google::protobuf::BoolValue* request,
+    CommandSuccess* response) {
+  profiler::set_enabled(request->value());
+  response->set_value(true);
+  return grpc::Status::OK;
+}
+
 /**
  * @brief Return host informations.
  *
@@ -546,7 +634,7 @@ grpc::Status engine_impl::AddHostComment(grpc::ServerContext* context
         comment::host, comment::user, temp_host->get_host_id(), 0,
         request->entry_time(), request->user(), request->comment_data(),
         request->persistent(), comment::external, false, (time_t)0);
-    comment::comments.insert({cmt->get_comment_id(), cmt});
+    comment::insert_comment(cmt);
     return 0;
   });
 
@@ -610,7 +698,7 @@ grpc::Status engine_impl::AddServiceComment(grpc::ServerContext* context
       err = fmt::format("could not insert comment '{}'", request->comment_data());
       return 1;
     }
-    comment::comments.insert({cmt->get_comment_id(), cmt});
+    comment::insert_comment(cmt);
     return 0;
   });
 
@@ -966,7 +1054,7 @@ grpc::Status engine_impl::AcknowledgementHostProblem(
         comment::host, comment::acknowledgment, temp_host->get_host_id(), 0,
         current_time, request->ack_author(), request->ack_data(),
         request->persistent(), comment::internal, false, (time_t)0);
-    comment::comments.insert({com->get_comment_id(), com});
+    comment::insert_comment(com);
 
     return 0;
   });
@@ -1031,7 +1119,7 @@ grpc::Status engine_impl::AcknowledgementServiceProblem(
         temp_service->get_service_id(), current_time, request->ack_author(),
         request->ack_data(), request->persistent(), comment::internal, false,
         (time_t)0);
-    comment::comments.insert({com->get_comment_id(), com});
+    comment::insert_comment(com);
     return 0;
   });
 
@@ -92,6 +92,8 @@ class anomalydetection : public service {
   commands::command* get_check_command_ptr() const;
   std::tuple<service::service_state, double, std::string, double, double>
   parse_perfdata(std::string const& perfdata, time_t check_time);
+  std::tuple<service::service_state, double, std::string, double, double>
+  parse_perfdata(engine::perfdata::metric const* metric, time_t check_time);
   void init_thresholds();
   void set_status_change(bool status_change);
   const std::string& get_metric_name() const;
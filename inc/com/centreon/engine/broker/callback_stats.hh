@@ -0,0 +1,90 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_BROKER_CALLBACK_STATS_HH
+#define CCE_BROKER_CALLBACK_STATS_HH
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+namespace broker {
+/**
+ *  @struct callback_stat callback_stats.hh
+ *  @brief Latency counters of one (module, callback type) pair.
+ *
+ *  Counters are atomics because callbacks may be made from several
+ *  threads (logs are brokered from the checker threads for example).
+ */
+struct callback_stat {
+  /* Upper bounds (in microseconds) of the histogram buckets. The last
+   * bucket catches everything above the last bound. */
+  static constexpr std::array<uint64_t, 6> bounds{
+      {10, 100, 1000, 10000, 100000, 1000000}};
+
+  callback_stat(std::string const& module, int type);
+
+  std::string const module;
+  int const callback_type;
+  std::atomic<uint64_t> calls;
+  std::atomic<uint64_t> total_ns;
+  std::atomic<uint64_t> max_ns;
+  std::array<std::atomic<uint64_t>, bounds.size() + 1> histogram;
+};
+
+/**
+ *  @class callback_stats callback_stats.hh
+ *  @brief Per module and per callback type NEB latency profiler.
+ *
+ *  Each registered callback is attached to a callback_stat when it is
+ *  registered, so neb_make_callbacks() only has to time the call and
+ *  update the counters. Counters survive module reloads: they are
+ *  indexed by the module filename.
+ */
+class callback_stats {
+  mutable std::mutex _m;
+  std::map<std::pair<std::string, int>, std::unique_ptr<callback_stat> >
+      _stats;
+
+  callback_stats() = default;
+
+ public:
+  static callback_stats& instance();
+  callback_stats(callback_stats const&) = delete;
+  callback_stats& operator=(callback_stats const&) = delete;
+
+  callback_stat* get(void const* module_handle, int callback_type);
+  void record(callback_stat* stat, std::chrono::nanoseconds elapsed);
+  std::vector<callback_stat const*> get_stats() const;
+  void reset();
+  static char const* callback_type_name(int callback_type) noexcept;
+};
+}  // namespace broker
+
+CCE_END()
+
+#endif  // !CCE_BROKER_CALLBACK_STATS_HH
@@ -30,7 +30,13 @@ enum check_source { service_check, host_check };
 
 CCE_BEGIN()
 class notifier;
+namespace checks {
+class check_result_pool;
+}
+
 class check_result {
+  friend class checks::check_result_pool;
+
  public:
   check_result() = delete;
   check_result(enum check_source object_check_type,
@@ -73,6 +79,10 @@ class check_result {
   void set_latency(double latency);
   int get_check_options() const;
   void set_check_options(int check_options);
+  uint64_t get_notifier_generation() const;
+  void set_notifier_generation(uint64_t generation);
+  check_result* get_next() const;
+  void set_next(check_result* next);
 
  private:
   enum check_source _object_check_type;  // is this a service or a host check?
@@ -88,6 +98,8 @@ class check_result {
   bool _exited_ok;              // did the plugin check return okay?
   int _return_code;             // plugin return code
   std::string _output;          // plugin output
+  uint64_t _notifier_generation;  // generation of _notifier, set by checker
+  check_result* _next;            // link in the checker queues
 };
 CCE_END()
 
@@ -21,9 +21,13 @@
 #define CCE_CHECKABLE_HH
 
 #include <ctime>
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "com/centreon/engine/checkable_state.hh"
 #include "com/centreon/engine/namespace.hh"
+#include "com/centreon/engine/perfdata.hh"
 
 CCE_BEGIN()
 namespace commands {
@@ -40,7 +44,24 @@ class checkable {
 
   enum state_type { soft, hard };
 
-  checkable(std::string const& display_name,
+  /* Pre-rendered status file blocks, around the last_update line. They are
+   * rendered again only after update_status() set dirty. */
+  struct status_blocks {
+    bool dirty = true;
+    std::shared_ptr<std::string const> head;
+    std::shared_ptr<std::string const> tail;
+  };
+
+  /* A check command argument, backslash escapes removed. Only arguments
+   * with macros need to be processed before each check. */
+  struct command_arg {
+    std::string value;
+    bool has_macros;
+  };
+  typedef std::vector<command_arg> command_args;
+
+  checkable(checkable_state_store& states,
+            std::string const& display_name,
             std::string const& check_command,
             bool checks_enabled,
             bool accept_passive_checks,
@@ -63,11 +84,16 @@ class checkable {
             bool obsess_over,
             std::string const& timezone);
   virtual ~checkable() = default;
+  checkable(checkable const&) = delete;
+  checkable& operator=(checkable const&) = delete;
 
   std::string const& get_display_name() const;
   void set_display_name(std::string const& name);
   std::string const& get_check_command() const;
   void set_check_command(std::string const& check_command);
+  std::string const& get_check_command_name() const;
+  std::string const& get_check_command_args() const;
+  command_args const& get_check_command_argv() const;
   uint32_t get_check_interval() const;
   void set_check_interval(uint32_t check_interval);
   double get_retry_interval() const;
@@ -96,6 +122,7 @@ class checkable {
   void set_long_plugin_output(std::string const& long_plugin_output);
   std::string const& get_perf_data() const;
   void set_perf_data(std::string const& perf_data);
+  perfdata const& get_perf_data_metrics() const;
   bool get_flap_detection_enabled(void) const;
   void set_flap_detection_enabled(bool flap_detection_enabled);
   double get_low_flap_threshold() const;
@@ -131,6 +158,8 @@ class checkable {
   void inc_scheduled_downtime_depth() noexcept;
   double get_execution_time() const;
   void set_execution_time(double execution_time);
+  double get_execution_time_estimate() const;
+  void set_execution_time_estimate(double estimate);
   int get_freshness_threshold() const;
   void set_freshness_threshold(int freshness_threshold);
   bool get_is_flapping() const;
@@ -155,12 +184,26 @@ class checkable {
   commands::command* get_check_command_ptr() const;
   bool get_is_executing() const;
   void set_is_executing(bool is_executing);
+  uint32_t get_check_sequence() const;
+  status_blocks& get_status_blocks() noexcept;
+  static void split_check_command(std::string const& check_command,
+                                  std::string& name,
+                                  std::string& args);
+  static void parse_command_args(std::string const& command,
+                                 command_args& argv);
 
   timeperiod* check_period_ptr;
 
  private:
+  void _watch_freshness();
+
+  /* Hot check and scheduling fields, stored apart from the object. */
+  checkable_state_store::handle _state;
   std::string _display_name;
   std::string _check_command;
+  std::string _check_command_name;
+  std::string _check_command_args;
+  command_args _check_command_argv;
   uint32_t _check_interval;
   uint32_t _retry_interval;
   int _max_attempts;
@@ -175,33 +218,19 @@ class checkable {
   std::string _plugin_output;
   std::string _long_plugin_output;
   std::string _perf_data;
+  mutable perfdata _perf_data_metrics;
+  mutable bool _perf_data_parsed;
   bool _flap_detection_enabled;
   double _low_flap_threshold;
   double _high_flap_threshold;
   bool _obsess_over;
   std::string _timezone;
-  bool _checks_enabled;
-  bool _accept_passive_checks;
-  bool _check_freshness;
-  int _freshness_threshold;
-  check_type _check_type;
-  int _current_attempt;
-  bool _has_been_checked;
-  int _scheduled_downtime_depth;
-  double _execution_time;
-  bool _is_flapping;
-  int _last_check;
-  double _latency;
-  std::time_t _next_check;
-  bool _should_be_scheduled;
-  uint32_t _state_history_index;
-  std::time_t _last_state_change;
-  std::time_t _last_hard_state_change;
-  enum state_type _state_type;
-  double _percent_state_change;
   commands::command* _event_handler_ptr;
   commands::command* _check_command_ptr;
-  bool _is_executing;
+  /* Incremented at each check start, the deadlines of the previous checks
+   * are recognized with it. */
+  uint32_t _check_sequence;
+  status_blocks _status_blocks;
 };
 
 CCE_END()
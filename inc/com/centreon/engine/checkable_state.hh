@@ -0,0 +1,137 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CHECKABLE_STATE_HH
+#define CCE_CHECKABLE_STATE_HH
+
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+class checkable;
+
+/* Check and scheduling state of a host or a service, the fields read by
+ * the sweeps over all hosts or all services. Enums of checkable are stored
+ * as bytes. */
+struct checkable_state {
+  checkable* owner = nullptr;
+  std::time_t next_check = 0;
+  std::time_t last_check = 0;
+  std::time_t last_state_change = 0;
+  std::time_t last_hard_state_change = 0;
+  double latency = 0.0;
+  double execution_time = 0.0;
+  /* Moving average of the active check execution times, negative until
+   * the first active check. */
+  double execution_time_estimate = -1.0;
+  double percent_state_change = 0.0;
+  int current_attempt = 0;
+  int scheduled_downtime_depth = 0;
+  int freshness_threshold = 0;
+  /* Next freshness check of the state, 0 if it is not in the freshness
+   * index of its store. */
+  std::time_t freshness_deadline = 0;
+  uint32_t state_history_index = 0;
+  uint8_t check_type = 0;
+  uint8_t state_type = 0;
+  bool has_been_checked = false;
+  bool should_be_scheduled = true;
+  bool is_executing = false;
+  bool is_flapping = false;
+  bool checks_enabled = false;
+  bool accept_passive_checks = false;
+  bool check_freshness = false;
+};
+
+/**
+ *  @class checkable_state_store checkable_state.hh
+ *  @brief Contiguous storage of the checkable states.
+ *
+ *  There is one store for hosts and one for services. States are allocated
+ *  by chunks that are never moved, so a checkable keeps a pointer to its
+ *  state and a sweep walks the chunks instead of the objects scattered on
+ *  the heap. Released states are reused by the next allocations. Only the
+ *  main thread creates and destroys checkables.
+ *
+ *  The store also keeps the freshness index: a min-heap of deadlines of
+ *  the states with freshness checking enabled, so that the freshness sweep
+ *  only looks at the states whose deadline is reached. An entry is valid
+ *  while it matches the freshness_deadline of its state, entries replaced
+ *  by a new deadline are dropped when they reach the top.
+ */
+class checkable_state_store {
+ public:
+  struct deleter {
+    checkable_state_store* store;
+    void operator()(checkable_state* st) const noexcept { store->release(st); }
+  };
+  typedef std::unique_ptr<checkable_state, deleter> handle;
+
+  static checkable_state_store& hosts();
+  static checkable_state_store& services();
+
+  checkable_state_store() = default;
+  checkable_state_store(checkable_state_store const&) = delete;
+  checkable_state_store& operator=(checkable_state_store const&) = delete;
+
+  handle acquire(checkable* owner);
+  void release(checkable_state* st) noexcept;
+  size_t size() const noexcept;
+  size_t capacity() const noexcept;
+  void watch_freshness(checkable_state& st, std::time_t deadline);
+  void reset_freshness(std::time_t deadline);
+  std::vector<checkable_state*> pop_freshness_due(std::time_t now);
+  size_t freshness_index_size() const noexcept;
+
+  /**
+   *  Call f on each state in use, in memory order.
+   *
+   *  @param[in] f  Function taking a checkable_state&.
+   */
+  template <typename F>
+  void for_each(F f) {
+    size_t remaining{_used};
+    for (auto& chunk : _chunks) {
+      size_t count{remaining < chunk_size ? remaining : chunk_size};
+      for (checkable_state *st{chunk.get()}, *end{st + count}; st != end;
+           ++st)
+        if (st->owner)
+          f(*st);
+      remaining -= count;
+    }
+  }
+
+  static constexpr size_t chunk_size = 1024;
+
+ private:
+  std::vector<std::unique_ptr<checkable_state[]>> _chunks;
+  std::vector<checkable_state*> _free;
+  /* States handed out at least once, from the start of the first chunk. */
+  size_t _used = 0;
+  typedef std::pair<std::time_t, checkable_state*> freshness_entry;
+  std::vector<freshness_entry> _freshness;
+};
+
+CCE_END()
+
+#endif  // !CCE_CHECKABLE_STATE_HH
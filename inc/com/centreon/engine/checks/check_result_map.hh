@@ -0,0 +1,74 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CHECKS_CHECK_RESULT_MAP_HH
+#define CCE_CHECKS_CHECK_RESULT_MAP_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+class check_result;
+
+namespace checks {
+/**
+ *  @class check_result_map check_result_map.hh
+ *  @brief Check results waiting for their command, by command id.
+ *
+ *  Open addressing table with linear probing: entries are stored in a
+ *  single array, so inserting and removing an id does not allocate once
+ *  the table is large enough. Command ids are never 0, this value marks
+ *  the empty slots. A removal moves back the following entries of the
+ *  probe sequence, no tombstone is left. The table grows when it is half
+ *  full and never shrinks.
+ */
+class check_result_map {
+ public:
+  check_result_map(size_t capacity = 256);
+  check_result_map(check_result_map const&) = delete;
+  check_result_map& operator=(check_result_map const&) = delete;
+
+  void clear() noexcept;
+  void erase_if(std::function<bool(check_result*)> const& pred);
+  void for_each(std::function<void(check_result const*)> const& f) const;
+  void insert(uint64_t id, check_result* result);
+  size_t size() const noexcept;
+  check_result* take(uint64_t id) noexcept;
+
+ private:
+  struct slot {
+    uint64_t id;
+    check_result* result;
+  };
+
+  size_t _index(uint64_t id) const noexcept;
+  void _grow();
+
+  std::vector<slot> _slots;
+  size_t _mask;
+  size_t _size;
+};
+}  // namespace checks
+
+CCE_END()
+
+#endif  // !CCE_CHECKS_CHECK_RESULT_MAP_HH
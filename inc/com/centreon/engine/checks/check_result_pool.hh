@@ -0,0 +1,84 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CHECKS_CHECK_RESULT_POOL_HH
+#define CCE_CHECKS_CHECK_RESULT_POOL_HH
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "com/centreon/engine/check_result.hh"
+
+CCE_BEGIN()
+
+namespace checks {
+/**
+ *  @class check_result_pool check_result_pool.hh
+ *  @brief Recycle the check results.
+ *
+ *  Reaped check results are given back to the pool instead of being
+ *  deleted, and the next checks reuse them with their output buffer, so
+ *  in a steady state a check does not allocate its result anymore. The
+ *  pool keeps at most max_free results and does not keep the buffers of
+ *  outputs larger than max_output_capacity.
+ */
+class check_result_pool {
+  std::mutex _m;
+  std::vector<check_result*> _free;
+
+  check_result_pool() = default;
+
+ public:
+  /* Number of free results kept, the others are deleted. */
+  static size_t const max_free = 4096;
+  /* Largest output buffer kept in a free result. */
+  static size_t const max_output_capacity = 65536;
+
+  /* Give the result back to the pool when the owner is destroyed. */
+  struct deleter {
+    void operator()(check_result* result) const noexcept;
+  };
+  typedef std::unique_ptr<check_result, deleter> pointer;
+
+  static check_result_pool& instance();
+  ~check_result_pool() noexcept;
+  check_result_pool(check_result_pool const&) = delete;
+  check_result_pool& operator=(check_result_pool const&) = delete;
+
+  check_result* get(enum check_source object_check_type,
+                    notifier* notifier,
+                    enum checkable::check_type check_type,
+                    int check_options,
+                    bool reschedule_check,
+                    double latency,
+                    struct timeval start_time,
+                    struct timeval finish_time,
+                    bool early_timeout,
+                    bool exited_ok,
+                    int return_code,
+                    std::string const& output);
+  void put(check_result* result) noexcept;
+  size_t free_count();
+  uint64_t free_bytes();
+};
+}  // namespace checks
+
+CCE_END()
+
+#endif  // !CCE_CHECKS_CHECK_RESULT_POOL_HH
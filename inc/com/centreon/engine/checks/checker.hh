@@ -20,9 +20,14 @@
 #ifndef CCE_CHECKS_CHECKER_HH
 #define CCE_CHECKS_CHECKER_HH
 
+#include <atomic>
 #include <queue>
+#include <unordered_map>
+#include <vector>
 
 #include "com/centreon/engine/anomalydetection.hh"
+#include "com/centreon/engine/checks/check_result_map.hh"
+#include "com/centreon/engine/checks/timeout_wheel.hh"
 #include "com/centreon/engine/commands/command.hh"
 
 CCE_BEGIN()
@@ -50,8 +55,20 @@ class checker : public commands::command_listener {
                 int check_options,
                 int use_cached_result,
                 unsigned long check_timestamp_horizon);
-  void add_check_result(uint64_t id, check_result* result) noexcept;
+  void add_check_result(uint64_t id,
+                        check_result* result,
+                        time_t deadline) noexcept;
+  void add_check_without_command(check_source source,
+                                 notifier* n,
+                                 time_t deadline) noexcept;
+  std::vector<notifier*> get_orphaned_checks(check_source source,
+                                             time_t now);
   void add_check_result_to_reap(check_result* result) noexcept;
+  void add_check_results_to_reap(
+      std::vector<check_result*> const& results) noexcept;
+  void get_check_results_usage(uint64_t& waiting,
+                               uint64_t& to_reap,
+                               uint64_t& bytes);
   static void forget(notifier* n) noexcept;
 
  private:
@@ -61,26 +78,39 @@ class checker : public commands::command_listener {
   checker& operator=(checker const& right);
   void finished(commands::result const& res) noexcept override;
   host::host_state _execute_sync(host* hst);
+  void _forget_notifiers();
+  void _hold(check_result* result) noexcept;
+  bool _release(check_result* result) noexcept;
+  void _push_to_reap(check_result* first, check_result* last) noexcept;
 
-  /* A mutex to protect access on _waiting_check_result and _to_reap_partial */
+  /* A mutex to protect access on _waiting_check_result, _in_flight and
+   * _to_forget */
   std::mutex _mut_reap;
   /*
    * Here is the list of prepared check results but with a command being
    * running. When the command will be finished, each check result is get back
    * updated and moved to _to_reap_partial list. */
-  std::unordered_map<uint64_t, check_result*> _waiting_check_result;
-  /* This queue is filled during a cycle. When it is time to reap, its elements
-   * are passed to _to_reap. It can then be filled in parallel during the
-   * _to_reap treatment. */
-  std::deque<check_result*> _to_reap_partial;
+  check_result_map _waiting_check_result;
+  /* This stack is filled during a cycle without lock, by the command threads
+   * and the main loop. Its elements are linked with check_result::get_next(),
+   * the last pushed on top. When it is time to reap, it is taken at once and
+   * appended to _to_reap. */
+  std::atomic<check_result*> _to_reap_partial;
   /*
-   * The list of check_results to reap: they contain data that have to be
-   * translated to services/hosts. */
-  std::deque<check_result*> _to_reap;
+   * The list of check_results to reap, the oldest first: they contain data
+   * that have to be translated to services/hosts. Only used by reap(). */
+  check_result* _to_reap_first;
+  check_result* _to_reap_last;
+  /* Deadlines of the checks in flight, by check_source. */
+  timeout_wheel _in_flight[2];
 
   /* Due to reloads of centengine we have the following list with notifiers
    * that should be forgotten if notifiers are removed. */
   std::deque<notifier*> _to_forget;
+  /* Generations of the destroyed notifiers whose check results are still
+   * held here, with the number of these results. Like the notifiers, it is
+   * only used from the main loop. */
+  std::unordered_map<uint64_t, uint32_t> _forgotten;
 };
 }  // namespace checks
 
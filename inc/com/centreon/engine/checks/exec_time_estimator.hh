@@ -0,0 +1,62 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CHECKS_EXEC_TIME_ESTIMATOR_HH
+#define CCE_CHECKS_EXEC_TIME_ESTIMATOR_HH
+
+#include <string>
+#include <unordered_map>
+#include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+class checkable;
+
+namespace checks {
+/**
+ *  @class exec_time_estimator exec_time_estimator.hh
+ *  @brief Expected execution time of the active checks.
+ *
+ *  Each active check result updates an exponentially weighted moving
+ *  average kept in the state of the checked object, and another one kept
+ *  by check command. An object that was never checked by the engine uses
+ *  the average of its command. Only the main thread uses it.
+ */
+class exec_time_estimator {
+  std::unordered_map<std::string, double> _by_command;
+
+  exec_time_estimator() = default;
+
+ public:
+  /* Weight of the last execution time in the averages. */
+  static constexpr double weight = 0.3;
+  /* Estimate of a check that nothing is known about. */
+  static constexpr double default_estimate = 0.1;
+
+  static exec_time_estimator& instance();
+  exec_time_estimator(exec_time_estimator const&) = delete;
+  exec_time_estimator& operator=(exec_time_estimator const&) = delete;
+
+  void add(checkable& c, double execution_time);
+  double estimate(checkable const& c) const;
+};
+}  // namespace checks
+
+CCE_END()
+
+#endif  // !CCE_CHECKS_EXEC_TIME_ESTIMATOR_HH
@@ -0,0 +1,63 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CHECKS_LATENCY_HISTOGRAM_HH
+#define CCE_CHECKS_LATENCY_HISTOGRAM_HH
+
+#include <array>
+#include <cstdint>
+#include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+namespace checks {
+/**
+ *  @class latency_histogram latency_histogram.hh
+ *  @brief Distribution of check latencies.
+ *
+ *  Latencies are counted in fixed buckets, so recording one is cheap and
+ *  the memory used does not depend on the number of checks. Percentiles
+ *  are given as the upper bound of the bucket they fall in, the last
+ *  bucket is bounded by the largest latency seen.
+ */
+class latency_histogram {
+ public:
+  /* Upper bounds (in seconds) of the buckets. The last bucket catches
+   * everything above the last bound. */
+  static constexpr std::array<double, 12> bounds{
+      {0.01, 0.05, 0.1, 0.25, 0.5, 1, 2, 5, 10, 30, 60, 300}};
+
+  latency_histogram();
+
+  void add(double latency) noexcept;
+  uint64_t count() const noexcept;
+  double max() const noexcept;
+  double percentile(double p) const noexcept;
+  void reset() noexcept;
+
+ private:
+  std::array<uint64_t, bounds.size() + 1> _buckets;
+  uint64_t _count;
+  double _max;
+};
+}  // namespace checks
+
+CCE_END()
+
+#endif  // !CCE_CHECKS_LATENCY_HISTOGRAM_HH
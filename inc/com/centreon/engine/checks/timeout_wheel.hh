@@ -0,0 +1,80 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CHECKS_TIMEOUT_WHEEL_HH
+#define CCE_CHECKS_TIMEOUT_WHEEL_HH
+
+#include <cstdint>
+#include <ctime>
+#include <unordered_set>
+#include <vector>
+#include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+class notifier;
+
+namespace checks {
+/**
+ *  @class timeout_wheel timeout_wheel.hh
+ *  @brief Deadlines of the checks in flight.
+ *
+ *  Entries are put in one-second slots, by deadline modulo the number of
+ *  slots. expire() only visits the slots of the seconds elapsed since its
+ *  last call, entries of later rounds stay in their slot. Completed checks
+ *  are not removed, the caller ignores their entries when they expire:
+ *  their command id is not waited for anymore or, for checks without
+ *  command, their check sequence is not the one of the notifier.
+ */
+class timeout_wheel {
+ public:
+  struct entry {
+    std::time_t deadline;
+    uint64_t command_id;
+    notifier* n;
+    uint32_t check_sequence;
+  };
+
+  timeout_wheel(size_t slots = 1024);
+  timeout_wheel(timeout_wheel const&) = delete;
+  timeout_wheel& operator=(timeout_wheel const&) = delete;
+
+  void add(std::time_t deadline,
+           uint64_t command_id,
+           notifier* n,
+           uint32_t check_sequence = 0);
+  void clear() noexcept;
+  std::vector<entry> expire(std::time_t now);
+  void remove(std::unordered_set<notifier*> const& notifiers) noexcept;
+  size_t size() const noexcept;
+
+ private:
+  void _expire_slot(std::vector<entry>& slot,
+                    std::time_t now,
+                    std::vector<entry>& expired);
+
+  std::vector<std::vector<entry>> _slots;
+  /* Time of the last expire(), 0 before the first one. */
+  std::time_t _now;
+  size_t _size;
+};
+}  // namespace checks
+
+CCE_END()
+
+#endif  // !CCE_CHECKS_TIMEOUT_WHEEL_HH
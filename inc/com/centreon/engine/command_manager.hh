@@ -46,6 +46,7 @@ class command_manager {
  public:
   static command_manager& instance();
   void enqueue(std::packaged_task<int()>&& f);
+  size_t queue_size();
 
   int process_passive_service_check(time_t check_time,
                                     const std::string& host_name,
@@ -56,10 +57,15 @@ class command_manager {
                                  const std::string& host_name,
                                  uint32_t return_code,
                                  const std::string& output);
+  int process_passive_check_results(CheckResultBatch const& batch,
+                                    CheckResultsStatus* response);
   int get_stats(std::string const& request, Stats* response);
   int get_restart_stats(RestartStats* response);
   int get_services_stats(ServicesStats* sstats);
   int get_hosts_stats(HostsStats* hstats);
+  int get_neb_callbacks_stats(Stats* response);
+  int get_memory_stats(Stats* response);
+  int get_profile_stats(Stats* response);
   void execute();
   static void schedule_and_propagate_downtime(host* h,
                                               time_t entry_time,
@@ -23,7 +23,9 @@
 #include <time.h>
 #include <map>
 #include <ostream>
+#include <unordered_map>
 #include "com/centreon/engine/contact.hh"
+#include "com/centreon/engine/hash.hh"
 #include "com/centreon/engine/host.hh"
 
 CCE_BEGIN()
@@ -75,7 +77,13 @@ class comment {
 
   static uint64_t get_next_comment_id();
   static void set_next_comment_id(uint64_t comment_id);
+  static void insert_comment(std::shared_ptr<comment> const& com);
+  static void clear_comments();
   static bool delete_comment(uint64_t comment_id);
+  static void delete_comments(comment::type comment_type,
+                              uint64_t host_id,
+                              uint64_t service_id,
+                              bool (*filter)(comment const&) = nullptr);
   static void delete_host_comments(uint64_t host_id);
   static void delete_service_comments(uint64_t host_id, uint64_t service_id);
   static void delete_host_acknowledgement_comments(engine::host* hst);
@@ -98,6 +106,13 @@ class comment {
   std::string _comment_data;
 
   static uint64_t _next_comment_id;
+  /* Ids of the comments of each (host id, service id), service id is 0
+   * for host comments. Only updated by insert_comment(), clear_comments()
+   * and delete_comment(). */
+  static std::unordered_multimap<std::pair<uint64_t, uint64_t>,
+                                 uint64_t,
+                                 pair_hash>
+      _comments_by_object;
 };
 
 CCE_END()
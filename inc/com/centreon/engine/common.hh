@@ -211,6 +211,9 @@
 #define CMD_DEL_HOST_DOWNTIME_FULL 501
 #define CMD_DEL_SVC_DOWNTIME_FULL 502
 #define CMD_NEW_THRESHOLDS_FILE 503
+#define CMD_DUMP_MEMORY_PROFILE 504
+#define CMD_ENABLE_PROFILING 505
+#define CMD_DISABLE_PROFILING 506
 #define CMD_CUSTOM_COMMAND 999
 
 /* Acknowledgement types. */
@@ -319,7 +322,9 @@ enum ret_val {
 
 /* Default values. */
 #define DEFAULT_ORPHAN_CHECK_INTERVAL \
-  60 /* Seconds between checks for orphaned hosts and services. */
+  5 /* Seconds between checks for orphaned hosts and services. */
+#define DEFAULT_ORPHAN_CHECK_GRACE \
+  5 /* Seconds after its timeout before a check without result is orphaned. */
 
 /* State change types. */
 #define HOST_STATECHANGE 0
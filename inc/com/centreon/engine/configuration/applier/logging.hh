@@ -22,6 +22,8 @@
 
 #include <string>
 #include "com/centreon/engine/configuration/state.hh"
+#include "com/centreon/engine/logging/async_sink.hh"
+#include "com/centreon/engine/logging/broker.hh"
 #include "com/centreon/engine/namespace.hh"
 #include "com/centreon/logging/file.hh"
 #include "com/centreon/logging/syslogger.hh"
@@ -41,6 +43,7 @@ class logging {
   void apply(configuration::state& config);
   static logging& instance();
   void clear();
+  void set_broker_backend(com::centreon::engine::logging::broker* backend);
 
  private:
   logging();
@@ -48,17 +51,21 @@ class logging {
   logging(logging const&);
   ~logging() throw();
   logging& operator=(logging const&);
+  void _add_async(configuration::state const& config);
   void _add_stdout();
   void _add_stderr();
   void _add_syslog();
   void _add_log_file(configuration::state const& config);
   void _add_debug(configuration::state const& config);
+  void _del_async();
   void _del_syslog();
   void _del_log_file();
   void _del_debug();
   void _del_stdout();
   void _del_stderr();
 
+  com::centreon::engine::logging::async_sink* _async;
+  com::centreon::engine::logging::broker* _broker;
   com::centreon::logging::file* _debug;
   unsigned long long _debug_level;
   unsigned long _debug_max_size;
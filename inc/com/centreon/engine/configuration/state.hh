@@ -185,6 +185,8 @@ class state {
   void enable_predictive_service_dependency_checks(bool value);
   unsigned long event_broker_options() const noexcept;
   void event_broker_options(unsigned long value);
+  unsigned int event_broker_callback_warning_threshold() const noexcept;
+  void event_broker_callback_warning_threshold(unsigned int value);
   unsigned int event_handler_timeout() const noexcept;
   void event_handler_timeout(unsigned int value);
   bool execute_host_checks() const noexcept;
@@ -239,6 +241,8 @@ class state {
   void illegal_output_chars(std::string const& value);
   unsigned int interval_length() const noexcept;
   void interval_length(unsigned int value);
+  bool log_async() const noexcept;
+  void log_async(bool value);
   bool log_event_handlers() const noexcept;
   void log_event_handlers(bool value);
   bool log_external_commands() const noexcept;
@@ -510,6 +514,7 @@ class state {
   bool _enable_predictive_host_dependency_checks;
   bool _enable_predictive_service_dependency_checks;
   unsigned long _event_broker_options;
+  unsigned int _event_broker_callback_warning_threshold;
   unsigned int _event_handler_timeout;
   bool _execute_host_checks;
   bool _execute_service_checks;
@@ -534,6 +539,7 @@ class state {
   std::string _illegal_object_chars;
   std::string _illegal_output_chars;
   unsigned int _interval_length;
+  bool _log_async;
   bool _log_event_handlers;
   bool _log_external_commands;
   std::string _log_file;
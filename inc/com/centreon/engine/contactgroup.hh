@@ -24,6 +24,8 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include "com/centreon/engine/namespace.hh"
 
 /* Forward declaration. */
@@ -64,7 +66,15 @@ class contactgroup {
 
   static contactgroup_map contactgroups;
 
+  static uint64_t get_members_version() noexcept;
+  static void members_changed() noexcept;
+  static void flatten(contactgroup_map_unsafe const& groups,
+                      std::vector<contact*>& contacts,
+                      std::unordered_set<contact*>& seen);
+
  private:
+  static uint64_t _members_version;
+
   std::string _alias;
   contact_map_unsafe _members;
   std::string _name;
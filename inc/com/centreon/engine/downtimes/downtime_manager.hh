@@ -21,11 +21,16 @@
 #define CCE_DOWNTIMES_DOWTIME_MANAGER_HH
 
 #include <map>
+#include <unordered_map>
+#include <vector>
 #include "com/centreon/engine/downtimes/downtime.hh"
+#include "com/centreon/engine/hash.hh"
 
 CCE_BEGIN()
 
 namespace downtimes {
+class service_downtime;
+
 class downtime_manager {
  public:
   static downtime_manager& instance() {
@@ -88,8 +93,39 @@ class downtime_manager {
   int register_downtime(downtime::type type, uint64_t downtime_id);
 
  private:
+  typedef std::multimap<time_t, std::shared_ptr<downtime>> downtime_map;
+  typedef std::pair<time_t, uint64_t> expiration;
+
   downtime_manager() = default;
-  std::multimap<time_t, std::shared_ptr<downtime>> _scheduled_downtimes;
+  downtime_map::iterator _find(uint64_t downtime_id);
+  void _insert(std::shared_ptr<downtime> const& dt);
+  downtime_map::iterator _erase(downtime_map::iterator it);
+  static std::pair<std::string, std::string> _object_key(downtime const* dt);
+
+  downtime_map _scheduled_downtimes;
+  /* Indexes of _scheduled_downtimes, only updated by _insert() and
+   * _erase(). Downtimes are attached to host names and service
+   * descriptions, so are the indexes. The host index contains both host
+   * and service downtimes. */
+  std::unordered_multimap<uint64_t, downtime_map::iterator> _downtimes_by_id;
+  std::unordered_multimap<std::string, downtime*> _downtimes_by_host;
+  std::unordered_multimap<std::pair<std::string, std::string>,
+                          service_downtime*,
+                          pair_hash>
+      _downtimes_by_service;
+  std::unordered_multimap<uint64_t, downtime*> _downtimes_by_trigger;
+  /* Flexible downtimes not triggered by another one and not started yet,
+   * by (host name, service description), the description is empty for
+   * host downtimes. A downtime leaves it when the state change of its
+   * object starts it. */
+  std::unordered_multimap<std::pair<std::string, std::string>,
+                          downtime*,
+                          pair_hash>
+      _pending_flex_downtimes;
+  /* Min-heap of (end time, downtime id) used to expire downtimes. Removed
+   * downtimes are not taken out of it, their entries are just ignored
+   * when they are popped. */
+  std::vector<expiration> _expirations;
   uint64_t _next_id;
 };
 }  // namespace downtimes
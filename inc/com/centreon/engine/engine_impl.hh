@@ -18,9 +18,15 @@ class engine_impl final : public Engine::Service {
   grpc::Status ProcessHostCheckResult(grpc::ServerContext* context,
                                       const Check* request,
                                       CommandSuccess* response) override;
+  grpc::Status ProcessCheckResults(grpc::ServerContext* context,
+                                   grpc::ServerReader<CheckResultBatch>* reader,
+                                   CheckResultsStatus* response) override;
   grpc::Status NewThresholdsFile(grpc::ServerContext* context,
                                  const ThresholdsFile* request,
                                  CommandSuccess* response) override;
+  grpc::Status SetProfiling(grpc::ServerContext* context,
+                            const ::google::protobuf::BoolValue* request,
+                            CommandSuccess* response) override;
   grpc::Status GetHostsCount(grpc::ServerContext* context,
                              const ::google::protobuf::Empty*,
                              GenericValue*) override;
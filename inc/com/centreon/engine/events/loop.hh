@@ -24,6 +24,8 @@
 
 #include <ctime>
 #include <deque>
+#include "com/centreon/engine/check_result.hh"
+#include "com/centreon/engine/checks/latency_histogram.hh"
 #include "com/centreon/engine/events/timed_event.hh"
 #include "com/centreon/engine/namespace.hh"
 
@@ -49,12 +51,18 @@ class loop {
 
   timed_event_list _event_list_high;
   timed_event_list _event_list_low;
+  /* Due service checks waiting for a free slot when
+   * max_parallel_service_checks is reached, in the order they were due. */
+  timed_event_list _waiting_checks;
+  checks::latency_histogram _check_latency[2];
 
   loop();
   loop(const loop&) = delete;
   ~loop() noexcept = default;
   loop& operator=(const loop&) = delete;
   void _dispatching();
+  void _launch_waiting_checks();
+  void _move_event(timed_event* evt, time_t run_time);
 
  public:
   enum priority {
@@ -68,6 +76,10 @@ class loop {
   void run();
   void adjust_check_scheduling();
   void add_event(timed_event* event, priority priority);
+  void add_check_latency(check_source source, double latency) noexcept;
+  checks::latency_histogram const& check_latency(
+      check_source source) const noexcept;
+  size_t events_count(priority priority) const noexcept;
   void compensate_for_system_time_change(unsigned long last_time,
                                          unsigned long current_time);
   void remove_downtime(uint64_t downtime_id);
@@ -79,6 +91,7 @@ class loop {
   void reschedule_event(timed_event* event, priority priority);
   void resort_event_list(priority priority);
   void schedule(timed_event* evt, bool high_priority);
+  size_t waiting_checks_count() const noexcept;
 };
 }  // namespace events
 
@@ -1,10 +1,19 @@
 #ifndef CCE_HASH_HH
 #define CCE_HASH_HH
 
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+/* The first hash is multiplied by a large odd constant before the second
+ * one is added, so that (a, b) and (b, a) differ and (a, a) is not always 0
+ * as with a XOR. Ids are hashed to themselves, their pairs collided a lot. */
 struct pair_hash {
   template <class T1, class T2>
   std::size_t operator()(const std::pair<T1, T2>& pair) const {
-    return std::hash<T1>()(pair.first) ^ std::hash<T2>()(pair.second);
+    return std::hash<T1>()(pair.first) *
+               static_cast<std::size_t>(0x9e3779b97f4a7c15ULL) +
+           std::hash<T2>()(pair.second);
   }
 };
 
@@ -50,6 +50,8 @@ typedef std::unordered_map<std::string, com::centreon::engine::host*>
 typedef std::unordered_map<uint64_t,
                            std::shared_ptr<com::centreon::engine::host>>
     host_id_map;
+typedef std::unordered_multimap<std::string, com::centreon::engine::host*>
+    host_address_map;
 
 CCE_BEGIN()
 class host : public notifier {
@@ -128,6 +130,7 @@ class host : public notifier {
                       bool reschedule_check,
                       bool* time_is_valid,
                       time_t* preferred_time) noexcept;
+  void request_check(time_t observed);
   bool schedule_check(time_t check_time, int options) override;
   void check_for_flapping(bool update,
                           bool actual_check,
@@ -152,6 +155,7 @@ class host : public notifier {
   bool operator==(host const& other) = delete;  // throw ();
   bool operator!=(host const& other) = delete;  // throw ();
   bool is_result_fresh(time_t current_time, int log_this);
+  time_t get_freshness_expiration(int& freshness_threshold);
 
   int run_sync_check_3x(enum host::host_state* check_result_code,
                         int check_options,
@@ -262,6 +266,7 @@ class host : public notifier {
   host_map_unsafe child_hosts;
   static host_map hosts;
   static host_id_map hosts_by_id;
+  static host_address_map hosts_by_address;
 
   service_map_unsafe services;
   std::list<hostgroup*> const& get_parent_groups() const;
@@ -321,6 +326,8 @@ void check_for_expired_acknowledgement(com::centreon::engine::host* h);
 com::centreon::engine::host& find_host(uint64_t host_id);
 bool is_host_exist(uint64_t host_id) throw();
 uint64_t get_host_id(std::string const& name);
+com::centreon::engine::host* find_host_by_name_or_address(
+    std::string const& name);
 
 CCE_END()
 
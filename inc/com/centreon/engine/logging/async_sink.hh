@@ -0,0 +1,112 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_LOGGING_ASYNC_SINK_HH
+#define CCE_LOGGING_ASYNC_SINK_HH
+
+#include <atomic>
+#include <condition_variable>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "com/centreon/engine/namespace.hh"
+#include "com/centreon/logging/backend.hh"
+
+CCE_BEGIN()
+
+namespace logging {
+/**
+ *  @class async_sink async_sink.hh "com/centreon/engine/logging/async_sink.hh"
+ *  @brief Write the log file and send log events to the broker from a
+ *  background thread.
+ *
+ *  log() only copies the message into a record of a fixed size ring and
+ *  goes on. The thread takes the ready records by batches, formats them
+ *  with one header per line into a single buffer written with one
+ *  write() call, then sends the basic verbosity ones to the broker. When
+ *  the ring is full, log() waits for the thread to free a record, so no
+ *  message is lost.
+ */
+class async_sink : public com::centreon::logging::backend {
+ public:
+  /* Number of records in the ring, a power of 2. */
+  static size_t const queue_size = 1024;
+  /* Message bytes stored in a record, longer messages are allocated. */
+  static size_t const inline_size = 960;
+
+  async_sink(std::string const& path, bool show_pid);
+  ~async_sink() noexcept override;
+  async_sink(async_sink const&) = delete;
+  async_sink& operator=(async_sink const&) = delete;
+
+  void close() noexcept override;
+  void enable_broker(bool enable);
+  std::string const& filename() const noexcept;
+  void flush();
+  void log(uint64_t types,
+           uint32_t verbose,
+           char const* msg,
+           uint32_t size) noexcept override;
+  void open() override;
+  void reopen() override;
+
+ private:
+  struct record {
+    time_t time;
+    uint64_t types;
+    uint32_t verbose;
+    uint32_t size;
+    bool broker;
+    std::string large;
+    char msg[inline_size];
+
+    char* data() noexcept { return size < inline_size ? msg : &large[0]; }
+  };
+
+  struct cell {
+    std::atomic<size_t> seq;
+    record rec;
+  };
+
+  size_t _drain();
+  void _run();
+  void _write(char const* data, size_t size);
+
+  std::string const _path;
+  int _fd;
+  std::mutex _file_m;
+  std::mutex _broker_m;
+  bool _broker;
+  std::unique_ptr<cell[]> _cells;
+  std::atomic<size_t> _head;
+  size_t _tail;
+  std::atomic<size_t> _done;
+  std::atomic<bool> _sleeping;
+  std::mutex _m;
+  std::condition_variable _cv;
+  bool _exit;
+  std::thread _thread;
+};
+}  // namespace logging
+
+CCE_END()
+
+#endif  // !CCE_LOGGING_ASYNC_SINK_HH
@@ -0,0 +1,53 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_MEMORY_STATS_HH
+#define CCE_MEMORY_STATS_HH
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+/**
+ *  @class memory_stats memory_stats.hh
+ *  @brief Memory used by each engine subsystem.
+ *
+ *  Sizes are computed on demand from the objects, nothing is counted on
+ *  allocations. They are estimates: object sizes plus the heap parts of
+ *  their strings and containers, without the allocator overhead.
+ */
+class memory_stats {
+ public:
+  struct usage {
+    std::string subsystem;
+    uint64_t objects;
+    uint64_t bytes;
+  };
+
+  static std::vector<usage> get_usage();
+  static bool dump(std::string const& path);
+  static uint64_t string_size(std::string const& str) noexcept;
+};
+
+CCE_END()
+
+#endif  // !CCE_MEMORY_STATS_HH
@@ -21,15 +21,23 @@
 #ifndef CCE_NEBMODS_HH
 #define CCE_NEBMODS_HH
 
+#include <cstdint>
 #include "com/centreon/engine/broker/handle.hh"
 #include "com/centreon/engine/nebcallbacks.hh"
 
+CCE_BEGIN()
+namespace broker {
+struct callback_stat;
+}
+CCE_END()
+
 // Module Structures
 typedef struct nebcallback_struct {
   void* callback_func;
   void* module_handle;
   int priority;
   struct nebcallback_struct* next;
+  com::centreon::engine::broker::callback_stat* stats;
 } nebcallback;
 
 #ifdef __cplusplus
@@ -57,6 +65,21 @@ int neb_make_callbacks(int callback_type, void* data);
 int neb_init_callback_list();
 int neb_free_callback_list();
 
+// Bit N is set when at least one callback of type N is registered.
+extern uint64_t neb_callback_subscriptions;
+
+/**
+ *  Check if some module listens to a callback type. broker_*() functions
+ *  call it first to not build data that no one would receive.
+ *
+ *  @param[in] callback_type Callback type (NEBCALLBACK_*).
+ *
+ *  @return true if at least one callback is registered for this type.
+ */
+static inline bool neb_has_callbacks(int callback_type) {
+  return neb_callback_subscriptions & (uint64_t(1) << callback_type);
+}
+
 #ifdef __cplusplus
 }
 #endif  // C++
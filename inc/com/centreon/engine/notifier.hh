@@ -22,6 +22,7 @@
 
 #include <array>
 #include <unordered_set>
+#include <vector>
 
 #include "com/centreon/engine/checkable.hh"
 #include "com/centreon/engine/contactgroup.hh"
@@ -257,6 +258,7 @@ class notifier : public checkable {
       const noexcept;
   contactgroup_map_unsafe& get_contactgroups() noexcept;
   contactgroup_map_unsafe const& get_contactgroups() const noexcept;
+  std::vector<contact*> const& get_resolved_contacts();
   void resolve(int& w, int& e);
   std::array<int, MAX_STATE_HISTORY_ENTRIES> const& get_state_history() const;
   std::array<int, MAX_STATE_HISTORY_ENTRIES>& get_state_history();
@@ -265,6 +267,10 @@ class notifier : public checkable {
   int get_pending_flex_downtime() const;
   void inc_pending_flex_downtime() noexcept;
   void dec_pending_flex_downtime() noexcept;
+  uint64_t get_generation() const noexcept;
+  uint32_t get_pending_check_results() const noexcept;
+  void inc_pending_check_results() noexcept;
+  void dec_pending_check_results() noexcept;
   void set_flap_type(uint32_t type) noexcept;
   timeperiod* get_notification_period_ptr() const noexcept;
   void set_notification_period_ptr(timeperiod* tp) noexcept;
@@ -277,6 +283,7 @@ class notifier : public checkable {
  private:
   static std::array<is_viable, 6> const _is_notification_viable;
   static uint64_t _next_notification_id;
+  static uint64_t _next_generation;
 
   bool _is_notification_viable_normal(reason_type type,
                                       notification_option options);
@@ -336,9 +343,16 @@ class notifier : public checkable {
   // reason_type _type;
   std::unordered_map<std::string, contact*> _contacts;
   contactgroup_map_unsafe _contact_groups;
+  /* Direct contacts and contact group members, each one once. */
+  std::vector<contact*> _resolved_contacts;
+  uint64_t _resolved_contacts_version;
   std::array<std::unique_ptr<notification>, 6> _notification;
   std::array<int, MAX_STATE_HISTORY_ENTRIES> _state_history;
   int _pending_flex_downtime;
+  /* Never reused, even if another notifier gets the same address. */
+  uint64_t const _generation;
+  /* Check results of this notifier held by the checker. */
+  uint32_t _pending_check_results;
 };
 
 CCE_END()
@@ -0,0 +1,81 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_PERFDATA_HH
+#define CCE_PERFDATA_HH
+
+#include <string>
+#include <vector>
+#include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+/**
+ *  @class perfdata perfdata.hh
+ *  @brief Metrics parsed from a perfdata string.
+ *
+ *  Labels, units and metric texts point into the parsed string, which must
+ *  outlive this object and stay unchanged. Parsing again reuses the metric
+ *  vector, so it does not allocate once the vector is large enough. Only
+ *  labels with doubled quotes ('it''s') are copied, to unescape them.
+ */
+class perfdata {
+ public:
+  /* Nagios threshold range, low and high are NaN when it is not set. */
+  struct range {
+    double low;
+    double high;
+    bool inside;
+  };
+
+  struct metric {
+    /* The whole "label=value[uom];warn;crit;min;max" text. */
+    char const* text;
+    size_t text_size;
+    /* Label without quotes and metric type ("d[label]" => 'd'), doubled
+     * quotes are unescaped. */
+    char const* label;
+    size_t label_size;
+    char type;
+    char const* uom;
+    size_t uom_size;
+    double value;
+    range warning;
+    range critical;
+    double min;
+    double max;
+
+    bool label_is(std::string const& name) const noexcept;
+  };
+
+  void parse(std::string const& perfdata);
+  void clear() noexcept;
+  std::vector<metric> const& metrics() const noexcept;
+  metric const* find(std::string const& label) const noexcept;
+
+ private:
+  std::vector<metric> _metrics;
+  /* Unescaped labels, one after the other. Its capacity is reserved before
+   * the first one is added so labels can point into it. */
+  std::string _unescaped_labels;
+};
+
+CCE_END()
+
+#endif  // !CCE_PERFDATA_HH
@@ -0,0 +1,108 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_PROFILER_HH
+#define CCE_PROFILER_HH
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+/**
+ *  @class profiler profiler.hh
+ *  @brief Time spent by the engine in its hot paths.
+ *
+ *  When enabled, each phase is timed by a scope object and accounted in
+ *  counters owned by the current thread, so recording takes no lock and
+ *  shares no cache line. Counters are summed when the statistics are
+ *  asked. Times are inclusive: an event dispatch contains the phases run
+ *  by the event. When disabled, a scope only reads a flag.
+ */
+class profiler {
+ public:
+  enum phase {
+    event_dispatch = 0,
+    macro_expansion,
+    command_spawn,
+    output_parsing,
+    result_handling,
+    neb_callback,
+    notification,
+    status_dump,
+    retention_dump,
+    configuration_apply,
+    phase_count
+  };
+
+  /* Upper bounds (in microseconds) of the histogram buckets. The last
+   * bucket catches everything above the last bound. */
+  static constexpr std::array<uint64_t, 7> bounds{
+      {1, 10, 100, 1000, 10000, 100000, 1000000}};
+
+  struct phase_stat {
+    uint64_t calls;
+    uint64_t total_ns;
+    uint64_t max_ns;
+    std::array<uint64_t, bounds.size() + 1> histogram;
+  };
+
+  /**
+   *  @class scope profiler.hh
+   *  @brief Time a phase from its construction to its destruction.
+   */
+  class scope {
+    phase const _phase;
+    bool const _started;
+    std::chrono::steady_clock::time_point _start;
+
+   public:
+    explicit scope(phase p) noexcept : _phase{p}, _started{enabled()} {
+      if (_started)
+        _start = std::chrono::steady_clock::now();
+    }
+    ~scope() noexcept {
+      if (_started)
+        record(_phase, std::chrono::steady_clock::now() - _start);
+    }
+    scope(scope const&) = delete;
+    scope& operator=(scope const&) = delete;
+  };
+
+  profiler() = delete;
+
+  static bool enabled() noexcept {
+    return _enabled.load(std::memory_order_relaxed);
+  }
+  static void set_enabled(bool enabled) noexcept;
+  static void record(phase p, std::chrono::nanoseconds elapsed) noexcept;
+  static std::array<phase_stat, phase_count> get_stats();
+  static void reset() noexcept;
+  static char const* phase_name(phase p) noexcept;
+
+ private:
+  static std::atomic<bool> _enabled;
+};
+
+CCE_END()
+
+#endif  // !CCE_PROFILER_HH
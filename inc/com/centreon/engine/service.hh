@@ -182,6 +182,7 @@ class service : public notifier {
   bool is_valid_escalation_for_notification(escalation const* e,
                                             int options) const override;
   bool is_result_fresh(time_t current_time, int log_this);
+  time_t get_freshness_expiration(int& freshness_threshold);
   void handle_flap_detection_disabled();
   timeperiod* get_notification_timeperiod() const override;
   bool get_notify_on_current_state() const override;
@@ -0,0 +1,73 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_STATUS_WRITER_HH
+#define CCE_STATUS_WRITER_HH
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+/**
+ *  @class status_writer status_writer.hh
+ *  @brief Write the status file from a background thread.
+ *
+ *  The main loop gives a list of text blocks (most of them are cached on
+ *  hosts and services and shared with the snapshot) and goes on. The
+ *  thread writes them with writev() into a temporary file that is then
+ *  renamed over the status file, so readers always see a complete file.
+ *  If several snapshots are published while a write is in progress, only
+ *  the last one is written.
+ */
+class status_writer {
+ public:
+  typedef std::vector<std::shared_ptr<std::string const> > blocks;
+
+  status_writer(std::string const& path);
+  ~status_writer();
+  status_writer(status_writer const&) = delete;
+  status_writer& operator=(status_writer const&) = delete;
+
+  void flush();
+  void publish(blocks&& data);
+
+ private:
+  void _run();
+  bool _write(blocks const& data);
+
+  std::string const _path;
+  std::string const _tmp_path;
+  std::mutex _m;
+  std::condition_variable _cv;
+  blocks _pending;
+  bool _has_pending;
+  bool _writing;
+  bool _exit;
+  std::thread _thread;
+};
+
+CCE_END()
+
+#endif  // !CCE_STATUS_WRITER_HH
@@ -50,6 +50,11 @@ int get_raw_command_line_r(nagios_macros* mac,
                            std::string const& cmd,
                            std::string& full_command,
                            int macro_options);
+// get_raw_command_line_r() with the check command arguments parsed once
+int get_check_command_line_r(nagios_macros* mac,
+                             com::centreon::engine::checkable const* chk,
+                             std::string& full_command,
+                             int macro_options);
 // trap signals
 void setup_sighandler();
 // handles signals
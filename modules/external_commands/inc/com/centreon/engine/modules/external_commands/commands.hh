@@ -248,6 +248,10 @@ void set_service_notification_number(
 void new_thresholds_file(
     char* filename);  // Update all the anomalydetections
                       // concerned by the new thresholds file.
+void dump_memory_profile(
+    char* filename);  // Write the memory used by each subsystem.
+void enable_profiling(void);   // starts timing the engine hot paths
+void disable_profiling(void);  // stops timing the engine hot paths
 
 #ifdef __cplusplus
 }
@@ -28,6 +28,7 @@
 #include <sstream>
 
 #include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/checks/check_result_pool.hh"
 #include "com/centreon/engine/checks/checker.hh"
 #include "com/centreon/engine/comment.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
@@ -38,9 +39,11 @@
 #include "com/centreon/engine/flapping.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/memory_stats.hh"
 #include "com/centreon/engine/modules/external_commands/internal.hh"
 #include "com/centreon/engine/modules/external_commands/processing.hh"
 #include "com/centreon/engine/modules/external_commands/utils.hh"
+#include "com/centreon/engine/profiler.hh"
 #include "com/centreon/engine/statusdata.hh"
 #include "com/centreon/engine/string.hh"
 #include "mmap.h"
@@ -228,7 +231,7 @@ int cmd_add_comment(int cmd, time_t entry_time, char* args) {
       (cmd == CMD_ADD_HOST_COMMENT) ? comment::host : comment::service,
       comment::user, temp_host->get_host_id(), service_id, entry_time, user,
       comment_data, persistent, comment::external, false, (time_t)0)};
-  comment::comments.insert({com->get_comment_id(), com});
+  comment::insert_comment(com);
 
   return OK;
 }
@@ -516,8 +519,6 @@ int process_passive_service_check(time_t check_time,
                                   char const* svc_description,
                                   int return_code,
                                   char const* output) {
-  char const* real_host_name(nullptr);
-
   /* skip this service check result if we aren't accepting passive service
    * checks */
   if (config->accept_passive_service_checks() == false)
@@ -528,22 +529,10 @@ int process_passive_service_check(time_t check_time,
     return ERROR;
 
   /* find the host by its name or address */
-  host_map::const_iterator it(host::hosts.find(host_name));
-  if (it != host::hosts.end() && it->second)
-    real_host_name = host_name;
-  else {
-    for (host_map::iterator itt(host::hosts.begin()), end(host::hosts.end());
-         itt != end; ++itt) {
-      if (itt->second && itt->second->get_address() == host_name) {
-        real_host_name = itt->first.c_str();
-        it = itt;
-        break;
-      }
-    }
-  }
+  host* hst(find_host_by_name_or_address(host_name));
 
   /* we couldn't find the host */
-  if (real_host_name == nullptr) {
+  if (!hst) {
     logger(log_runtime_warning, basic)
         << "Warning:  Passive check result was received for service '"
         << svc_description << "' on host '" << host_name
@@ -553,7 +542,7 @@ int process_passive_service_check(time_t check_time,
 
   /* make sure the service exists */
   service_map::const_iterator found(
-      service::services.find({real_host_name, svc_description}));
+      service::services.find({hst->get_name(), svc_description}));
   if (found == service::services.end() || !found->second) {
     logger(log_runtime_warning, basic)
         << "Warning:  Passive check result was received for service '"
@@ -571,12 +560,12 @@ int process_passive_service_check(time_t check_time,
 
   timeval set_tv = {.tv_sec = check_time, .tv_usec = 0};
 
-  check_result* result =
-      new check_result(service_check, found->second.get(),
-                       checkable::check_passive, CHECK_OPTION_NONE, false,
-                       static_cast<double>(tv.tv_sec - check_time) +
-                           static_cast<double>(tv.tv_usec / 1000000.0),
-                       set_tv, set_tv, false, true, return_code, output);
+  check_result* result = checks::check_result_pool::instance().get(
+      service_check, found->second.get(), checkable::check_passive,
+      CHECK_OPTION_NONE, false,
+      static_cast<double>(tv.tv_sec - check_time) +
+          static_cast<double>(tv.tv_usec / 1000000.0),
+      set_tv, set_tv, false, true, return_code, output);
 
   /* make sure the return code is within bounds */
   if (result->get_return_code() < 0 || result->get_return_code() > 3) {
@@ -634,7 +623,6 @@ int process_passive_host_check(time_t check_time,
                                char const* host_name,
                                int return_code,
                                char const* output) {
-  char const* real_host_name(nullptr);
   /* skip this host check result if we aren't accepting passive host checks */
   if (!config->accept_passive_service_checks())
     return ERROR;
@@ -648,22 +636,10 @@ int process_passive_host_check(time_t check_time,
     return ERROR;
 
   /* find the host by its name or address */
-  host_map::const_iterator it(host::hosts.find(host_name));
-  if (it != host::hosts.end() && it->second)
-    real_host_name = host_name;
-  else {
-    for (host_map::iterator itt(host::hosts.begin()), end(host::hosts.end());
-         itt != end; ++itt) {
-      if (itt->second && itt->second->get_address() == host_name) {
-        real_host_name = itt->first.c_str();
-        it = itt;
-        break;
-      }
-    }
-  }
+  host* hst(find_host_by_name_or_address(host_name));
 
   /* we couldn't find the host */
-  if (real_host_name == nullptr) {
+  if (!hst) {
     logger(log_runtime_warning, basic)
         << "Warning:  Passive check result was received for host '" << host_name
         << "', but the host could not be found!";
@@ -671,19 +647,18 @@ int process_passive_host_check(time_t check_time,
   }
 
   /* skip this is we aren't accepting passive checks for this host */
-  if (!it->second->get_accept_passive_checks())
+  if (!hst->get_accept_passive_checks())
     return ERROR;
 
   timeval tv;
   gettimeofday(&tv, nullptr);
   timeval tv_start = {.tv_sec = check_time, .tv_usec = 0};
 
-  check_result* result =
-      new check_result(host_check, it->second.get(), checkable::check_passive,
-                       CHECK_OPTION_NONE, false,
-                       static_cast<double>(tv.tv_sec - check_time) +
-                           static_cast<double>(tv.tv_usec / 1000000.0),
-                       tv_start, tv_start, false, true, return_code, output);
+  check_result* result = checks::check_result_pool::instance().get(
+      host_check, hst, checkable::check_passive, CHECK_OPTION_NONE, false,
+      static_cast<double>(tv.tv_sec - check_time) +
+          static_cast<double>(tv.tv_usec / 1000000.0),
+      tv_start, tv_start, false, true, return_code, output);
 
   /* make sure the return code is within bounds */
   if (result->get_return_code() < 0 || result->get_return_code() > 3)
@@ -2507,7 +2482,7 @@ void acknowledge_host_problem(host* hst,
       new comment(comment::host, comment::acknowledgment, hst->get_host_id(), 0,
                   current_time, ack_author, ack_data, persistent,
                   comment::internal, false, (time_t)0)};
-  comment::comments.insert({com->get_comment_id(), com});
+  comment::insert_comment(com);
 }
 
 /* acknowledges a service problem */
@@ -2553,7 +2528,7 @@ void acknowledge_service_problem(service* svc,
       new comment(comment::service, comment::acknowledgment, svc->get_host_id(),
                   svc->get_service_id(), current_time, ack_author, ack_data,
                   persistent, comment::internal, false, (time_t)0)};
-  comment::comments.insert({com->get_comment_id(), com});
+  comment::insert_comment(com);
 }
 
 /* removes a host acknowledgement */
@@ -3414,3 +3389,26 @@ void set_service_notification_number(service* svc, int num) {
 void new_thresholds_file(char* filename) {
   anomalydetection::update_thresholds(filename);
 }
+
+void dump_memory_profile(char* filename) {
+  if (!filename) {
+    logger(log_runtime_warning, basic)
+        << "Warning: DUMP_MEMORY_PROFILE needs a file name";
+    return;
+  }
+  if (memory_stats::dump(filename))
+    logger(log_info_message, basic)
+        << "Memory profile written to '" << filename << "'";
+}
+
+/* start timing the engine hot paths, counters are reset */
+void enable_profiling(void) {
+  profiler::set_enabled(true);
+  logger(log_info_message, basic) << "Profiling enabled";
+}
+
+/* stop timing the engine hot paths, counters are kept */
+void disable_profiling(void) {
+  profiler::set_enabled(false);
+  logger(log_info_message, basic) << "Profiling disabled";
+}
@@ -570,6 +570,14 @@ processing::processing()
           {"NEW_THRESHOLDS_FILE",
            command_info(CMD_NEW_THRESHOLDS_FILE,
                         &_redirector_file<&new_thresholds_file>)},
+          {"DUMP_MEMORY_PROFILE",
+           command_info(CMD_DUMP_MEMORY_PROFILE,
+                        &_redirector_file<&dump_memory_profile>)},
+          {"ENABLE_PROFILING", command_info(CMD_ENABLE_PROFILING,
+                                            &_redirector<&enable_profiling>)},
+          {"DISABLE_PROFILING",
+           command_info(CMD_DISABLE_PROFILING,
+                        &_redirector<&disable_profiling>)},
       } {
   // misc commands.
   _lst_command["PROCESS_FILE"] = command_info(
@@ -24,6 +24,7 @@
 #include <limits>
 
 #include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/checks/check_result_pool.hh"
 #include "com/centreon/engine/checks/checker.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/host.hh"
@@ -538,8 +539,7 @@ int anomalydetection::run_async_check(int check_options,
   grab_host_macros_r(macros, get_host_ptr());
   grab_service_macros_r(macros, this);
   std::string tmp;
-  get_raw_command_line_r(macros, get_check_command_ptr(),
-                         get_check_command().c_str(), tmp, 0);
+  get_check_command_line_r(macros, this, tmp, 0);
 
   // Time to start command.
   gettimeofday(&start_time, nullptr);
@@ -577,12 +577,15 @@ int anomalydetection::run_async_check(int check_options,
                                      : ACTIVE_ONDEMAND_SERVICE_CHECK_STATS,
                      start_time.tv_sec);
 
-  std::string perfdata = string::extract_perfdata(
-      _dependent_service->get_perf_data(), _metric_name);
+  engine::perfdata::metric const* metric{
+      _dependent_service->get_perf_data_metrics().find(_metric_name)};
+  std::string perfdata;
+  if (metric)
+    perfdata.assign(metric->text, metric->text_size);
 
   std::string without_thresholds(string::remove_thresholds(perfdata));
   std::tuple<service::service_state, double, std::string, double, double> pd =
-      parse_perfdata(without_thresholds, start_time.tv_sec);
+      parse_perfdata(metric, start_time.tv_sec);
   size_t pos = without_thresholds.find(';');
   if (pos != std::string::npos)
     without_thresholds = without_thresholds.substr(pos);
@@ -590,10 +593,11 @@ int anomalydetection::run_async_check(int check_options,
     without_thresholds = "";
 
   // Init check result info.
-  std::unique_ptr<check_result> check_result_info(
-      new check_result(service_check, this, checkable::check_active,
-                       check_options, reschedule_check, latency, start_time,
-                       start_time, false, true, service::state_ok, ""));
+  checks::check_result_pool::pointer check_result_info(
+      checks::check_result_pool::instance().get(
+          service_check, this, checkable::check_active, check_options,
+          reschedule_check, latency, start_time, start_time, false, true,
+          service::state_ok, ""));
 
   oss.str("");
   oss.setf(std::ios_base::fixed, std::ios_base::floatfield);
@@ -665,26 +669,39 @@ commands::command* anomalydetection::get_check_command_ptr() const {
 std::tuple<service::service_state, double, std::string, double, double>
 anomalydetection::parse_perfdata(std::string const& perfdata,
                                  time_t check_time) {
+  engine::perfdata metrics;
+  metrics.parse(perfdata);
+  if (metrics.metrics().empty()) {
+    logger(log_runtime_error, basic)
+        << "Error: Unable to parse perfdata '" << perfdata << "'";
+    return std::make_tuple(service::state_unknown, NAN, "", NAN, NAN);
+  }
+  return parse_perfdata(&metrics.metrics().back(), check_time);
+}
+
+/**
+ * @brief Compute the status of an already parsed metric.
+ *
+ * @param metric The metric, nullptr if it is not in the perfdata.
+ * @param check_time The check time, used to interpolate thresholds.
+ *
+ * @return A tuple containing the status, the value, its unit, the lower bound
+ * and the upper bound
+ */
+std::tuple<service::service_state, double, std::string, double, double>
+anomalydetection::parse_perfdata(engine::perfdata::metric const* metric,
+                                 time_t check_time) {
   std::lock_guard<std::mutex> lock(_thresholds_m);
-  size_t pos = perfdata.find_last_of("=");
   /* If the perfdata is wrong. */
-  if (pos == std::string::npos) {
+  if (!metric) {
     logger(log_runtime_error, basic)
-        << "Error: Unable to parse perfdata '" << perfdata << "'";
+        << "Error: Unable to find metric '" << _metric_name << "' in perfdata";
     return std::make_tuple(service::state_unknown, NAN, "", NAN, NAN);
   }
 
   /* If the perfdata is good. */
-  pos++;
-  char* unit;
-
-  double value = std::strtod(perfdata.c_str() + pos, &unit);
-  char const* end = perfdata.c_str() + perfdata.size() - 1;
-  size_t l = 0;
-  /* If there is a unit, it starts at unit char* */
-  while (unit + l <= end && unit[l] != ' ' && unit[l] != ';')
-    ++l;
-  std::string uom = std::string(unit, l);
+  double value = metric->value;
+  std::string uom(metric->uom, metric->uom_size);
 
   service::service_state status;
 
@@ -694,7 +711,7 @@ anomalydetection::parse_perfdata(std::string const& perfdata,
       logger(log_info_message, basic) << "The thresholds file is not viable "
                                          "(not available or not readable).";
     }
-    return std::make_tuple(status, value, unit, NAN, NAN);
+    return std::make_tuple(status, value, uom, NAN, NAN);
   }
 
   /* The check time is probably between two timestamps stored in _thresholds.
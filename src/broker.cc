@@ -32,6 +32,39 @@
 
 using namespace com::centreon::engine;
 
+/**
+ *  Get the command name and arguments of a check command. When cmd is
+ *  the check command of the checkable (which is always the case for
+ *  engine checks) the split cached on the checkable is used and nothing
+ *  is allocated. The returned pointers are NULL when the corresponding
+ *  part is empty, as with strtok().
+ *
+ *  @param[in]  chk          Checked object.
+ *  @param[in]  cmd          Check command, may be NULL.
+ *  @param[out] name_buf     Storage used when cmd is not cached.
+ *  @param[out] args_buf     Storage used when cmd is not cached.
+ *  @param[out] command_name Command name.
+ *  @param[out] command_args Command arguments.
+ */
+static void get_check_command_name_args(checkable const* chk,
+                                        char const* cmd,
+                                        std::string& name_buf,
+                                        std::string& args_buf,
+                                        char*& command_name,
+                                        char*& command_args) {
+  std::string const* name{&name_buf};
+  std::string const* args{&args_buf};
+  if (cmd) {
+    if (cmd == chk->get_check_command().c_str()) {
+      name = &chk->get_check_command_name();
+      args = &chk->get_check_command_args();
+    } else
+      checkable::split_check_command(cmd, name_buf, args_buf);
+  }
+  command_name = name->empty() ? nullptr : const_cast<char*>(name->c_str());
+  command_args = args->empty() ? nullptr : const_cast<char*>(args->c_str());
+}
+
 extern "C" {
 
 /**
@@ -60,7 +93,8 @@ void broker_acknowledgement_data(int type,
                                  int persistent_comment,
                                  struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_ACKNOWLEDGEMENT_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_ACKNOWLEDGEMENT_DATA) ||
+      !(config->event_broker_options() & BROKER_ACKNOWLEDGEMENT_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -123,7 +157,8 @@ void broker_adaptive_contact_data(int type,
                                   unsigned long modsattrs,
                                   struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_ADAPTIVE_CONTACT_DATA) ||
+      !(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -160,7 +195,8 @@ void broker_adaptive_dependency_data(int type,
                                      void* data,
                                      struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_ADAPTIVE_DEPENDENCY_DATA) ||
+      !(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -190,7 +226,8 @@ void broker_adaptive_escalation_data(int type,
                                      void* data,
                                      struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_ADAPTIVE_ESCALATION_DATA) ||
+      !(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -226,7 +263,8 @@ void broker_adaptive_host_data(int type,
                                unsigned long modattrs,
                                struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_ADAPTIVE_HOST_DATA) ||
+      !(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -267,7 +305,8 @@ void broker_adaptive_program_data(int type,
                                   unsigned long modsattrs,
                                   struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_ADAPTIVE_PROGRAM_DATA) ||
+      !(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -307,7 +346,8 @@ void broker_adaptive_service_data(int type,
                                   unsigned long modattrs,
                                   struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_ADAPTIVE_SERVICE_DATA) ||
+      !(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -342,7 +382,8 @@ void broker_adaptive_timeperiod_data(int type,
                                      int command_type,
                                      struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_ADAPTIVE_TIMEPERIOD_DATA) ||
+      !(config->event_broker_options() & BROKER_ADAPTIVE_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -371,7 +412,8 @@ void broker_aggregated_status_data(int type,
                                    int attr,
                                    struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_STATUS_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_AGGREGATED_STATUS_DATA) ||
+      !(config->event_broker_options() & BROKER_STATUS_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -401,7 +443,8 @@ void broker_command_data(int type,
                          commands::command* cmd,
                          struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_COMMAND_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_COMMAND_DATA) ||
+      !(config->event_broker_options() & BROKER_COMMAND_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -452,7 +495,8 @@ void broker_comment_data(int type,
                          unsigned long comment_id,
                          struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_COMMENT_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_COMMENT_DATA) ||
+      !(config->event_broker_options() & BROKER_COMMENT_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -510,7 +554,8 @@ int broker_contact_notification_data(int type,
                                      int escalated,
                                      struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_NOTIFICATIONS))
+  if (!neb_has_callbacks(NEBCALLBACK_CONTACT_NOTIFICATION_DATA) ||
+      !(config->event_broker_options() & BROKER_NOTIFICATIONS))
     return OK;
 
   // Fill struct with relevant data.
@@ -585,7 +630,8 @@ int broker_contact_notification_method_data(int type,
                                             int escalated,
                                             struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_NOTIFICATIONS))
+  if (!neb_has_callbacks(NEBCALLBACK_CONTACT_NOTIFICATION_METHOD_DATA) ||
+      !(config->event_broker_options() & BROKER_NOTIFICATIONS))
     return OK;
 
   // Get command name/args.
@@ -659,7 +705,8 @@ void broker_contact_status(int type,
                            contact* cntct,
                            struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_STATUS_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_CONTACT_STATUS_DATA) ||
+      !(config->event_broker_options() & BROKER_STATUS_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -693,7 +740,8 @@ void broker_custom_variable(int type,
                             char const* varvalue,
                             struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_CUSTOMVARIABLE_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_CUSTOM_VARIABLE_DATA) ||
+      !(config->event_broker_options() & BROKER_CUSTOMVARIABLE_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -748,7 +796,8 @@ void broker_downtime_data(int type,
                           unsigned long downtime_id,
                           struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_DOWNTIME_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_DOWNTIME_DATA) ||
+      !(config->event_broker_options() & BROKER_DOWNTIME_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -816,7 +865,8 @@ int broker_event_handler(int type,
                          char* output,
                          struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_EVENT_HANDLERS))
+  if (!neb_has_callbacks(NEBCALLBACK_EVENT_HANDLER_DATA) ||
+      !(config->event_broker_options() & BROKER_EVENT_HANDLERS))
     return OK;
   if (!data)
     return ERROR;
@@ -895,7 +945,8 @@ void broker_external_command(int type,
                              char* command_args,
                              struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_EXTERNALCOMMAND_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_EXTERNAL_COMMAND_DATA) ||
+      !(config->event_broker_options() & BROKER_EXTERNALCOMMAND_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -937,7 +988,8 @@ void broker_flapping_data(int type,
                           double low_threshold,
                           struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_FLAPPING_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_FLAPPING_DATA) ||
+      !(config->event_broker_options() & BROKER_FLAPPING_DATA))
     return;
   if (!data)
     return;
@@ -986,7 +1038,8 @@ void broker_group(int type,
                   void* data,
                   struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_GROUP_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_GROUP_DATA) ||
+      !(config->event_broker_options() & BROKER_GROUP_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -1019,7 +1072,8 @@ void broker_group_member(int type,
                          void* group,
                          struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_GROUP_MEMBER_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_GROUP_MEMBER_DATA) ||
+      !(config->event_broker_options() & BROKER_GROUP_MEMBER_DATA))
     return;
 
   // Fill struct will relevant data.
@@ -1083,20 +1137,19 @@ int broker_host_check(int type,
                       char* perfdata,
                       struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_HOST_CHECKS))
+  if (!neb_has_callbacks(NEBCALLBACK_HOST_CHECK_DATA) ||
+      !(config->event_broker_options() & BROKER_HOST_CHECKS))
     return OK;
   if (!hst)
     return ERROR;
 
   // Get command name/args.
-  char* command_buf(NULL);
-  char* command_name(NULL);
-  char* command_args(NULL);
-  if (cmd) {
-    command_buf = string::dup(cmd);
-    command_name = strtok(command_buf, "!");
-    command_args = strtok(NULL, "\x0");
-  }
+  std::string name_buf;
+  std::string args_buf;
+  char* command_name;
+  char* command_args;
+  get_check_command_name_args(hst, cmd, name_buf, args_buf, command_name,
+                              command_args);
 
   // Fill struct with relevant data.
   nebstruct_host_check_data ds;
@@ -1128,9 +1181,6 @@ int broker_host_check(int type,
   // Make callbacks.
   int return_code;
   return_code = neb_make_callbacks(NEBCALLBACK_HOST_CHECK_DATA, &ds);
-
-  // Free data.
-  delete[] command_buf;
   return (return_code);
 }
 
@@ -1149,7 +1199,8 @@ void broker_host_status(int type,
                         host* hst,
                         struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_STATUS_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_HOST_STATUS_DATA) ||
+      !(config->event_broker_options() & BROKER_STATUS_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -1183,7 +1234,8 @@ void broker_log_data(int type,
                      time_t entry_time,
                      struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_LOGGED_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_LOG_DATA) ||
+      !(config->event_broker_options() & BROKER_LOGGED_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -1217,7 +1269,8 @@ void broker_module_data(int type,
                         char const* args,
                         struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_MODULE_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_MODULE_DATA) ||
+      !(config->event_broker_options() & BROKER_MODULE_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -1270,7 +1323,8 @@ int broker_notification_data(int type,
                              int contacts_notified,
                              struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_NOTIFICATIONS))
+  if (!neb_has_callbacks(NEBCALLBACK_NOTIFICATION_DATA) ||
+      !(config->event_broker_options() & BROKER_NOTIFICATIONS))
     return OK;
 
   // Fill struct with relevant data.
@@ -1322,7 +1376,8 @@ void broker_program_state(int type,
                           int attr,
                           struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_PROGRAM_STATE))
+  if (!neb_has_callbacks(NEBCALLBACK_PROCESS_DATA) ||
+      !(config->event_broker_options() & BROKER_PROGRAM_STATE))
     return;
 
   // Fill struct with relevant data.
@@ -1349,7 +1404,8 @@ void broker_program_status(int type,
                            int attr,
                            struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_STATUS_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_PROGRAM_STATUS_DATA) ||
+      !(config->event_broker_options() & BROKER_STATUS_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -1410,7 +1466,8 @@ void broker_relation_data(int type,
                           com::centreon::engine::service* dep_svc,
                           struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_RELATION_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_RELATION_DATA) ||
+      !(config->event_broker_options() & BROKER_RELATION_DATA))
     return;
   if (!hst || !dep_hst)
     return;
@@ -1443,7 +1500,8 @@ void broker_retention_data(int type,
                            int attr,
                            struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_RETENTION_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_RETENTION_DATA) ||
+      !(config->event_broker_options() & BROKER_RETENTION_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -1494,20 +1552,19 @@ int broker_service_check(int type,
                          const char* cmdline,
                          struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_SERVICE_CHECKS))
+  if (!neb_has_callbacks(NEBCALLBACK_SERVICE_CHECK_DATA) ||
+      !(config->event_broker_options() & BROKER_SERVICE_CHECKS))
     return OK;
   if (!svc)
     return ERROR;
 
   // Get command name/args.
-  char* command_buf(NULL);
-  char* command_name(NULL);
-  char* command_args(NULL);
-  if (cmd) {
-    command_buf = string::dup(cmd);
-    command_name = strtok(command_buf, "!");
-    command_args = strtok(NULL, "\x0");
-  }
+  std::string name_buf;
+  std::string args_buf;
+  char* command_name;
+  char* command_args;
+  get_check_command_name_args(svc, cmd, name_buf, args_buf, command_name,
+                              command_args);
 
   // Fill struct with relevant data.
   nebstruct_service_check_data ds;
@@ -1541,8 +1598,6 @@ int broker_service_check(int type,
   int return_code;
   return_code = neb_make_callbacks(NEBCALLBACK_SERVICE_CHECK_DATA, &ds);
 
-  // Free data.
-  delete[] command_buf;
   return return_code;
 }
 
@@ -1561,7 +1616,8 @@ void broker_service_status(int type,
                            com::centreon::engine::service* svc,
                            struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_STATUS_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_SERVICE_STATUS_DATA) ||
+      !(config->event_broker_options() & BROKER_STATUS_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -1601,7 +1657,8 @@ void broker_statechange_data(int type,
                              int max_attempts,
                              struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_STATECHANGE_DATA))
+  if (!neb_has_callbacks(NEBCALLBACK_STATE_CHANGE_DATA) ||
+      !(config->event_broker_options() & BROKER_STATECHANGE_DATA))
     return;
 
   // Fill struct with relevant data.
@@ -1664,7 +1721,8 @@ void broker_system_command(int type,
                            char* output,
                            struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_SYSTEM_COMMANDS))
+  if (!neb_has_callbacks(NEBCALLBACK_SYSTEM_COMMAND_DATA) ||
+      !(config->event_broker_options() & BROKER_SYSTEM_COMMANDS))
     return;
   if (!cmd)
     return;
@@ -1703,7 +1761,8 @@ void broker_timed_event(int type,
                         com::centreon::engine::timed_event* event,
                         struct timeval const* timestamp) {
   // Config check.
-  if (!(config->event_broker_options() & BROKER_TIMED_EVENTS))
+  if (!neb_has_callbacks(NEBCALLBACK_TIMED_EVENT_DATA) ||
+      !(config->event_broker_options() & BROKER_TIMED_EVENTS))
     return;
   if (!event)
     return;
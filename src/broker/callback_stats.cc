@@ -0,0 +1,203 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/broker/callback_stats.hh"
+#include "com/centreon/engine/broker/loader.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/nebcallbacks.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::broker;
+using namespace com::centreon::engine::logging;
+
+constexpr std::array<uint64_t, 6> callback_stat::bounds;
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] module Filename of the module owning the callback.
+ *  @param[in] type   Callback type (NEBCALLBACK_*).
+ */
+callback_stat::callback_stat(std::string const& module, int type)
+    : module{module},
+      callback_type{type},
+      calls{0},
+      total_ns{0},
+      max_ns{0} {
+  for (std::atomic<uint64_t>& b : histogram)
+    b = 0;
+}
+
+/**
+ *  Get instance of the callback_stats singleton.
+ *
+ *  @return Class instance.
+ */
+callback_stats& callback_stats::instance() {
+  static callback_stats instance;
+  return instance;
+}
+
+/**
+ *  Get (and create if needed) the counters of a module for a callback
+ *  type. This is called at callback registration, not on each call.
+ *
+ *  @param[in] module_handle The module handle given to
+ *                           neb_register_callback().
+ *  @param[in] callback_type The callback type.
+ *
+ *  @return A pointer to counters that live as long as the engine.
+ */
+callback_stat* callback_stats::get(void const* module_handle,
+                                   int callback_type) {
+  std::string name{"unknown"};
+  for (std::shared_ptr<handle> const& h : loader::instance().get_modules())
+    if (h.get() == module_handle) {
+      name = h->get_filename();
+      break;
+    }
+
+  std::lock_guard<std::mutex> lock(_m);
+  std::unique_ptr<callback_stat>& retval{
+      _stats[std::make_pair(name, callback_type)]};
+  if (!retval)
+    retval.reset(new callback_stat(name, callback_type));
+  return retval.get();
+}
+
+/**
+ *  Account one call of a callback.
+ *
+ *  @param[in] stat    Counters of the callback.
+ *  @param[in] elapsed Time spent in the callback.
+ */
+void callback_stats::record(callback_stat* stat,
+                            std::chrono::nanoseconds elapsed) {
+  uint64_t ns = elapsed.count();
+  ++stat->calls;
+  stat->total_ns += ns;
+  uint64_t max = stat->max_ns;
+  while (ns > max && !stat->max_ns.compare_exchange_weak(max, ns))
+    ;
+
+  uint64_t us = ns / 1000;
+  size_t idx = 0;
+  while (idx < callback_stat::bounds.size() && us >= callback_stat::bounds[idx])
+    ++idx;
+  ++stat->histogram[idx];
+
+  /* Log callbacks are not reported: the warning would be brokered through
+   * the same callback and could loop forever. */
+  if (config && config->event_broker_callback_warning_threshold() &&
+      stat->callback_type != NEBCALLBACK_LOG_DATA &&
+      us / 1000 >= config->event_broker_callback_warning_threshold())
+    logger(log_runtime_warning, basic)
+        << "Warning: event broker callback " << callback_type_name(
+                                                    stat->callback_type)
+        << " of module '" << stat->module << "' took " << us / 1000
+        << "ms to complete";
+}
+
+/**
+ *  Get all the counters. The returned pointers remain valid until the
+ *  engine exits.
+ *
+ *  @return A vector of counters ordered by module and callback type.
+ */
+std::vector<callback_stat const*> callback_stats::get_stats() const {
+  std::vector<callback_stat const*> retval;
+  std::lock_guard<std::mutex> lock(_m);
+  retval.reserve(_stats.size());
+  for (auto const& p : _stats)
+    retval.push_back(p.second.get());
+  return retval;
+}
+
+/**
+ *  Reset all the counters. Entries are kept since registered callbacks
+ *  still point to them.
+ */
+void callback_stats::reset() {
+  std::lock_guard<std::mutex> lock(_m);
+  for (auto& p : _stats) {
+    p.second->calls = 0;
+    p.second->total_ns = 0;
+    p.second->max_ns = 0;
+    for (std::atomic<uint64_t>& b : p.second->histogram)
+      b = 0;
+  }
+}
+
+/**
+ *  Get a human readable name of a callback type.
+ *
+ *  @param[in] callback_type The callback type.
+ *
+ *  @return A static string.
+ */
+char const* callback_stats::callback_type_name(int callback_type) noexcept {
+  static char const* const names[NEBCALLBACK_NUMITEMS]{
+      "reserved0",
+      "reserved1",
+      "reserved2",
+      "reserved3",
+      "reserved4",
+      "raw_data",
+      "neb_data",
+      "process_data",
+      "timed_event_data",
+      "log_data",
+      "system_command_data",
+      "event_handler_data",
+      "notification_data",
+      "service_check_data",
+      "host_check_data",
+      "comment_data",
+      "downtime_data",
+      "flapping_data",
+      "program_status_data",
+      "host_status_data",
+      "service_status_data",
+      "adaptive_program_data",
+      "adaptive_host_data",
+      "adaptive_service_data",
+      "external_command_data",
+      "aggregated_status_data",
+      "retention_data",
+      "contact_notification_data",
+      "contact_notification_method_data",
+      "acknowledgement_data",
+      "state_change_data",
+      "contact_status_data",
+      "adaptive_contact_data",
+      "command_data",
+      "custom_variable_data",
+      "group_data",
+      "group_member_data",
+      "module_data",
+      "relation_data",
+      "adaptive_dependency_data",
+      "adaptive_escalation_data",
+      "adaptive_timeperiod_data",
+      "enginerpc"};
+  if (callback_type < 0 || callback_type >= NEBCALLBACK_NUMITEMS)
+    return "unknown";
+  return names[callback_type];
+}
@@ -27,6 +27,8 @@
 #endif  // HAVE_GETOPT_H
 #include <unistd.h>
 #include <iostream>
+#include <string>
+#include <vector>
 #include "com/centreon/engine/check_result.hh"
 #include "com/centreon/engine/common.hh"
 #include "com/centreon/engine/notifier.hh"
@@ -42,6 +44,7 @@ using namespace com::centreon::engine;
 #define STATUS_PROGRAM_DATA 2
 #define STATUS_HOST_DATA 3
 #define STATUS_SERVICE_DATA 4
+#define STATUS_MEMORY_DATA 5
 
 // Files to be processed.
 static char* main_config_file(NULL);
@@ -200,6 +203,17 @@ int total_external_command_buffer_slots = 0;
 int used_external_command_buffer_slots = 0;
 int high_external_command_buffer_slots = 0;
 
+int waiting_service_checks = 0;
+double active_host_latency_percentiles[3] = {0.0, 0.0, 0.0};
+double active_service_latency_percentiles[3] = {0.0, 0.0, 0.0};
+
+struct memory_usage {
+  std::string subsystem;
+  unsigned long long objects;
+  unsigned long long bytes;
+};
+std::vector<memory_usage> memory_usages;
+
 // Forward declarations.
 int display_stats();
 void get_time_breakdown(unsigned long, int*, int*, int*, int*);
@@ -412,6 +426,12 @@ int display_stats() {
   printf("Active Service Latency:                 %.3f / %.3f / %.3f sec\n",
          min_active_service_latency, max_active_service_latency,
          average_active_service_latency);
+  printf("Active Service Latency p50/p90/p99:     %.3f / %.3f / %.3f sec\n",
+         active_service_latency_percentiles[0],
+         active_service_latency_percentiles[1],
+         active_service_latency_percentiles[2]);
+  printf("Service Checks Waiting For A Slot:      %d\n",
+         waiting_service_checks);
   printf("Active Service Execution Time:          %.3f / %.3f / %.3f sec\n",
          min_active_service_execution_time, max_active_service_execution_time,
          average_active_service_execution_time);
@@ -448,6 +468,10 @@ int display_stats() {
   printf("Active Host Latency:                    %.3f / %.3f / %.3f sec\n",
          min_active_host_latency, max_active_host_latency,
          average_active_host_latency);
+  printf("Active Host Latency p50/p90/p99:        %.3f / %.3f / %.3f sec\n",
+         active_host_latency_percentiles[0],
+         active_host_latency_percentiles[1],
+         active_host_latency_percentiles[2]);
   printf("Active Host Execution Time:             %.3f / %.3f / %.3f sec\n",
          min_active_host_execution_time, max_active_host_execution_time,
          average_active_host_execution_time);
@@ -521,6 +545,17 @@ int display_stats() {
   printf("\n");
   printf("\n");
 
+  if (!memory_usages.empty()) {
+    printf("MEMORY USAGE\n");
+    printf("----------------------------------------------------\n");
+    printf("%-28s %14s %15s\n", "Subsystem", "Objects", "Bytes");
+    for (memory_usage const& m : memory_usages)
+      printf("%-28s %14llu %15llu\n", m.subsystem.c_str(), m.objects,
+             m.bytes);
+    printf("\n");
+    printf("\n");
+  }
+
   /*
     printf("CURRENT COMMENT DATA\n");
     printf("----------------------------------------------------\n");
@@ -616,6 +651,10 @@ int read_status_file() {
       data_type = STATUS_INFO_DATA;
     else if (!strcmp(temp_buffer, "programstatus {"))
       data_type = STATUS_PROGRAM_DATA;
+    else if (!strcmp(temp_buffer, "memorystatus {")) {
+      data_type = STATUS_MEMORY_DATA;
+      memory_usages.push_back(memory_usage{"", 0, 0});
+    }
 
     /* end of definition */
     else if (!strcmp(temp_buffer, "}")) {
@@ -971,7 +1010,19 @@ int read_status_file() {
             used_external_command_buffer_slots = atoi(val);
           else if (!strcmp(var, "high_external_command_buffer_slots"))
             high_external_command_buffer_slots = atoi(val);
-          else if (!strcmp(var, "nagios_pid"))
+          else if (!strcmp(var, "waiting_service_checks"))
+            waiting_service_checks = atoi(val);
+          else if (!strcmp(var, "active_host_check_latency_percentiles") ||
+                   !strcmp(var, "active_service_check_latency_percentiles")) {
+            double* percentiles(var[7] == 'h'
+                                    ? active_host_latency_percentiles
+                                    : active_service_latency_percentiles);
+            temp_ptr = strtok(val, ",");
+            for (int i = 0; i < 3 && temp_ptr; ++i) {
+              percentiles[i] = strtod(temp_ptr, NULL);
+              temp_ptr = strtok(NULL, ",");
+            }
+          } else if (!strcmp(var, "nagios_pid"))
             nagios_pid = strtoul(val, NULL, 10);
           else if (!strcmp(var, "active_scheduled_host_check_stats")) {
             if ((temp_ptr = strtok(val, ",")))
@@ -1099,6 +1150,15 @@ int read_status_file() {
             should_be_scheduled = (atoi(val) > 0) ? true : false;
           break;
 
+        case STATUS_MEMORY_DATA:
+          if (!strcmp(var, "subsystem"))
+            memory_usages.back().subsystem = val;
+          else if (!strcmp(var, "objects"))
+            memory_usages.back().objects = strtoull(val, NULL, 10);
+          else if (!strcmp(var, "bytes"))
+            memory_usages.back().bytes = strtoull(val, NULL, 10);
+          break;
+
         default:
           break;
       }
@@ -50,7 +50,9 @@ check_result::check_result(enum check_source object_check_type,
       _early_timeout{early_timeout},
       _exited_ok{exited_ok},
       _return_code{return_code},
-      _output{output} {}
+      _output{output},
+      _notifier_generation{0},
+      _next{nullptr} {}
 
 enum check_source check_result::get_object_check_type() const {
   return _object_check_type;
@@ -155,3 +157,19 @@ int check_result::get_check_options() const {
 void check_result::set_check_options(int check_options) {
   _check_options = check_options;
 }
+
+uint64_t check_result::get_notifier_generation() const {
+  return _notifier_generation;
+}
+
+void check_result::set_notifier_generation(uint64_t generation) {
+  _notifier_generation = generation;
+}
+
+check_result* check_result::get_next() const {
+  return _next;
+}
+
+void check_result::set_next(check_result* next) {
+  _next = next;
+}
@@ -18,14 +18,17 @@
 */
 
 #include "com/centreon/engine/checkable.hh"
+#include <ctime>
 #include <sstream>
 #include "com/centreon/engine/exceptions/error.hh"
 #include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/macros/defines.hh"
 
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::logging;
 
-checkable::checkable(std::string const& display_name,
+checkable::checkable(checkable_state_store& states,
+                     std::string const& display_name,
                      std::string const& check_command,
                      bool checks_enabled,
                      bool accept_passive_checks,
@@ -48,6 +51,7 @@ checkable::checkable(std::string const& display_name,
                      bool obsess_over,
                      std::string const& timezone)
     : check_period_ptr{nullptr},
+      _state{states.acquire(this)},
       _display_name{display_name},
       _check_command{check_command},
       _check_interval{check_interval},
@@ -61,33 +65,25 @@ checkable::checkable(std::string const& display_name,
       _icon_image_alt{icon_image_alt},
       _notes{notes},
       _notes_url{notes_url},
+      _perf_data_parsed{false},
       _flap_detection_enabled{flap_detection_enabled},
       _low_flap_threshold{low_flap_threshold},
       _high_flap_threshold{high_flap_threshold},
       _obsess_over{obsess_over},
       _timezone{timezone},
-      _checks_enabled{checks_enabled},
-      _accept_passive_checks{accept_passive_checks},
-      _check_freshness{check_freshness},
-      _freshness_threshold{freshness_threshold},
-      _check_type{check_active},
-      _current_attempt{0},
-      _has_been_checked{false},
-      _scheduled_downtime_depth{0},
-      _execution_time{0.0},
-      _is_flapping{false},
-      _last_check{0},
-      _latency{0.0},
-      _next_check{0L},
-      _should_be_scheduled{true},
-      _state_history_index{0},
-      _last_state_change{0},
-      _last_hard_state_change{0},
-      _state_type{soft},
-      _percent_state_change{0.0},
       _event_handler_ptr{nullptr},
       _check_command_ptr{nullptr},
-      _is_executing{false} {
+      _check_sequence{0} {
+  _state->checks_enabled = checks_enabled;
+  _state->accept_passive_checks = accept_passive_checks;
+  _state->check_freshness = check_freshness;
+  _state->freshness_threshold = freshness_threshold;
+  _state->check_type = check_active;
+  _state->state_type = soft;
+  _watch_freshness();
+  split_check_command(_check_command, _check_command_name,
+                      _check_command_args);
+  parse_command_args(_check_command, _check_command_argv);
   if (max_attempts <= 0 || retry_interval <= 0 || freshness_threshold < 0) {
     std::ostringstream oss;
     bool empty{true};
@@ -127,6 +123,38 @@ std::string const& checkable::get_check_command() const {
 
 void checkable::set_check_command(std::string const& check_command) {
   _check_command = check_command;
+  split_check_command(_check_command, _check_command_name,
+                      _check_command_args);
+  parse_command_args(_check_command, _check_command_argv);
+}
+
+/**
+ *  Get the command name part of the check command (before the first
+ *  '!'). It is computed once when the check command is set.
+ *
+ *  @return The command name.
+ */
+std::string const& checkable::get_check_command_name() const {
+  return _check_command_name;
+}
+
+/**
+ *  Get the arguments part of the check command (after the first '!').
+ *
+ *  @return The command arguments, empty if there are none.
+ */
+std::string const& checkable::get_check_command_args() const {
+  return _check_command_args;
+}
+
+/**
+ *  Get the parsed check command arguments, used to fill the $ARGn$
+ *  macros. They are parsed once when the check command is set.
+ *
+ *  @return The check command arguments.
+ */
+checkable::command_args const& checkable::get_check_command_argv() const {
+  return _check_command_argv;
 }
 
 uint32_t checkable::get_check_interval() const {
@@ -135,6 +163,7 @@ uint32_t checkable::get_check_interval() const {
 
 void checkable::set_check_interval(uint32_t check_interval) {
   _check_interval = check_interval;
+  _watch_freshness();
 }
 
 double checkable::get_retry_interval() const {
@@ -143,22 +172,23 @@ double checkable::get_retry_interval() const {
 
 void checkable::set_retry_interval(double retry_interval) {
   _retry_interval = retry_interval;
+  _watch_freshness();
 }
 
 time_t checkable::get_last_state_change() const {
-  return _last_state_change;
+  return _state->last_state_change;
 }
 
 void checkable::set_last_state_change(time_t last_state_change) {
-  _last_state_change = last_state_change;
+  _state->last_state_change = last_state_change;
 }
 
 time_t checkable::get_last_hard_state_change() const {
-  return _last_hard_state_change;
+  return _state->last_hard_state_change;
 }
 
 void checkable::set_last_hard_state_change(time_t last_hard_state_change) {
-  _last_hard_state_change = last_hard_state_change;
+  _state->last_hard_state_change = last_hard_state_change;
 }
 
 int checkable::get_max_attempts() const {
@@ -247,6 +277,21 @@ std::string const& checkable::get_perf_data() const {
 
 void checkable::set_perf_data(std::string const& perf_data) {
   _perf_data = perf_data;
+  _perf_data_parsed = false;
+}
+
+/**
+ *  Get the metrics of the perfdata. The perfdata is parsed on the first
+ *  call after it is set, the metrics point into get_perf_data().
+ *
+ *  @return The perfdata metrics.
+ */
+perfdata const& checkable::get_perf_data_metrics() const {
+  if (!_perf_data_parsed) {
+    _perf_data_metrics.parse(_perf_data);
+    _perf_data_parsed = true;
+  }
+  return _perf_data_metrics;
 }
 
 bool checkable::get_flap_detection_enabled(void) const {
@@ -282,55 +327,57 @@ void checkable::set_timezone(std::string const& timezone) {
 }
 
 uint32_t checkable::get_state_history_index() const {
-  return _state_history_index;
+  return _state->state_history_index;
 }
 
 void checkable::set_state_history_index(uint32_t state_history_index) {
-  _state_history_index = state_history_index;
+  _state->state_history_index = state_history_index;
 }
 
 bool checkable::get_checks_enabled() const {
-  return _checks_enabled;
+  return _state->checks_enabled;
 }
 
 void checkable::set_checks_enabled(bool checks_enabled) {
-  _checks_enabled = checks_enabled;
+  _state->checks_enabled = checks_enabled;
+  _watch_freshness();
 }
 
 bool checkable::get_check_freshness() const {
-  return _check_freshness;
+  return _state->check_freshness;
 }
 
 void checkable::set_check_freshness(bool check_freshness) {
-  _check_freshness = check_freshness;
+  _state->check_freshness = check_freshness;
+  _watch_freshness();
 }
 
 enum checkable::check_type checkable::get_check_type() const {
-  return _check_type;
+  return static_cast<check_type>(_state->check_type);
 }
 
 void checkable::set_check_type(checkable::check_type check_type) {
-  _check_type = check_type;
+  _state->check_type = check_type;
 }
 
 void checkable::set_current_attempt(int attempt) {
-  _current_attempt = attempt;
+  _state->current_attempt = attempt;
 }
 
 int checkable::get_current_attempt() const {
-  return _current_attempt;
+  return _state->current_attempt;
 }
 
 void checkable::add_current_attempt(int num) {
-  _current_attempt += num;
+  _state->current_attempt += num;
 }
 
 bool checkable::has_been_checked() const {
-  return _has_been_checked;
+  return _state->has_been_checked;
 }
 
 void checkable::set_has_been_checked(bool has_been_checked) {
-  _has_been_checked = has_been_checked;
+  _state->has_been_checked = has_been_checked;
 }
 
 bool checkable::get_event_handler_enabled() const {
@@ -342,92 +389,104 @@ void checkable::set_event_handler_enabled(bool event_handler_enabled) {
 }
 
 bool checkable::get_accept_passive_checks() const {
-  return _accept_passive_checks;
+  return _state->accept_passive_checks;
 }
 
 void checkable::set_accept_passive_checks(bool accept_passive_checks) {
-  _accept_passive_checks = accept_passive_checks;
+  _state->accept_passive_checks = accept_passive_checks;
+  _watch_freshness();
 }
 
 int checkable::get_scheduled_downtime_depth() const {
-  return _scheduled_downtime_depth;
+  return _state->scheduled_downtime_depth;
 }
 
 void checkable::set_scheduled_downtime_depth(
     int scheduled_downtime_depth) noexcept {
-  _scheduled_downtime_depth = scheduled_downtime_depth;
+  _state->scheduled_downtime_depth = scheduled_downtime_depth;
 }
 
 void checkable::inc_scheduled_downtime_depth() noexcept {
-  ++_scheduled_downtime_depth;
+  ++_state->scheduled_downtime_depth;
 }
 
 void checkable::dec_scheduled_downtime_depth() noexcept {
-  --_scheduled_downtime_depth;
+  --_state->scheduled_downtime_depth;
 }
 
 double checkable::get_execution_time() const {
-  return _execution_time;
+  return _state->execution_time;
 }
 
 void checkable::set_execution_time(double execution_time) {
-  _execution_time = execution_time;
+  _state->execution_time = execution_time;
+}
+
+double checkable::get_execution_time_estimate() const {
+  return _state->execution_time_estimate;
+}
+
+void checkable::set_execution_time_estimate(double estimate) {
+  _state->execution_time_estimate = estimate;
 }
 
 int checkable::get_freshness_threshold() const {
-  return _freshness_threshold;
+  return _state->freshness_threshold;
 }
 
 void checkable::set_freshness_threshold(int freshness_threshold) {
-  _freshness_threshold = freshness_threshold;
+  _state->freshness_threshold = freshness_threshold;
+  _watch_freshness();
 }
 
 bool checkable::get_is_flapping() const {
-  return _is_flapping;
+  return _state->is_flapping;
 }
 
 void checkable::set_is_flapping(bool is_flapping) {
-  _is_flapping = is_flapping;
+  _state->is_flapping = is_flapping;
 }
 
 std::time_t checkable::get_last_check() const {
-  return _last_check;
+  return _state->last_check;
 }
 
 void checkable::set_last_check(time_t last_check) {
-  _last_check = last_check;
+  _state->last_check = last_check;
+  _watch_freshness();
 }
 
 double checkable::get_latency() const {
-  return _latency;
+  return _state->latency;
 }
 
 void checkable::set_latency(double latency) {
-  _latency = latency;
+  _state->latency = latency;
 }
 
 std::time_t checkable::get_next_check() const {
-  return _next_check;
+  return _state->next_check;
 }
 
 void checkable::set_next_check(std::time_t next_check) {
-  _next_check = next_check;
+  _state->next_check = next_check;
 }
 
 enum checkable::state_type checkable::get_state_type() const {
-  return _state_type;
+  return static_cast<state_type>(_state->state_type);
 }
 
 void checkable::set_state_type(enum checkable::state_type state_type) {
-  _state_type = state_type;
+  _state->state_type = state_type;
+  _watch_freshness();
 }
 
 double checkable::get_percent_state_change() const {
-  return _percent_state_change;
+  return _state->percent_state_change;
 }
 
 void checkable::set_percent_state_change(double percent_state_change) {
-  _percent_state_change = percent_state_change;
+  _state->percent_state_change = percent_state_change;
 }
 
 bool checkable::get_obsess_over() const {
@@ -439,11 +498,11 @@ void checkable::set_obsess_over(bool obsess_over) {
 }
 
 bool checkable::get_should_be_scheduled() const {
-  return _should_be_scheduled;
+  return _state->should_be_scheduled;
 }
 
 void checkable::set_should_be_scheduled(bool should_be_scheduled) {
-  _should_be_scheduled = should_be_scheduled;
+  _state->should_be_scheduled = should_be_scheduled;
 }
 
 commands::command* checkable::get_event_handler_ptr() const {
@@ -463,9 +522,96 @@ void checkable::set_check_command_ptr(commands::command* cmd) {
 }
 
 bool checkable::get_is_executing() const {
-  return _is_executing;
+  return _state->is_executing;
 }
 
 void checkable::set_is_executing(bool is_executing) {
-  _is_executing = is_executing;
+  if (is_executing)
+    ++_check_sequence;
+  _state->is_executing = is_executing;
+}
+
+uint32_t checkable::get_check_sequence() const {
+  return _check_sequence;
+}
+
+/**
+ *  Get the status file blocks of this object.
+ *
+ *  @return The blocks, that the status file writer fills.
+ */
+checkable::status_blocks& checkable::get_status_blocks() noexcept {
+  return _status_blocks;
+}
+
+/**
+ *  Split a check command into its command name and its arguments. The
+ *  result is the one strtok() gives with "!" then "" as delimiters:
+ *  leading '!' are skipped and arguments are everything after the '!'
+ *  that follows the command name.
+ *
+ *  @param[in]  check_command The check command ("name!arg1!arg2").
+ *  @param[out] name          The command name.
+ *  @param[out] args          The arguments.
+ */
+void checkable::split_check_command(std::string const& check_command,
+                                    std::string& name,
+                                    std::string& args) {
+  size_t start{check_command.find_first_not_of('!')};
+  if (start == std::string::npos) {
+    name.clear();
+    args.clear();
+    return;
+  }
+  size_t end{check_command.find('!', start)};
+  if (end == std::string::npos) {
+    name.assign(check_command, start, std::string::npos);
+    args.clear();
+  } else {
+    name.assign(check_command, start, end - start);
+    args.assign(check_command, end + 1, std::string::npos);
+  }
+}
+
+/**
+ *  Parse the arguments of a command ("name!arg1!arg2"). Arguments are
+ *  separated by '!', a backslash escapes the next character. At most
+ *  MAX_COMMAND_ARGUMENTS arguments are kept.
+ *
+ *  @param[in]  command The command.
+ *  @param[out] argv    The arguments.
+ */
+void checkable::parse_command_args(std::string const& command,
+                                   command_args& argv) {
+  argv.clear();
+  size_t pos{command.find('!')};
+  if (pos == std::string::npos)
+    return;
+
+  bool escaped{false};
+  while (pos < command.size() && argv.size() < MAX_COMMAND_ARGUMENTS) {
+    command_arg arg{std::string(), false};
+    for (++pos; pos < command.size(); ++pos) {
+      char c{command[pos]};
+      if (c == '\\' && !escaped) {
+        escaped = true;
+        continue;
+      }
+      if (c == '!' && !escaped)
+        break;
+      arg.value.push_back(c);
+      escaped = false;
+    }
+    arg.has_macros = arg.value.find('$') != std::string::npos;
+    argv.push_back(std::move(arg));
+  }
+}
+
+/**
+ *  Ask for a freshness check at the next sweep, after a change of the
+ *  fields the freshness depends on. The sweep computes the real deadline.
+ */
+void checkable::_watch_freshness() {
+  if (_state->check_freshness)
+    _state.get_deleter().store->watch_freshness(*_state, std::time(nullptr));
 }
@@ -0,0 +1,182 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/checkable_state.hh"
+#include <algorithm>
+#include <functional>
+
+using namespace com::centreon::engine;
+
+constexpr size_t checkable_state_store::chunk_size;
+
+/**
+ *  Get the store of host states. Stores are never destroyed: hosts and
+ *  services in static containers may be destroyed after them at exit.
+ *
+ *  @return The host store.
+ */
+checkable_state_store& checkable_state_store::hosts() {
+  static checkable_state_store* instance{new checkable_state_store};
+  return *instance;
+}
+
+/**
+ *  Get the store of service states.
+ *
+ *  @return The service store.
+ */
+checkable_state_store& checkable_state_store::services() {
+  static checkable_state_store* instance{new checkable_state_store};
+  return *instance;
+}
+
+/**
+ *  Allocate a state with default values.
+ *
+ *  @param[in] owner  The checkable owning the state.
+ *
+ *  @return The state, released when the handle is destroyed.
+ */
+checkable_state_store::handle checkable_state_store::acquire(
+    checkable* owner) {
+  checkable_state* st;
+  if (!_free.empty()) {
+    st = _free.back();
+    _free.pop_back();
+  } else {
+    if (_used == _chunks.size() * chunk_size) {
+      _chunks.emplace_back(new checkable_state[chunk_size]);
+      /* The free list holds at most all the states, release() never
+       * allocates. */
+      _free.reserve(capacity());
+    }
+    st = &_chunks.back()[_used % chunk_size];
+    ++_used;
+  }
+  *st = checkable_state();
+  st->owner = owner;
+  return handle{st, deleter{this}};
+}
+
+/**
+ *  Give a state back to the store. The free list capacity is reserved by
+ *  acquire(), so this does not allocate.
+ *
+ *  @param[in] st  The state.
+ */
+void checkable_state_store::release(checkable_state* st) noexcept {
+  st->owner = nullptr;
+  _free.push_back(st);
+}
+
+/**
+ *  Get the number of states in use.
+ *
+ *  @return The number of states.
+ */
+size_t checkable_state_store::size() const noexcept {
+  return _used - _free.size();
+}
+
+/**
+ *  Get the number of allocated states, used or not.
+ *
+ *  @return The number of states.
+ */
+size_t checkable_state_store::capacity() const noexcept {
+  return _chunks.size() * chunk_size;
+}
+
+/**
+ *  Set the next freshness check of a state. It replaces the previous one.
+ *
+ *  @param[in,out] st        The state.
+ *  @param[in]     deadline  Time of the freshness check.
+ */
+void checkable_state_store::watch_freshness(checkable_state& st,
+                                            std::time_t deadline) {
+  if (st.freshness_deadline == deadline)
+    return;
+  st.freshness_deadline = deadline;
+
+  /* Drop the replaced entries when they are too many. */
+  if (_freshness.size() > 2 * size() + 64) {
+    _freshness.erase(
+        std::remove_if(_freshness.begin(), _freshness.end(),
+                       [](freshness_entry const& d) {
+                         return !d.second->owner ||
+                                d.second->freshness_deadline != d.first;
+                       }),
+        _freshness.end());
+    std::make_heap(_freshness.begin(), _freshness.end(),
+                   std::greater<freshness_entry>());
+  }
+  _freshness.emplace_back(deadline, &st);
+  std::push_heap(_freshness.begin(), _freshness.end(),
+                 std::greater<freshness_entry>());
+}
+
+/**
+ *  Build the freshness index again, all the states with freshness checking
+ *  enabled get the same deadline.
+ *
+ *  @param[in] deadline  Time of the freshness checks.
+ */
+void checkable_state_store::reset_freshness(std::time_t deadline) {
+  _freshness.clear();
+  for_each([this, deadline](checkable_state& st) {
+    st.freshness_deadline = 0;
+    if (st.check_freshness)
+      watch_freshness(st, deadline);
+  });
+}
+
+/**
+ *  Remove from the freshness index the states whose deadline is reached.
+ *
+ *  @param[in] now  Current time.
+ *
+ *  @return The states to check, they have to be watched again to stay in
+ *          the index.
+ */
+std::vector<checkable_state*> checkable_state_store::pop_freshness_due(
+    std::time_t now) {
+  std::vector<checkable_state*> retval;
+  while (!_freshness.empty() && _freshness.front().first <= now) {
+    std::pop_heap(_freshness.begin(), _freshness.end(),
+                  std::greater<freshness_entry>());
+    freshness_entry d{_freshness.back()};
+    _freshness.pop_back();
+    if (d.second->owner && d.second->freshness_deadline == d.first) {
+      d.second->freshness_deadline = 0;
+      retval.push_back(d.second);
+    }
+  }
+  return retval;
+}
+
+/**
+ *  Get the number of entries in the freshness index, replaced ones
+ *  included.
+ *
+ *  @return The number of entries.
+ */
+size_t checkable_state_store::freshness_index_size() const noexcept {
+  return _freshness.size();
+}
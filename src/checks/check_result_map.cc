@@ -0,0 +1,164 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/checks/check_result_map.hh"
+#include <cassert>
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::checks;
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] capacity  Initial number of slots, rounded up to a power of
+ *                       2.
+ */
+check_result_map::check_result_map(size_t capacity) : _size{0} {
+  size_t slots(8);
+  while (slots < capacity)
+    slots <<= 1;
+  _slots.resize(slots, slot{0, nullptr});
+  _mask = slots - 1;
+}
+
+/**
+ *  Remove all the entries, the results are not destroyed.
+ */
+void check_result_map::clear() noexcept {
+  for (slot& s : _slots)
+    s = slot{0, nullptr};
+  _size = 0;
+}
+
+/**
+ *  Remove the entries whose result matches a predicate. The predicate is
+ *  called once per entry and is responsible for the removed results.
+ *
+ *  @param[in] pred  Predicate.
+ */
+void check_result_map::erase_if(
+    std::function<bool(check_result*)> const& pred) {
+  std::vector<slot> kept;
+  for (slot const& s : _slots)
+    if (s.id && !pred(s.result))
+      kept.push_back(s);
+  if (kept.size() == _size)
+    return;
+  clear();
+  for (slot const& s : kept)
+    insert(s.id, s.result);
+}
+
+/**
+ *  Call a function on each result.
+ *
+ *  @param[in] f  Function.
+ */
+void check_result_map::for_each(
+    std::function<void(check_result const*)> const& f) const {
+  for (slot const& s : _slots)
+    if (s.id)
+      f(s.result);
+}
+
+/**
+ *  Add or replace the result of a command.
+ *
+ *  @param[in] id      Command id, not 0.
+ *  @param[in] result  Check result.
+ */
+void check_result_map::insert(uint64_t id, check_result* result) {
+  assert(id);
+  if ((_size + 1) * 2 > _slots.size())
+    _grow();
+  size_t i(_index(id));
+  while (_slots[i].id && _slots[i].id != id)
+    i = (i + 1) & _mask;
+  if (!_slots[i].id)
+    ++_size;
+  _slots[i] = slot{id, result};
+}
+
+/**
+ *  Get the number of entries.
+ *
+ *  @return A number of check results.
+ */
+size_t check_result_map::size() const noexcept {
+  return _size;
+}
+
+/**
+ *  Remove the result of a command.
+ *
+ *  @param[in] id  Command id.
+ *
+ *  @return The check result, nullptr if the id is unknown.
+ */
+check_result* check_result_map::take(uint64_t id) noexcept {
+  if (!id)
+    return nullptr;
+  size_t i(_index(id));
+  while (_slots[i].id != id) {
+    if (!_slots[i].id)
+      return nullptr;
+    i = (i + 1) & _mask;
+  }
+  check_result* retval(_slots[i].result);
+  --_size;
+
+  /* Move back the entries that could not be stored in their own slot
+   * because of the removed one. */
+  size_t hole(i);
+  for (size_t j((i + 1) & _mask); _slots[j].id; j = (j + 1) & _mask) {
+    size_t home(_index(_slots[j].id));
+    /* The entry can fill the hole if its home is not in (hole, j]. */
+    if (((j - home) & _mask) >= ((j - hole) & _mask)) {
+      _slots[hole] = _slots[j];
+      hole = j;
+    }
+  }
+  _slots[hole] = slot{0, nullptr};
+  return retval;
+}
+
+/**
+ *  Get the home slot of an id. Ids are consecutive, the multiplication
+ *  spreads them over the table.
+ *
+ *  @param[in] id  Command id.
+ *
+ *  @return A slot index.
+ */
+size_t check_result_map::_index(uint64_t id) const noexcept {
+  return (id * 0x9e3779b97f4a7c15ull >> 32) & _mask;
+}
+
+/**
+ *  Double the number of slots.
+ */
+void check_result_map::_grow() {
+  std::vector<slot> old(_slots.size() * 2, slot{0, nullptr});
+  old.swap(_slots);
+  _mask = _slots.size() - 1;
+  _size = 0;
+  for (slot const& s : old)
+    if (s.id)
+      insert(s.id, s.result);
+}
@@ -0,0 +1,154 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/checks/check_result_pool.hh"
+#include "com/centreon/engine/memory_stats.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::checks;
+
+size_t const check_result_pool::max_free;
+size_t const check_result_pool::max_output_capacity;
+
+/**
+ *  Give a result back to the pool.
+ *
+ *  @param[in] result  The result, may be null.
+ */
+void check_result_pool::deleter::operator()(
+    check_result* result) const noexcept {
+  check_result_pool::instance().put(result);
+}
+
+/**
+ *  Get instance of the check_result_pool singleton.
+ *
+ *  @return Class instance.
+ */
+check_result_pool& check_result_pool::instance() {
+  static check_result_pool instance;
+  return instance;
+}
+
+/**
+ *  Destructor. Delete the free results.
+ */
+check_result_pool::~check_result_pool() noexcept {
+  for (check_result* result : _free)
+    delete result;
+}
+
+/**
+ *  Get a check result, a recycled one if possible. Arguments are the ones
+ *  of the check_result constructor.
+ *
+ *  @return A check result to give back with put().
+ */
+check_result* check_result_pool::get(enum check_source object_check_type,
+                                     notifier* notifier,
+                                     enum checkable::check_type check_type,
+                                     int check_options,
+                                     bool reschedule_check,
+                                     double latency,
+                                     struct timeval start_time,
+                                     struct timeval finish_time,
+                                     bool early_timeout,
+                                     bool exited_ok,
+                                     int return_code,
+                                     std::string const& output) {
+  check_result* retval(nullptr);
+  {
+    std::lock_guard<std::mutex> lock(_m);
+    if (!_free.empty()) {
+      retval = _free.back();
+      _free.pop_back();
+    }
+  }
+  if (!retval)
+    return new check_result(object_check_type, notifier, check_type,
+                            check_options, reschedule_check, latency,
+                            start_time, finish_time, early_timeout, exited_ok,
+                            return_code, output);
+
+  retval->set_object_check_type(object_check_type);
+  retval->set_notifier(notifier);
+  retval->set_check_type(check_type);
+  retval->set_check_options(check_options);
+  retval->set_reschedule_check(reschedule_check);
+  retval->set_latency(latency);
+  retval->set_start_time(start_time);
+  retval->set_finish_time(finish_time);
+  retval->set_early_timeout(early_timeout);
+  retval->set_exited_ok(exited_ok);
+  retval->set_return_code(return_code);
+  /* Assigning keeps the buffer of the previous output. */
+  retval->set_output(output);
+  return retval;
+}
+
+/**
+ *  Give a check result back to the pool.
+ *
+ *  @param[in] result  The result, may be null.
+ */
+void check_result_pool::put(check_result* result) noexcept {
+  if (!result)
+    return;
+  result->set_notifier(nullptr);
+  result->set_notifier_generation(0);
+  result->set_next(nullptr);
+  if (result->_output.capacity() > max_output_capacity)
+    std::string().swap(result->_output);
+  else
+    result->_output.clear();
+
+  std::unique_lock<std::mutex> lock(_m);
+  if (_free.size() < max_free) {
+    try {
+      _free.push_back(result);
+      return;
+    } catch (...) {
+    }
+  }
+  lock.unlock();
+  delete result;
+}
+
+/**
+ *  Get the number of free check results kept by the pool.
+ *
+ *  @return A number of check results.
+ */
+size_t check_result_pool::free_count() {
+  std::lock_guard<std::mutex> lock(_m);
+  return _free.size();
+}
+
+/**
+ *  Get the memory used by the free check results.
+ *
+ *  @return A size in bytes.
+ */
+uint64_t check_result_pool::free_bytes() {
+  std::lock_guard<std::mutex> lock(_m);
+  uint64_t retval(_free.capacity() * sizeof(check_result*));
+  for (check_result const* result : _free)
+    retval += sizeof(*result) + memory_stats::string_size(result->get_output());
+  return retval;
+}
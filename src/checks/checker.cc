@@ -24,9 +24,12 @@
 #include <cstdlib>
 
 #include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/checks/check_result_pool.hh"
+#include "com/centreon/engine/checks/exec_time_estimator.hh"
 #include "com/centreon/engine/exceptions/error.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/memory_stats.hh"
 #include "com/centreon/engine/neberrors.hh"
 #include "com/centreon/engine/objects.hh"
 #include "com/centreon/engine/shared.hh"
@@ -72,22 +75,30 @@ void checker::deinit() {
 void checker::clear() noexcept {
   try {
     std::lock_guard<std::mutex> lock(_mut_reap);
-    while (!_to_reap_partial.empty()) {
-      check_result* result = _to_reap_partial.front();
-      _to_reap_partial.pop_front();
-      delete result;
+    check_result_pool& pool(check_result_pool::instance());
+    check_result* result = _to_reap_partial.exchange(nullptr);
+    while (result) {
+      check_result* next = result->get_next();
+      _release(result);
+      pool.put(result);
+      result = next;
     }
-    while (!_to_reap.empty()) {
-      check_result* result = _to_reap.front();
-      _to_reap.pop_front();
-      delete result;
-    }
-    auto it = _waiting_check_result.begin();
-    while (it != _waiting_check_result.end()) {
-      delete it->second;
-      it = _waiting_check_result.erase(it);
+    while (_to_reap_first) {
+      result = _to_reap_first;
+      _to_reap_first = result->get_next();
+      _release(result);
+      pool.put(result);
     }
+    _to_reap_last = nullptr;
+    _waiting_check_result.erase_if([this, &pool](check_result* result) {
+      _release(result);
+      pool.put(result);
+      return true;
+    });
     _to_forget.clear();
+    _forgotten.clear();
+    for (timeout_wheel& w : _in_flight)
+      w.clear();
   } catch (...) {
   }
 }
@@ -108,37 +119,48 @@ void checker::reap() {
   {  // Scope to release mutex in all termination cases.
     {
       std::lock_guard<std::mutex> lock(_mut_reap);
-      if (!_to_forget.empty()) {
-        for (notifier* n : _to_forget) {
-          for (auto it = _waiting_check_result.begin();
-               it != _waiting_check_result.end();) {
-            if (it->second->get_notifier() == n) {
-              delete it->second;
-              it = _waiting_check_result.erase(it);
-            } else
-              ++it;
-          }
-          for (auto it = _to_reap_partial.begin();
-               it != _to_reap_partial.end();) {
-            if ((*it)->get_notifier() == n) {
-              delete *it;
-              it = _to_reap_partial.erase(it);
-            } else
-              ++it;
-          }
-        }
-        _to_forget.clear();
+      _forget_notifiers();
+    }
+
+    /* The stack is reversed to get the results in their arrival order, after
+     * the ones left by the previous reap. */
+    check_result* taken =
+        _to_reap_partial.exchange(nullptr, std::memory_order_acquire);
+    if (taken) {
+      check_result* last = taken;
+      check_result* first = nullptr;
+      while (taken) {
+        check_result* next = taken->get_next();
+        taken->set_next(first);
+        first = taken;
+        taken = next;
       }
-      std::swap(_to_reap, _to_reap_partial);
+      if (_to_reap_last)
+        _to_reap_last->set_next(first);
+      else
+        _to_reap_first = first;
+      _to_reap_last = last;
     }
 
     // Process check results.
-    while (!_to_reap.empty()) {
+    check_result_pool& pool(check_result_pool::instance());
+    while (_to_reap_first) {
+      check_result* result = _to_reap_first;
+      _to_reap_first = result->get_next();
+      if (!_to_reap_first)
+        _to_reap_last = nullptr;
+
+      /* Its host or service was removed by a reload. */
+      if (!_release(result)) {
+        logger(dbg_checks, more)
+            << "Dropping a check result of a removed host or service";
+        pool.put(result);
+        continue;
+      }
+
       // Get result host or service check.
       logger(dbg_checks, basic)
           << "Found a check result (#" << ++reaped_checks << ") to handle...";
-      check_result* result = _to_reap.front();
-      _to_reap.pop_front();
 
       // Service check result->
       if (service_check == result->get_object_check_type()) {
@@ -170,7 +192,7 @@ void checker::reap() {
         }
       }
 
-      delete result;
+      pool.put(result);
 
       // Check if reaping has timed out.
       time_t current_time;
@@ -335,10 +357,91 @@ void checker::run_sync(host* hst,
  *                                     *
  **************************************/
 
+/**
+ *  Remove the deadlines of the destroyed hosts and services and drop their
+ *  check results still waiting for a command: without deadline, a command
+ *  that never finishes would keep them forever. Their other check results
+ *  are dropped when they leave the checker, see _release().
+ *  _mut_reap must be locked.
+ */
+void checker::_forget_notifiers() {
+  if (!_to_forget.empty()) {
+    std::unordered_set<notifier*> forgotten(_to_forget.begin(),
+                                            _to_forget.end());
+    for (timeout_wheel& w : _in_flight)
+      w.remove(forgotten);
+    _to_forget.clear();
+
+    if (!_forgotten.empty()) {
+      check_result_pool& pool(check_result_pool::instance());
+      _waiting_check_result.erase_if([this, &pool](check_result* result) {
+        if (_forgotten.find(result->get_notifier_generation()) ==
+            _forgotten.end())
+          return false;
+        _release(result);
+        pool.put(result);
+        return true;
+      });
+    }
+  }
+}
+
+/**
+ *  Tag a check result entering the checker with the generation of its
+ *  notifier, and count it on the notifier.
+ *
+ *  @param[in] result  The check result.
+ */
+void checker::_hold(check_result* result) noexcept {
+  notifier* n = result->get_notifier();
+  result->set_notifier_generation(n->get_generation());
+  n->inc_pending_check_results();
+}
+
+/**
+ *  Account a check result leaving the checker. A destroyed notifier is
+ *  found by the generation of the result, its pointer is not used.
+ *
+ *  @param[in] result  The check result.
+ *
+ *  @return false if the notifier of the result was destroyed.
+ */
+bool checker::_release(check_result* result) noexcept {
+  if (!_forgotten.empty()) {
+    auto it = _forgotten.find(result->get_notifier_generation());
+    if (it != _forgotten.end()) {
+      if (--it->second == 0)
+        _forgotten.erase(it);
+      return false;
+    }
+  }
+  result->get_notifier()->dec_pending_check_results();
+  return true;
+}
+
+/**
+ *  Push a chain of check results on the reap stack, without lock.
+ *
+ *  @param[in] first  The first result of the chain, pushed first.
+ *  @param[in] last   The last one: the results are linked from last to
+ *                    first, first being linked to nothing yet.
+ */
+void checker::_push_to_reap(check_result* first, check_result* last) noexcept {
+  check_result* head = _to_reap_partial.load(std::memory_order_relaxed);
+  do
+    first->set_next(head);
+  while (!_to_reap_partial.compare_exchange_weak(
+      head, last, std::memory_order_release, std::memory_order_relaxed));
+}
+
 /**
  *  Default constructor.
  */
-checker::checker() : commands::command_listener() {}
+checker::checker()
+    : commands::command_listener(),
+      _to_reap_partial{nullptr},
+      _to_reap_first{nullptr},
+      _to_reap_last{nullptr} {}
 
 /**
  *  Default destructor.
@@ -357,16 +460,13 @@ void checker::finished(commands::result const& res) noexcept {
   logger(dbg_functions, basic) << "checker::finished: res=" << &res;
 
   std::unique_lock<std::mutex> lock(_mut_reap);
-  auto it_id = _waiting_check_result.find(res.command_id);
-  if (it_id == _waiting_check_result.end()) {
+  // Find check result.
+  check_result* result = _waiting_check_result.take(res.command_id);
+  if (!result) {
     logger(log_runtime_warning, basic)
         << "command ID '" << res.command_id << "' not found";
     return;
   }
-
-  // Find check result.
-  check_result* result = it_id->second;
-  _waiting_check_result.erase(it_id);
   lock.unlock();
 
   // Update check result.
@@ -381,8 +481,7 @@ void checker::finished(commands::result const& res) noexcept {
   result->set_output(res.output);
 
   // Queue check result.
-  lock.lock();
-  _to_reap_partial.push_back(result);
+  _push_to_reap(result, result);
 }
 
 /**
@@ -426,8 +525,7 @@ com::centreon::engine::host::host_state checker::_execute_sync(host* hst) {
   nagios_macros* macros(get_global_macros());
   grab_host_macros_r(macros, hst);
   std::string tmp;
-  get_raw_command_line_r(macros, hst->get_check_command_ptr(),
-                         hst->get_check_command().c_str(), tmp, 0);
+  get_check_command_line_r(macros, hst, tmp, 0);
 
   // Time to start command.
   gettimeofday(&start_time, nullptr);
@@ -530,6 +628,7 @@ com::centreon::engine::host::host_state checker::_execute_sync(host* hst) {
 
   // Update values.
   hst->set_execution_time(execution_time);
+  exec_time_estimator::instance().add(*hst, execution_time);
   hst->set_check_type(checkable::check_active);
 
   // Get plugin output.
@@ -595,11 +694,66 @@ com::centreon::engine::host::host_state checker::_execute_sync(host* hst) {
  *
  * @param id A command id
  * @param check_result A check_result coming from a service or a host.
+ * @param deadline Time after which the check is orphaned if its command did
+ * not finish.
  */
 void checker::add_check_result(uint64_t id,
-                               check_result* check_result) noexcept {
+                               check_result* check_result,
+                               time_t deadline) noexcept {
+  _hold(check_result);
+  std::lock_guard<std::mutex> lock(_mut_reap);
+  _waiting_check_result.insert(id, check_result);
+  _in_flight[check_result->get_object_check_type()].add(
+      deadline, id, check_result->get_notifier());
+}
+
+/**
+ * @brief Watch a check whose result is given by a broker module: it is
+ * orphaned if the object is still executing it after the deadline, the
+ * check sequence of the object tells if a later check was started.
+ *
+ * @param source Type of the object checked.
+ * @param n The host or service.
+ * @param deadline Time after which the check is orphaned.
+ */
+void checker::add_check_without_command(check_source source,
+                                        notifier* n,
+                                        time_t deadline) noexcept {
   std::lock_guard<std::mutex> lock(_mut_reap);
-  _waiting_check_result[id] = check_result;
+  _in_flight[source].add(deadline, 0, n, n->get_check_sequence());
+}
+
+/**
+ * @brief Get the checks of a type whose deadline is reached without result.
+ * Their check results are removed, a result coming later is ignored.
+ *
+ * @param source Type of the objects checked.
+ * @param now Current time.
+ *
+ * @return The hosts or services whose check is orphaned.
+ */
+std::vector<engine::notifier*> checker::get_orphaned_checks(
+    check_source source,
+    time_t now) {
+  std::vector<engine::notifier*> retval;
+  std::lock_guard<std::mutex> lock(_mut_reap);
+  _forget_notifiers();
+  for (timeout_wheel::entry const& e : _in_flight[source].expire(now)) {
+    if (e.command_id) {
+      check_result* result = _waiting_check_result.take(e.command_id);
+      /* The command finished in time. */
+      if (!result)
+        continue;
+      bool alive = _release(result);
+      check_result_pool::instance().put(result);
+      if (alive)
+        retval.push_back(e.n);
+    } else if (e.n->get_is_executing() &&
+               e.n->get_check_sequence() == e.check_sequence)
+      /* The same check is still executing, not a later one. */
+      retval.push_back(e.n);
+  }
+  return retval;
 }
 
 /**
@@ -609,19 +763,76 @@ void checker::add_check_result(uint64_t id,
  * @param check_result The check_result already finished.
  */
 void checker::add_check_result_to_reap(check_result* check_result) noexcept {
+  _hold(check_result);
+  _push_to_reap(check_result, check_result);
+}
+
+/**
+ * @brief Add several check results to reap at once, they are pushed as a
+ * single chain.
+ *
+ * @param results The check results, in the order they have to be reaped.
+ */
+void checker::add_check_results_to_reap(
+    std::vector<check_result*> const& results) noexcept {
+  if (results.empty())
+    return;
+  _hold(results[0]);
+  for (size_t i = 1; i < results.size(); ++i) {
+    _hold(results[i]);
+    results[i]->set_next(results[i - 1]);
+  }
+  _push_to_reap(results.front(), results.back());
+}
+
+/**
+ * @brief Count the check results waiting for their command and the ones
+ * waiting to be reaped, with the memory they use and the one of the free
+ * check results kept by the pool.
+ *
+ * @param waiting Number of check results with a running command.
+ * @param to_reap Number of check results to reap.
+ * @param bytes Memory used by all these check results.
+ */
+void checker::get_check_results_usage(uint64_t& waiting,
+                                      uint64_t& to_reap,
+                                      uint64_t& bytes) {
   std::lock_guard<std::mutex> lock(_mut_reap);
-  _to_reap_partial.push_back(check_result);
+  waiting = _waiting_check_result.size();
+  to_reap = 0;
+  bytes = 0;
+  _waiting_check_result.for_each([&bytes](check_result const* cr) {
+    bytes += memory_stats::string_size(cr->get_output());
+  });
+  /* Results below the top of the stack are only unlinked by reap(), called
+   * from the main loop as this method. */
+  for (check_result const* cr =
+           _to_reap_partial.load(std::memory_order_acquire);
+       cr; cr = cr->get_next()) {
+    ++to_reap;
+    bytes += memory_stats::string_size(cr->get_output());
+  }
+  for (check_result const* cr = _to_reap_first; cr; cr = cr->get_next()) {
+    ++to_reap;
+    bytes += memory_stats::string_size(cr->get_output());
+  }
+  bytes += (waiting + to_reap) * sizeof(check_result);
+  bytes += check_result_pool::instance().free_bytes();
 }
 
 /**
  * @brief Notifiers added here will be removed from current checks. This task
  * is necessary because the user could remove a service or a host while a check
- * is made on it.
+ * is made on it. Its check results still held are dropped when they leave the
+ * checker.
  *
  * @param n The notifier to forget.
  */
 void checker::forget(notifier* n) noexcept {
   if (_instance) {
+    if (n->get_pending_check_results())
+      _instance->_forgotten[n->get_generation()] =
+          n->get_pending_check_results();
     std::lock_guard<std::mutex> lock(_instance->_mut_reap);
     _instance->_to_forget.push_back(n);
   }
@@ -0,0 +1,83 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/checks/exec_time_estimator.hh"
+#include "com/centreon/engine/checkable.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::checks;
+
+constexpr double exec_time_estimator::weight;
+constexpr double exec_time_estimator::default_estimate;
+
+/**
+ *  Get instance of the exec_time_estimator singleton.
+ *
+ *  @return Class instance.
+ */
+exec_time_estimator& exec_time_estimator::instance() {
+  static exec_time_estimator instance;
+  return instance;
+}
+
+/**
+ *  Account the execution time of an active check.
+ *
+ *  @param[in,out] c               Host or service checked.
+ *  @param[in]     execution_time  Execution time in seconds.
+ */
+void exec_time_estimator::add(checkable& c, double execution_time) {
+  if (execution_time < 0)
+    execution_time = 0;
+
+  double current(c.get_execution_time_estimate());
+  c.set_execution_time_estimate(
+      current < 0 ? execution_time
+                  : current + weight * (execution_time - current));
+
+  if (!c.get_check_command_name().empty()) {
+    auto it(_by_command.find(c.get_check_command_name()));
+    if (it == _by_command.end())
+      _by_command.emplace(c.get_check_command_name(), execution_time);
+    else
+      it->second += weight * (execution_time - it->second);
+  }
+}
+
+/**
+ *  Get the expected execution time of the next check of an object.
+ *
+ *  @param[in] c  Host or service.
+ *
+ *  @return A duration in seconds.
+ */
+double exec_time_estimator::estimate(checkable const& c) const {
+  double retval(c.get_execution_time_estimate());
+  if (retval >= 0)
+    return retval;
+
+  auto it(_by_command.find(c.get_check_command_name()));
+  if (it != _by_command.end())
+    return it->second;
+
+  /* The execution time restored from the retention file. */
+  if (c.has_been_checked())
+    return c.get_execution_time();
+  return default_estimate;
+}
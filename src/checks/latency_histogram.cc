@@ -0,0 +1,100 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/checks/latency_histogram.hh"
+#include <cmath>
+
+using namespace com::centreon::engine::checks;
+
+constexpr std::array<double, 12> latency_histogram::bounds;
+
+/**
+ *  Constructor.
+ */
+latency_histogram::latency_histogram() {
+  reset();
+}
+
+/**
+ *  Account the latency of one check.
+ *
+ *  @param[in] latency  Delay between the expected and the real start of
+ *                      the check, in seconds.
+ */
+void latency_histogram::add(double latency) noexcept {
+  if (latency < 0)
+    latency = 0;
+  size_t idx = 0;
+  while (idx < bounds.size() && latency > bounds[idx])
+    ++idx;
+  ++_buckets[idx];
+  ++_count;
+  if (latency > _max)
+    _max = latency;
+}
+
+/**
+ *  Get the number of latencies accounted.
+ *
+ *  @return A count of checks.
+ */
+uint64_t latency_histogram::count() const noexcept {
+  return _count;
+}
+
+/**
+ *  Get the largest latency accounted.
+ *
+ *  @return A latency in seconds.
+ */
+double latency_histogram::max() const noexcept {
+  return _max;
+}
+
+/**
+ *  Get a percentile of the latencies.
+ *
+ *  @param[in] p  The percentile, between 0 and 100.
+ *
+ *  @return The latency (in seconds) that p percents of the checks did not
+ *          exceed, 0 if there is no check.
+ */
+double latency_histogram::percentile(double p) const noexcept {
+  if (!_count)
+    return 0;
+  uint64_t rank = static_cast<uint64_t>(std::ceil(p * _count / 100));
+  if (rank < 1)
+    rank = 1;
+  uint64_t seen = 0;
+  for (size_t i = 0; i < bounds.size(); ++i) {
+    seen += _buckets[i];
+    if (seen >= rank)
+      return bounds[i] < _max ? bounds[i] : _max;
+  }
+  return _max;
+}
+
+/**
+ *  Forget all the latencies.
+ */
+void latency_histogram::reset() noexcept {
+  _buckets.fill(0);
+  _count = 0;
+  _max = 0;
+}
@@ -0,0 +1,128 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/checks/timeout_wheel.hh"
+#include <algorithm>
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::checks;
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] slots  Number of one-second slots.
+ */
+timeout_wheel::timeout_wheel(size_t slots)
+    : _slots(slots), _now{0}, _size{0} {}
+
+/**
+ *  Add a check deadline.
+ *
+ *  @param[in] deadline    Time after which the check is orphaned.
+ *  @param[in] command_id  Id of the check command, 0 if there is none.
+ *  @param[in] n           Host or service checked.
+ *  @param[in] check_sequence  Check sequence of n for a check without
+ *                             command.
+ */
+void timeout_wheel::add(std::time_t deadline,
+                        uint64_t command_id,
+                        notifier* n,
+                        uint32_t check_sequence) {
+  /* A deadline already passed goes into the next visited slot. */
+  std::time_t slot_time{std::max(deadline, _now + 1)};
+  _slots[slot_time % _slots.size()].push_back(
+      {deadline, command_id, n, check_sequence});
+  ++_size;
+}
+
+/**
+ *  Remove all the entries.
+ */
+void timeout_wheel::clear() noexcept {
+  for (std::vector<entry>& slot : _slots)
+    slot.clear();
+  _size = 0;
+}
+
+/**
+ *  Remove the entries whose deadline is reached.
+ *
+ *  @param[in] now  Current time.
+ *
+ *  @return The removed entries.
+ */
+std::vector<timeout_wheel::entry> timeout_wheel::expire(std::time_t now) {
+  std::vector<entry> retval;
+  if (_size) {
+    /* All the slots are visited on the first call, after a long time or
+     * when the clock went back. */
+    if (!_now || now < _now ||
+        static_cast<size_t>(now - _now) >= _slots.size()) {
+      for (std::vector<entry>& slot : _slots)
+        _expire_slot(slot, now, retval);
+    } else {
+      for (std::time_t t{_now + 1}; t <= now; ++t)
+        _expire_slot(_slots[t % _slots.size()], now, retval);
+    }
+  }
+  _now = now;
+  return retval;
+}
+
+/**
+ *  Remove the entries of hosts and services that are destroyed.
+ *
+ *  @param[in] notifiers  The hosts and services.
+ */
+void timeout_wheel::remove(
+    std::unordered_set<notifier*> const& notifiers) noexcept {
+  for (std::vector<entry>& slot : _slots) {
+    auto end = std::remove_if(
+        slot.begin(), slot.end(),
+        [&notifiers](entry const& e) { return notifiers.count(e.n); });
+    _size -= slot.end() - end;
+    slot.erase(end, slot.end());
+  }
+}
+
+/**
+ *  Get the number of entries, expired or not.
+ *
+ *  @return The number of entries.
+ */
+size_t timeout_wheel::size() const noexcept {
+  return _size;
+}
+
+/**
+ *  Move the entries of a slot whose deadline is reached.
+ *
+ *  @param[in,out] slot     The slot.
+ *  @param[in]     now      Current time.
+ *  @param[out]    expired  Where entries are moved.
+ */
+void timeout_wheel::_expire_slot(std::vector<entry>& slot,
+                                 std::time_t now,
+                                 std::vector<entry>& expired) {
+  auto end = std::partition(slot.begin(), slot.end(),
+                            [now](entry const& e) { return e.deadline > now; });
+  expired.insert(expired.end(), end, slot.end());
+  _size -= slot.end() - end;
+  slot.erase(end, slot.end());
+}
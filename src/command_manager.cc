@@ -23,11 +23,16 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include "com/centreon/engine/broker/callback_stats.hh"
+#include "com/centreon/engine/checks/check_result_pool.hh"
 #include "com/centreon/engine/checks/checker.hh"
 #include "com/centreon/engine/comment.hh"
 #include "com/centreon/engine/downtimes/downtime_manager.hh"
+#include "com/centreon/engine/events/loop.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/memory_stats.hh"
+#include "com/centreon/engine/profiler.hh"
 
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::logging;
@@ -81,8 +86,6 @@ int command_manager::process_passive_service_check(
     const std::string& svc_description,
     uint32_t return_code,
     const std::string& output) {
-  const std::string* real_host_name = nullptr;
-
   /* skip this service check result if we aren't accepting passive service
    * checks */
   if (!config->accept_passive_service_checks())
@@ -93,22 +96,10 @@ int command_manager::process_passive_service_check(
     return ERROR;
 
   /* find the host by its name or address */
-  host_map::const_iterator it(host::hosts.find(host_name));
-  if (it != host::hosts.end() && it->second)
-    real_host_name = &host_name;
-  else {
-    for (host_map::iterator itt(host::hosts.begin()), end(host::hosts.end());
-         itt != end; ++itt) {
-      if (itt->second && itt->second->get_address() == host_name) {
-        real_host_name = &itt->first;
-        it = itt;
-        break;
-      }
-    }
-  }
+  host* hst(find_host_by_name_or_address(host_name));
 
   /* we couldn't find the host */
-  if (real_host_name == nullptr) {
+  if (!hst) {
     logger(log_runtime_warning, basic)
         << "Warning:  Passive check result was received for service '"
         << svc_description << "' on host '" << host_name
@@ -118,7 +109,7 @@ int command_manager::process_passive_service_check(
 
   /* make sure the service exists */
   service_map::const_iterator found(
-      service::services.find({*real_host_name, svc_description}));
+      service::services.find({hst->get_name(), svc_description}));
   if (found == service::services.end() || !found->second) {
     logger(log_runtime_warning, basic)
         << "Warning:  Passive check result was received for service '"
@@ -136,12 +127,12 @@ int command_manager::process_passive_service_check(
 
   timeval set_tv = {.tv_sec = check_time, .tv_usec = 0};
 
-  check_result* result =
-      new check_result(service_check, found->second.get(),
-                       checkable::check_passive, CHECK_OPTION_NONE, false,
-                       static_cast<double>(tv.tv_sec - check_time) +
-                           static_cast<double>(tv.tv_usec) / 1000000.0,
-                       set_tv, set_tv, false, true, return_code, output);
+  check_result* result = checks::check_result_pool::instance().get(
+      service_check, found->second.get(), checkable::check_passive,
+      CHECK_OPTION_NONE, false,
+      static_cast<double>(tv.tv_sec - check_time) +
+          static_cast<double>(tv.tv_usec) / 1000000.0,
+      set_tv, set_tv, false, true, return_code, output);
 
   /* make sure the return code is within bounds */
   if (result->get_return_code() < 0 || result->get_return_code() > 3)
@@ -159,8 +150,6 @@ int command_manager::process_passive_host_check(time_t check_time,
                                                 const std::string& host_name,
                                                 uint32_t return_code,
                                                 const std::string& output) {
-  const std::string* real_host_name = nullptr;
-
   /* skip this host check result if we aren't accepting passive host checks */
   if (!config->accept_passive_service_checks())
     return ERROR;
@@ -170,22 +159,10 @@ int command_manager::process_passive_host_check(time_t check_time,
     return ERROR;
 
   /* find the host by its name or address */
-  host_map::const_iterator it(host::hosts.find(host_name));
-  if (it != host::hosts.end() && it->second)
-    real_host_name = &host_name;
-  else {
-    for (host_map::iterator itt(host::hosts.begin()), end(host::hosts.end());
-         itt != end; ++itt) {
-      if (itt->second && itt->second->get_address() == host_name) {
-        real_host_name = &itt->first;
-        it = itt;
-        break;
-      }
-    }
-  }
+  host* hst(find_host_by_name_or_address(host_name));
 
   /* we couldn't find the host */
-  if (real_host_name == nullptr) {
+  if (!hst) {
     logger(log_runtime_warning, basic)
         << "Warning:  Passive check result was received for host '" << host_name
         << "', but the host could not be found!";
@@ -193,7 +170,7 @@ int command_manager::process_passive_host_check(time_t check_time,
   }
 
   /* skip this is we aren't accepting passive checks for this host */
-  if (!it->second->get_accept_passive_checks())
+  if (!hst->get_accept_passive_checks())
     return ERROR;
 
   timeval tv;
@@ -202,12 +179,11 @@ int command_manager::process_passive_host_check(time_t check_time,
   tv_start.tv_sec = check_time;
   tv_start.tv_usec = 0;
 
-  check_result* result =
-      new check_result(host_check, it->second.get(), checkable::check_passive,
-                       CHECK_OPTION_NONE, false,
-                       static_cast<double>(tv.tv_sec - check_time) +
-                           static_cast<double>(tv.tv_usec) / 1000000.0,
-                       tv_start, tv_start, false, true, return_code, output);
+  check_result* result = checks::check_result_pool::instance().get(
+      host_check, hst, checkable::check_passive, CHECK_OPTION_NONE, false,
+      static_cast<double>(tv.tv_sec - check_time) +
+          static_cast<double>(tv.tv_usec) / 1000000.0,
+      tv_start, tv_start, false, true, return_code, output);
 
   /* make sure the return code is within bounds */
   if (result->get_return_code() < 0 || result->get_return_code() > 3)
@@ -220,6 +196,141 @@ int command_manager::process_passive_host_check(time_t check_time,
   return OK;
 }
 
+/**
+ * @brief Check one passive check result of a batch and, if it is valid,
+ * create the check_result to reap.
+ *
+ * @param r The result received from gRPC.
+ * @param now The batch reception time, used to compute the latency.
+ * @param results The check results to reap, filled by this function.
+ *
+ * @return The status of the result.
+ */
+static CheckResultsStatus::Status passive_check_result(
+    CheckResult const& r,
+    timeval const& now,
+    std::vector<check_result*>& results) {
+  time_t check_time(
+      google::protobuf::util::TimeUtil::TimestampToSeconds(r.check_time()));
+  timeval tv_start{check_time, 0};
+  double latency(static_cast<double>(now.tv_sec - check_time) +
+                 static_cast<double>(now.tv_usec) / 1000000.0);
+  if (latency < 0.0)
+    latency = 0.0;
+
+  /* host check result */
+  if (r.service_identifier_case() ==
+      CheckResult::SERVICE_IDENTIFIER_NOT_SET) {
+    if (r.code() > 2)
+      return CheckResultsStatus::INVALID;
+    if (!config->accept_passive_host_checks())
+      return CheckResultsStatus::REFUSED;
+
+    host* hst(nullptr);
+    if (r.host_identifier_case() == CheckResult::kHostName)
+      hst = find_host_by_name_or_address(r.host_name());
+    else if (r.host_identifier_case() == CheckResult::kHostId) {
+      host_id_map::const_iterator it(host::hosts_by_id.find(r.host_id()));
+      if (it != host::hosts_by_id.end())
+        hst = it->second.get();
+    } else
+      return CheckResultsStatus::INVALID;
+    if (!hst)
+      return CheckResultsStatus::NOT_FOUND;
+    if (!hst->get_accept_passive_checks())
+      return CheckResultsStatus::REFUSED;
+
+    results.push_back(checks::check_result_pool::instance().get(
+        host_check, hst, checkable::check_passive, CHECK_OPTION_NONE, false,
+        latency, tv_start, tv_start, false, true, r.code(), r.output()));
+    return CheckResultsStatus::ACCEPTED;
+  }
+
+  /* service check result */
+  if (r.code() > 3)
+    return CheckResultsStatus::INVALID;
+  if (!config->accept_passive_service_checks())
+    return CheckResultsStatus::REFUSED;
+
+  service* svc(nullptr);
+  if (r.host_identifier_case() == CheckResult::kHostName &&
+      r.service_identifier_case() == CheckResult::kSvcDesc) {
+    host* hst(find_host_by_name_or_address(r.host_name()));
+    if (!hst)
+      return CheckResultsStatus::NOT_FOUND;
+    service_map::const_iterator it(
+        service::services.find({hst->get_name(), r.svc_desc()}));
+    if (it != service::services.end())
+      svc = it->second.get();
+  } else if (r.host_identifier_case() == CheckResult::kHostId &&
+             r.service_identifier_case() == CheckResult::kServiceId) {
+    service_id_map::const_iterator it(
+        service::services_by_id.find({r.host_id(), r.service_id()}));
+    if (it != service::services_by_id.end())
+      svc = it->second.get();
+  } else
+    return CheckResultsStatus::INVALID;
+  if (!svc)
+    return CheckResultsStatus::NOT_FOUND;
+  if (!svc->get_accept_passive_checks())
+    return CheckResultsStatus::REFUSED;
+
+  results.push_back(checks::check_result_pool::instance().get(
+      service_check, svc, checkable::check_passive, CHECK_OPTION_NONE, false,
+      latency, tv_start, tv_start, false, true, r.code(), r.output()));
+  return CheckResultsStatus::ACCEPTED;
+}
+
+/**
+ * @brief Apply a batch of passive check results received by the
+ * ProcessCheckResults gRPC call. Results are checked in one pass and the
+ * valid ones are given to the checker at once.
+ *
+ * @param batch The check results.
+ * @param response One status per result is appended to it.
+ *
+ * @return OK.
+ */
+int command_manager::process_passive_check_results(
+    CheckResultBatch const& batch,
+    CheckResultsStatus* response) {
+  timeval now;
+  gettimeofday(&now, nullptr);
+
+  std::vector<check_result*> results;
+  results.reserve(batch.results_size());
+  uint32_t accepted(0);
+  for (CheckResult const& r : batch.results()) {
+    CheckResultsStatus::Status status(passive_check_result(r, now, results));
+    if (status == CheckResultsStatus::ACCEPTED)
+      ++accepted;
+    else
+      logger(log_runtime_warning, more)
+          << "Warning: Passive check result for host '"
+          << (r.host_identifier_case() == CheckResult::kHostId
+                  ? std::to_string(r.host_id())
+                  : r.host_name())
+          << "' rejected: " << CheckResultsStatus::Status_Name(status);
+    response->add_statuses(status);
+  }
+  response->set_accepted(response->accepted() + accepted);
+  response->set_rejected(response->rejected() + batch.results_size() -
+                         accepted);
+
+  checks::checker::instance().add_check_results_to_reap(results);
+  return OK;
+}
+
+/**
+ * @brief Get the number of commands waiting for the main loop.
+ *
+ * @return The queue size.
+ */
+size_t command_manager::queue_size() {
+  std::lock_guard<std::mutex> lock(_queue_m);
+  return _queue.size();
+}
+
 int command_manager::get_stats(std::string const& request, Stats* response) {
   if (request == "default") {
     response->mutable_program_status()->set_modified_host_attributes(
@@ -362,6 +473,9 @@ int command_manager::get_stats(std::string const& request, Stats* response) {
         host::hosts.size());
     get_services_stats(response->mutable_services_stats());
     get_hosts_stats(response->mutable_hosts_stats());
+    get_neb_callbacks_stats(response);
+    get_memory_stats(response);
+    get_profile_stats(response);
   } else if (request == "start")
     return get_restart_stats(response->mutable_restart_status());
   return 0;
@@ -606,8 +720,15 @@ int command_manager::get_services_stats(ServicesStats* sstats) {
   sstats->set_critical(critical);
   sstats->set_unknown(unknown);
 
+  checks::latency_histogram const& latency(
+      events::loop::instance().check_latency(service_check));
+  sstats->mutable_active_services()->set_latency_p50(latency.percentile(50));
+  sstats->mutable_active_services()->set_latency_p90(latency.percentile(90));
+  sstats->mutable_active_services()->set_latency_p99(latency.percentile(99));
+
   sstats->set_flapping(flapping);
   sstats->set_downtime(downtime);
+  sstats->set_waiting_checks(events::loop::instance().waiting_checks_count());
   return 0;
 }
 
@@ -812,11 +933,89 @@ int command_manager::get_hosts_stats(HostsStats* hstats) {
   hstats->set_down(down);
   hstats->set_unreachable(unreachable);
 
+  checks::latency_histogram const& latency(
+      events::loop::instance().check_latency(host_check));
+  hstats->mutable_active_hosts()->set_latency_p50(latency.percentile(50));
+  hstats->mutable_active_hosts()->set_latency_p90(latency.percentile(90));
+  hstats->mutable_active_hosts()->set_latency_p99(latency.percentile(99));
+
   hstats->set_flapping(flapping);
   hstats->set_downtime(downtime);
   return 0;
 }
 
+/**
+ * @brief Fill the response with the latency statistics of the callbacks
+ * registered by the broker modules.
+ *
+ * @param response The Stats message to complete.
+ *
+ * @return 0.
+ */
+int command_manager::get_neb_callbacks_stats(Stats* response) {
+  using com::centreon::engine::broker::callback_stat;
+  using com::centreon::engine::broker::callback_stats;
+  for (callback_stat const* s : callback_stats::instance().get_stats()) {
+    NebCallbackStats* cb = response->add_neb_callbacks();
+    cb->set_module(s->module);
+    cb->set_callback_type(callback_stats::callback_type_name(s->callback_type));
+    cb->set_calls(s->calls.load());
+    *cb->mutable_total_time() =
+        ::google::protobuf::util::TimeUtil::NanosecondsToDuration(
+            s->total_ns.load());
+    *cb->mutable_max_time() =
+        ::google::protobuf::util::TimeUtil::NanosecondsToDuration(
+            s->max_ns.load());
+    for (std::atomic<uint64_t> const& b : s->histogram)
+      cb->add_histogram(b.load());
+  }
+  return 0;
+}
+
+/**
+ * @brief Fill the response with the memory used by each subsystem.
+ *
+ * @param response The Stats message to complete.
+ *
+ * @return 0.
+ */
+int command_manager::get_memory_stats(Stats* response) {
+  for (memory_stats::usage const& u : memory_stats::get_usage()) {
+    MemoryStats* m = response->add_memory();
+    m->set_subsystem(u.subsystem);
+    m->set_objects(u.objects);
+    m->set_bytes(u.bytes);
+  }
+  return 0;
+}
+
+/**
+ * @brief Fill the response with the time spent in each engine phase since the
+ * profiling was enabled.
+ *
+ * @param response The Stats message to complete.
+ *
+ * @return 0.
+ */
+int command_manager::get_profile_stats(Stats* response) {
+  response->set_profiling_enabled(profiler::enabled());
+  auto stats(profiler::get_stats());
+  for (size_t i = 0; i < stats.size(); ++i) {
+    PhaseStats* p = response->add_profile();
+    p->set_phase(profiler::phase_name(static_cast<profiler::phase>(i)));
+    p->set_calls(stats[i].calls);
+    *p->mutable_total_time() =
+        ::google::protobuf::util::TimeUtil::NanosecondsToDuration(
+            stats[i].total_ns);
+    *p->mutable_max_time() =
+        ::google::protobuf::util::TimeUtil::NanosecondsToDuration(
+            stats[i].max_ns);
+    for (uint64_t b : stats[i].histogram)
+      p->add_histogram(b);
+  }
+  return 0;
+}
+
 int command_manager::get_restart_stats(RestartStats* response) {
   *response->mutable_apply_start() =
       ::google::protobuf::util::TimeUtil::TimeTToTimestamp(
@@ -23,6 +23,7 @@
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/profiler.hh"
 
 using namespace com::centreon;
 using namespace com::centreon::engine;
@@ -80,6 +81,7 @@ uint64_t raw::run(std::string const& processed_cmd,
                   uint32_t timeout) {
   logger(dbg_commands, basic)
       << "raw::run: cmd='" << processed_cmd << "', timeout=" << timeout;
+  profiler::scope timer{profiler::command_spawn};
 
   // Get process and put into the busy list.
   process* p;
@@ -19,12 +19,16 @@
 */
 
 #include "com/centreon/engine/comment.hh"
+#include <algorithm>
+#include <vector>
 #include "com/centreon/engine/broker.hh"
 
 using namespace com::centreon::engine;
 
 comment_map comment::comments;
 uint64_t comment::_next_comment_id = 1LLU;
+std::unordered_multimap<std::pair<uint64_t, uint64_t>, uint64_t, pair_hash>
+    comment::_comments_by_object;
 
 uint64_t comment::get_next_comment_id() {
   return _next_comment_id;
@@ -86,6 +90,25 @@ comment::comment(comment::type comment_type,
   }
 }
 
+/**
+ *  Add a comment to the comments and to the object index.
+ *
+ *  @param[in] com  The comment.
+ */
+void comment::insert_comment(std::shared_ptr<comment> const& com) {
+  if (comments.insert({com->get_comment_id(), com}).second)
+    _comments_by_object.insert(
+        {{com->get_host_id(), com->get_service_id()}, com->get_comment_id()});
+}
+
+/**
+ *  Remove all the comments without notifying the broker.
+ */
+void comment::clear_comments() {
+  comments.clear();
+  _comments_by_object.clear();
+}
+
 /* deletes a host or service comment */
 bool comment::delete_comment(uint64_t comment_id) {
   comment_map::iterator found = comment::comments.find(comment_id);
@@ -102,102 +125,77 @@ bool comment::delete_comment(uint64_t comment_id) {
         found->second->get_persistent(), found->second->get_source(),
         found->second->get_expires(), found->second->get_expire_time(),
         comment_id, nullptr);
-    comment::comments.erase(comment_id);
+    auto range(_comments_by_object.equal_range(
+        {found->second->get_host_id(), found->second->get_service_id()}));
+    for (auto it(range.first); it != range.second; ++it)
+      if (it->second == comment_id) {
+        _comments_by_object.erase(it);
+        break;
+      }
+    comment::comments.erase(found);
     return true;
   } 
   else  { return false; }
 }
 
-void comment::delete_host_comments(uint64_t host_id) {
-  comment_map::iterator it(comments.begin());
-
-  while (it != comments.end()) {
-    if (it->second->get_comment_type() == comment::host &&
-        it->second->get_host_id() == host_id) {
-      broker_comment_data(
-          NEBTYPE_COMMENT_DELETE, NEBFLAG_NONE, NEBATTR_NONE,
-          it->second->get_comment_type(), it->second->get_entry_type(),
-          host_id, 0, it->second->get_entry_time(),
-          it->second->get_author().c_str(),
-          it->second->get_comment_data().c_str(), it->second->get_persistent(),
-          it->second->get_source(), it->second->get_expires(),
-          it->second->get_expire_time(), it->first, nullptr);
-      it = comments.erase(it);
-    } else
-      it++;
+/**
+ *  Delete the comments of a host or of a service.
+ *
+ *  @param[in] comment_type  comment::host or comment::service.
+ *  @param[in] host_id       The host id.
+ *  @param[in] service_id    The service id, 0 for a host.
+ *  @param[in] filter        If not null, only the comments it accepts are
+ *                           deleted.
+ */
+void comment::delete_comments(comment::type comment_type,
+                              uint64_t host_id,
+                              uint64_t service_id,
+                              bool (*filter)(comment const&)) {
+  std::vector<uint64_t> ids;
+  auto range(_comments_by_object.equal_range({host_id, service_id}));
+  for (auto it(range.first); it != range.second; ++it) {
+    comment const& com(*comments.at(it->second));
+    if (com.get_comment_type() == comment_type && (!filter || filter(com)))
+      ids.push_back(it->second);
   }
+
+  /* Comments are deleted in the order of their ids, as before the index. */
+  std::sort(ids.begin(), ids.end());
+  for (uint64_t id : ids)
+    delete_comment(id);
+}
+
+/**
+ *  Tell if a comment is a non-persistent acknowledgement comment.
+ *
+ *  @param[in] com  The comment.
+ *
+ *  @return true if it is.
+ */
+static bool is_volatile_acknowledgement(comment const& com) {
+  return com.get_entry_type() == comment::acknowledgment &&
+         !com.get_persistent();
+}
+
+void comment::delete_host_comments(uint64_t host_id) {
+  delete_comments(comment::host, host_id, 0);
 }
 
 void comment::delete_service_comments(uint64_t host_id, uint64_t service_id) {
-  comment_map::iterator it(comments.begin());
-
-  while (it != comments.end()) {
-    if (it->second->get_comment_type() == comment::service &&
-        it->second->get_host_id() == host_id &&
-        it->second->get_service_id() == service_id) {
-      broker_comment_data(
-          NEBTYPE_COMMENT_DELETE, NEBFLAG_NONE, NEBATTR_NONE,
-          it->second->get_comment_type(), it->second->get_entry_type(),
-          host_id, service_id,
-          it->second->get_entry_time(), it->second->get_author().c_str(),
-          it->second->get_comment_data().c_str(), it->second->get_persistent(),
-          it->second->get_source(), it->second->get_expires(),
-          it->second->get_expire_time(), it->first, nullptr);
-      it = comments.erase(it);
-    } else
-      it++;
-  }
+  delete_comments(comment::service, host_id, service_id);
 }
 
 /* deletes all non-persistent acknowledgement comments for a particular host */
 void comment::delete_host_acknowledgement_comments(engine::host* hst) {
-  comment_map::iterator it(comments.begin());
-
-  while (it != comments.end()) {
-    if (it->second->get_comment_type() == comment::host &&
-        it->second->get_host_id() == hst->get_host_id() &&
-        it->second->get_entry_type() ==
-            com::centreon::engine::comment::acknowledgment &&
-        !it->second->get_persistent()) {
-      broker_comment_data(
-          NEBTYPE_COMMENT_DELETE, NEBFLAG_NONE, NEBATTR_NONE,
-          it->second->get_comment_type(), it->second->get_entry_type(),
-          it->second->get_host_id(), 0,
-          it->second->get_entry_time(), it->second->get_author().c_str(),
-          it->second->get_comment_data().c_str(), it->second->get_persistent(),
-          it->second->get_source(), it->second->get_expires(),
-          it->second->get_expire_time(), it->first, nullptr);
-      it = comments.erase(it);
-    } else
-      it++;
-  }
+  delete_comments(comment::host, hst->get_host_id(), 0,
+                  &is_volatile_acknowledgement);
 }
 
 /* deletes all non-persistent acknowledgement comments for a particular service
  */
 void comment::delete_service_acknowledgement_comments(::service* svc) {
-  comment_map::iterator it(comments.begin());
-
-  while (it != comments.end()) {
-    if (it->second->get_comment_type() == comment::service &&
-        it->second->get_host_id() == svc->get_host_id() &&
-        it->second->get_service_id() == svc->get_service_id() &&
-        it->second->get_entry_type() ==
-            com::centreon::engine::comment::acknowledgment &&
-        !it->second->get_persistent()) {
-      broker_comment_data(
-          NEBTYPE_COMMENT_DELETE, NEBFLAG_NONE, NEBATTR_NONE,
-          it->second->get_comment_type(), it->second->get_entry_type(),
-          it->second->get_host_id(),
-          it->second->get_service_id(),
-          it->second->get_entry_time(), it->second->get_author().c_str(),
-          it->second->get_comment_data().c_str(), it->second->get_persistent(),
-          it->second->get_source(), it->second->get_expires(),
-          it->second->get_expire_time(), it->first, nullptr);
-      it = comments.erase(it);
-    } else
-      it++;
-  }
+  delete_comments(comment::service, svc->get_host_id(),
+                  svc->get_service_id(), &is_volatile_acknowledgement);
 }
 
 /* checks for an expired comment (and removes it) */
@@ -417,6 +417,10 @@ void applier::anomalydetection::modify_object(configuration::anomalydetection co
     }
   }
 
+  // The status file block is rendered again, even if the anomaly detection is
+  // not rescheduled.
+  s->get_status_blocks().dirty = true;
+
   // Notify event broker.
   timeval tv(get_broker_timestamp(NULL));
   broker_adaptive_service_data(NEBTYPE_SERVICE_UPDATE, NEBFLAG_NONE,
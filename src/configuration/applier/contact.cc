@@ -362,6 +362,7 @@ void applier::contact::remove_object(configuration::contact const& obj) {
 
     for (auto& it_c: it->second->get_parent_groups())
       it_c.second->get_members().erase(obj.contact_name());
+    engine::contactgroup::members_changed();
 
     // Notify event broker.
     timeval tv(get_broker_timestamp(nullptr));
@@ -34,6 +34,20 @@ using namespace com::centreon;
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::configuration;
 
+/**
+ *  Remove a host from the address index.
+ *
+ *  @param[in] hst  The host to remove.
+ */
+static void remove_host_address(engine::host* hst) {
+  auto range(engine::host::hosts_by_address.equal_range(hst->get_address()));
+  for (auto it(range.first); it != range.second; ++it)
+    if (it->second == hst) {
+      engine::host::hosts_by_address.erase(it);
+      break;
+    }
+}
+
 /**
  *  Default constructor.
  */
@@ -98,6 +112,7 @@ void applier::host::add_object(configuration::host const& obj) {
 
   engine::host::hosts.insert({h->get_name(), h});
   engine::host::hosts_by_id.insert({obj.host_id(), h});
+  engine::host::hosts_by_address.insert({h->get_address(), h.get()});
 
   h->set_initial_notif_time(0);
   h->set_should_reschedule_current_check(false);
@@ -230,6 +245,11 @@ void applier::host::modify_object(configuration::host const& obj) {
     it_obj->second->set_alias(obj.alias());
   else
     it_obj->second->set_alias(obj.host_name());
+  if (it_obj->second->get_address() != obj.address()) {
+    remove_host_address(it_obj->second.get());
+    engine::host::hosts_by_address.insert(
+        {obj.address(), it_obj->second.get()});
+  }
   it_obj->second->set_address(obj.address());
   if (obj.check_period().empty())
     it_obj->second->set_check_period(obj.check_period());
@@ -395,6 +415,10 @@ void applier::host::modify_object(configuration::host const& obj) {
       it_obj->second->add_parent_host(*it);
   }
 
+  // The status file block is rendered again, even if the host is not
+  // rescheduled.
+  it_obj->second->get_status_blocks().dirty = true;
+
   // Notify event broker.
   timeval tv(get_broker_timestamp(nullptr));
   broker_adaptive_host_data(NEBTYPE_HOST_UPDATE, NEBFLAG_NONE, NEBATTR_NONE,
@@ -444,6 +468,7 @@ void applier::host::remove_object(configuration::host const& obj) {
                               MODATTR_ALL, &tv);
 
     // Erase host object (will effectively delete the object).
+    remove_host_address(it->second.get());
     engine::host::hosts.erase(it->second->get_name());
     engine::host::hosts_by_id.erase(it);
   }
@@ -43,13 +43,25 @@ void applier::logging::apply(state& config) {
   else if (!config.use_syslog() && _syslog)
     _del_syslog();
 
-  // Standard log file.
-  if (config.log_file() == "")
+  // Standard log file, written by the asynchronous sink if enabled.
+  if (config.log_async()) {
     _del_log_file();
-  else if (!_log || config.log_file() != _log->filename()) {
-    _add_log_file(config);
-    _del_stdout();
-    _del_stderr();
+    if (!_async || config.log_file() != _async->filename()) {
+      _add_async(config);
+      if (!config.log_file().empty()) {
+        _del_stdout();
+        _del_stderr();
+      }
+    }
+  } else {
+    _del_async();
+    if (config.log_file() == "")
+      _del_log_file();
+    else if (!_log || config.log_file() != _log->filename()) {
+      _add_log_file(config);
+      _del_stdout();
+      _del_stderr();
+    }
   }
 
   // Debug file.
@@ -77,6 +89,7 @@ applier::logging& applier::logging::instance() {
 }
 
 void applier::logging::clear() {
+  _del_async();
   _del_stdout();
   _del_stderr();
   _del_syslog();
@@ -95,11 +108,29 @@ void applier::logging::clear() {
   _add_stderr();
 }
 
+/**
+ *  Set the backend sending log events to the broker. When the asynchronous
+ *  sink is used, it sends them instead and the backend is closed.
+ *
+ *  @param[in] backend  Broker backend, nullptr before unloading modules.
+ */
+void applier::logging::set_broker_backend(
+    com::centreon::engine::logging::broker* backend) {
+  _broker = backend;
+  if (_async) {
+    _async->enable_broker(backend != nullptr);
+    if (backend)
+      backend->close();
+  }
+}
+
 /**
  *  Default constructor.
  */
 applier::logging::logging()
-    : _debug(NULL),
+    : _async(NULL),
+      _broker(NULL),
+      _debug(NULL),
       _debug_level(0),
       _debug_max_size(0),
       _debug_verbosity(0),
@@ -117,7 +148,9 @@ applier::logging::logging()
  *  @param[in] config The initial confiuration.
  */
 applier::logging::logging(state& config)
-    : _debug(NULL),
+    : _async(NULL),
+      _broker(NULL),
+      _debug(NULL),
       _debug_level(0),
       _debug_max_size(0),
       _debug_verbosity(0),
@@ -134,6 +167,7 @@ applier::logging::logging(state& config)
  *  Default destructor.
  */
 applier::logging::~logging() throw() {
+  _del_async();
   _del_stdout();
   _del_stderr();
   _del_syslog();
@@ -141,6 +175,22 @@ applier::logging::~logging() throw() {
   _del_debug();
 }
 
+/**
+ *  Add the asynchronous sink, writing the log file and sending log events
+ *  to the broker.
+ */
+void applier::logging::_add_async(state const& config) {
+  _del_async();
+  _async = new com::centreon::engine::logging::async_sink(config.log_file(),
+                                                          config.log_pid());
+  if (_broker) {
+    _async->enable_broker(true);
+    _broker->close();
+  }
+  com::centreon::logging::engine::instance().add(
+      _async, engine::logging::log_all, engine::logging::most);
+}
+
 /**
  *  Add stdout object logging.
  */
@@ -216,6 +266,19 @@ void applier::logging::_add_debug(state const& config) {
                                                  _debug_verbosity);
 }
 
+/**
+ *  Remove the asynchronous sink once its queued messages are handled.
+ */
+void applier::logging::_del_async() {
+  if (_async) {
+    com::centreon::logging::engine::instance().remove(_async);
+    delete _async;
+    _async = NULL;
+    if (_broker)
+      _broker->open();
+  }
+}
+
 /**
  *  Remove syslog object logging.
  */
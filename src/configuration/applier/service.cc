@@ -471,6 +471,10 @@ void applier::service::modify_object(configuration::service const& obj) {
     }
   }
 
+  // The status file block is rendered again, even if the service is
+  // not rescheduled.
+  s->get_status_blocks().dirty = true;
+
   // Notify event broker.
   timeval tv(get_broker_timestamp(NULL));
   broker_adaptive_service_data(NEBTYPE_SERVICE_UPDATE, NEBFLAG_NONE,
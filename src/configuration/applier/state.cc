@@ -26,6 +26,7 @@
 #include <unordered_map>
 
 #include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/checkable_state.hh"
 #include "com/centreon/engine/commands/connector.hh"
 #include "com/centreon/engine/config.hh"
 #include "com/centreon/engine/configuration/applier/anomalydetection.hh"
@@ -52,6 +53,7 @@
 #include "com/centreon/engine/logging.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/objects.hh"
+#include "com/centreon/engine/profiler.hh"
 #include "com/centreon/engine/retention/applier/state.hh"
 #include "com/centreon/engine/retention/state.hh"
 #include "com/centreon/engine/version.hh"
@@ -72,6 +74,7 @@ static bool has_already_been_loaded(false);
  *  @param[in] waiting_thread True to wait thread after calulate differencies.
  */
 void applier::state::apply(configuration::state& new_cfg) {
+  profiler::scope timer{profiler::configuration_apply};
   configuration::state save(*config);
   try {
     _processing_state = state_ready;
@@ -103,6 +106,7 @@ void applier::state::apply(configuration::state& new_cfg) {
  */
 void applier::state::apply(configuration::state& new_cfg,
                            retention::state& state) {
+  profiler::scope timer{profiler::configuration_apply};
   configuration::state save(*config);
   try {
     _processing_state = state_ready;
@@ -149,10 +153,11 @@ void applier::state::clear() {
   engine::serviceescalation::serviceescalations.clear();
   engine::host::hosts.clear();
   engine::host::hosts_by_id.clear();
+  engine::host::hosts_by_address.clear();
   engine::hostdependency::hostdependencies.clear();
   engine::hostescalation::hostescalations.clear();
   engine::timeperiod::timeperiods.clear();
-  engine::comment::comments.clear();
+  engine::comment::clear_comments();
   engine::comment::set_next_comment_id(1llu);
 
   xpddefault_cleanup_performance_data();
@@ -187,10 +192,11 @@ applier::state::~state() noexcept {
   engine::serviceescalation::serviceescalations.clear();
   engine::host::hosts.clear();
   engine::host::hosts_by_id.clear();
+  engine::host::hosts_by_address.clear();
   engine::hostdependency::hostdependencies.clear();
   engine::hostescalation::hostescalations.clear();
   engine::timeperiod::timeperiods.clear();
-  engine::comment::comments.clear();
+  engine::comment::clear_comments();
   engine::comment::set_next_comment_id(1llu);
 
   xpddefault_cleanup_performance_data();
@@ -1310,6 +1316,14 @@ void applier::state::_processing(configuration::state& new_cfg,
       }
     }
 
+    // Freshness deadlines depend on global options and retained states,
+    // they are computed again at the next sweeps.
+    if (!verify_config) {
+      time_t now(time(nullptr));
+      checkable_state_store::hosts().reset_freshness(now);
+      checkable_state_store::services().reset_freshness(now);
+    }
+
     // Timing.
     gettimeofday(tv + 3, nullptr);
 
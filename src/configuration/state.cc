@@ -97,6 +97,8 @@ std::unordered_map<std::string, state::setter_func> const state::_setters{
      SETTER(bool, enable_predictive_service_dependency_checks)},
     {"event_broker_options",
      SETTER(std::string const&, _set_event_broker_options)},
+    {"event_broker_callback_warning_threshold",
+     SETTER(unsigned int, event_broker_callback_warning_threshold)},
     {"event_handler_timeout", SETTER(unsigned int, event_handler_timeout)},
     {"execute_host_checks", SETTER(bool, execute_host_checks)},
     {"execute_service_checks", SETTER(bool, execute_service_checks)},
@@ -133,6 +135,7 @@ std::unordered_map<std::string, state::setter_func> const state::_setters{
     {"interval_length", SETTER(unsigned int, interval_length)},
     {"lock_file", SETTER(std::string const&, _set_lock_file)},
     {"log_archive_path", SETTER(std::string const&, _set_log_archive_path)},
+    {"log_async", SETTER(bool, log_async)},
     {"log_event_handlers", SETTER(bool, log_event_handlers)},
     {"log_external_commands", SETTER(bool, log_external_commands)},
     {"log_file", SETTER(std::string const&, log_file)},
@@ -279,6 +282,7 @@ static bool const default_enable_predictive_host_dependency_checks(true);
 static bool const default_enable_predictive_service_dependency_checks(true);
 static unsigned long const default_event_broker_options(
     std::numeric_limits<unsigned long>::max());
+static unsigned int const default_event_broker_callback_warning_threshold(0);
 static unsigned int const default_event_handler_timeout(30);
 static bool const default_execute_host_checks(true);
 static bool const default_execute_service_checks(true);
@@ -300,6 +304,7 @@ static std::string const default_host_perfdata_file_template(
 static std::string const default_illegal_object_chars("");
 static std::string const default_illegal_output_chars("`~$&|'\"<>");
 static unsigned int const default_interval_length(60);
+static bool const default_log_async(false);
 static bool const default_log_event_handlers(true);
 static bool const default_log_external_commands(true);
 static std::string const default_log_file(DEFAULT_LOG_FILE);
@@ -402,6 +407,8 @@ state::state()
       _enable_predictive_service_dependency_checks(
           default_enable_predictive_service_dependency_checks),
       _event_broker_options(default_event_broker_options),
+      _event_broker_callback_warning_threshold(
+          default_event_broker_callback_warning_threshold),
       _event_handler_timeout(default_event_handler_timeout),
       _execute_host_checks(default_execute_host_checks),
       _execute_service_checks(default_execute_service_checks),
@@ -420,6 +427,7 @@ state::state()
       _illegal_object_chars(default_illegal_object_chars),
       _illegal_output_chars(default_illegal_output_chars),
       _interval_length(default_interval_length),
+      _log_async(default_log_async),
       _log_event_handlers(default_log_event_handlers),
       _log_external_commands(default_log_external_commands),
       _log_file(default_log_file),
@@ -550,6 +558,8 @@ state& state::operator=(state const& right) {
     _enable_predictive_service_dependency_checks =
         right._enable_predictive_service_dependency_checks;
     _event_broker_options = right._event_broker_options;
+    _event_broker_callback_warning_threshold =
+        right._event_broker_callback_warning_threshold;
     _event_handler_timeout = right._event_handler_timeout;
     _execute_host_checks = right._execute_host_checks;
     _execute_service_checks = right._execute_service_checks;
@@ -576,6 +586,7 @@ state& state::operator=(state const& right) {
     _illegal_object_chars = right._illegal_object_chars;
     _illegal_output_chars = right._illegal_output_chars;
     _interval_length = right._interval_length;
+    _log_async = right._log_async;
     _log_event_handlers = right._log_event_handlers;
     _log_external_commands = right._log_external_commands;
     _log_file = right._log_file;
@@ -701,6 +712,8 @@ bool state::operator==(state const& right) const noexcept {
       _enable_predictive_service_dependency_checks ==
           right._enable_predictive_service_dependency_checks &&
       _event_broker_options == right._event_broker_options &&
+      _event_broker_callback_warning_threshold ==
+          right._event_broker_callback_warning_threshold &&
       _event_handler_timeout == right._event_handler_timeout &&
       _execute_host_checks == right._execute_host_checks &&
       _execute_service_checks == right._execute_service_checks &&
@@ -726,6 +739,7 @@ bool state::operator==(state const& right) const noexcept {
       _illegal_object_chars == right._illegal_object_chars &&
       _illegal_output_chars == right._illegal_output_chars &&
       _interval_length == right._interval_length &&
+      _log_async == right._log_async &&
       _log_event_handlers == right._log_event_handlers &&
       _log_external_commands == right._log_external_commands &&
       _log_file == right._log_file &&
@@ -1694,6 +1708,26 @@ void state::event_broker_options(unsigned long value) {
   _event_broker_options = value;
 }
 
+/**
+ *  Get event_broker_callback_warning_threshold value. This is the
+ *  duration in milliseconds above which a broker callback is reported
+ *  (0 disables the warning).
+ *
+ *  @return The event_broker_callback_warning_threshold value.
+ */
+unsigned int state::event_broker_callback_warning_threshold() const noexcept {
+  return _event_broker_callback_warning_threshold;
+}
+
+/**
+ *  Set event_broker_callback_warning_threshold value.
+ *
+ *  @param[in] value The new event_broker_callback_warning_threshold value.
+ */
+void state::event_broker_callback_warning_threshold(unsigned int value) {
+  _event_broker_callback_warning_threshold = value;
+}
+
 /**
  *  Get event_handler_timeout value.
  *
@@ -2225,6 +2259,24 @@ void state::interval_length(unsigned int value) {
     _interval_length = value;
 }
 
+/**
+ *  Get log_async value.
+ *
+ *  @return The log_async value.
+ */
+bool state::log_async() const noexcept {
+  return _log_async;
+}
+
+/**
+ *  Set log_async value.
+ *
+ *  @param[in] value The new log_async value.
+ */
+void state::log_async(bool value) {
+  _log_async = value;
+}
+
 /**
  *  Get log_event_handlers value.
  *
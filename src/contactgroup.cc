@@ -34,6 +34,7 @@ using namespace com::centreon::engine;
 using namespace com::centreon::engine::logging;
 
 contactgroup_map contactgroup::contactgroups;
+uint64_t contactgroup::_members_version{1};
 
 /**************************************
  *                                     *
@@ -84,7 +85,10 @@ contactgroup::~contactgroup() { _members.clear(); }
 
 std::string const& contactgroup::get_name() const { return _name; }
 
-void contactgroup::clear_members() { _members.clear(); }
+void contactgroup::clear_members() {
+  _members.clear();
+  members_changed();
+}
 
 contact_map_unsafe& contactgroup::get_members() { return _members; }
 
@@ -122,6 +126,7 @@ void contactgroup::resolve(int& w __attribute__((unused)), int& e) {
     } else
       it->second->get_parent_groups()[_name] = this;
   }
+  members_changed();
 
   /* Check for illegal characters in contact group name. */
   if (contains_illegal_object_chars(const_cast<char*>(_name.c_str()))) {
@@ -136,3 +141,41 @@ void contactgroup::resolve(int& w __attribute__((unused)), int& e) {
     throw engine_error() << "Error: Cannot resolve contact group " << _name
                          << "'";
 }
+
+/**
+ *  Version of the contact memberships. Notifiers and escalations compare
+ *  it to the one of their flattened contact lists to know if they must be
+ *  built again.
+ *
+ *  @return The current version.
+ */
+uint64_t contactgroup::get_members_version() noexcept {
+  return _members_version;
+}
+
+/**
+ *  Invalidate the flattened contact lists. To call each time a contact is
+ *  added to or removed from a contact group, a notifier or an escalation.
+ */
+void contactgroup::members_changed() noexcept {
+  ++_members_version;
+}
+
+/**
+ *  Append the members of contact groups to a list, each contact once.
+ *
+ *  @param[in]     groups    Contact groups to flatten.
+ *  @param[in,out] contacts  List to complete.
+ *  @param[in,out] seen      Contacts already in the list.
+ */
+void contactgroup::flatten(contactgroup_map_unsafe const& groups,
+                           std::vector<contact*>& contacts,
+                           std::unordered_set<contact*>& seen) {
+  for (auto const& cg : groups) {
+    if (!cg.second)
+      continue;
+    for (auto const& m : cg.second->get_members())
+      if (m.second && seen.insert(m.second).second)
+        contacts.push_back(m.second);
+  }
+}
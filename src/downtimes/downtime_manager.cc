@@ -18,6 +18,8 @@
  */
 
 #include "com/centreon/engine/downtimes/downtime_manager.hh"
+#include <algorithm>
+#include <functional>
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/downtimes/host_downtime.hh"
@@ -32,6 +34,116 @@ using namespace com::centreon::engine::configuration::applier;
 using namespace com::centreon::engine::downtimes;
 using namespace com::centreon::engine::logging;
 
+/**
+ *  Erase an entry of an index.
+ *
+ *  @param[in,out] index  The index.
+ *  @param[in]     key    The entry key.
+ *  @param[in]     value  The entry value.
+ */
+template <typename Index, typename Key, typename Value>
+static void erase_index(Index& index, Key const& key, Value const& value) {
+  auto range(index.equal_range(key));
+  for (auto it(range.first); it != range.second; ++it)
+    if (it->second == value) {
+      index.erase(it);
+      break;
+    }
+}
+
+/**
+ *  Find a downtime from its id.
+ *
+ *  @param[in] downtime_id  The downtime id.
+ *
+ *  @return An iterator to the downtime or _scheduled_downtimes.end().
+ */
+downtime_manager::downtime_map::iterator downtime_manager::_find(
+    uint64_t downtime_id) {
+  auto found(_downtimes_by_id.find(downtime_id));
+  if (found == _downtimes_by_id.end())
+    return _scheduled_downtimes.end();
+  return found->second;
+}
+
+/**
+ *  Get the key of a downtime in the pending flexible downtimes.
+ *
+ *  @param[in] dt  The downtime.
+ *
+ *  @return Its host name and service description, empty for a host
+ *          downtime.
+ */
+std::pair<std::string, std::string> downtime_manager::_object_key(
+    downtime const* dt) {
+  if (dt->get_type() == downtime::service_downtime)
+    return {dt->get_hostname(),
+            static_cast<service_downtime const*>(dt)
+                ->get_service_description()};
+  return {dt->get_hostname(), std::string()};
+}
+
+/**
+ *  Add a downtime to the scheduled downtimes and to the indexes.
+ *
+ *  @param[in] dt  The downtime.
+ */
+void downtime_manager::_insert(std::shared_ptr<downtime> const& dt) {
+  downtime_map::iterator it{
+      _scheduled_downtimes.insert({dt->get_start_time(), dt})};
+  _downtimes_by_id.insert({dt->get_downtime_id(), it});
+  _downtimes_by_host.insert({dt->get_hostname(), dt.get()});
+  if (dt->get_type() == downtime::service_downtime) {
+    service_downtime* sdt{static_cast<service_downtime*>(dt.get())};
+    _downtimes_by_service.insert(
+        {{sdt->get_hostname(), sdt->get_service_description()}, sdt});
+  }
+  if (dt->get_triggered_by())
+    _downtimes_by_trigger.insert({dt->get_triggered_by(), dt.get()});
+  else if (!dt->is_fixed() && !dt->is_in_effect())
+    _pending_flex_downtimes.insert({_object_key(dt.get()), dt.get()});
+
+  /* Too many entries of removed downtimes, the heap is rebuilt. */
+  if (_expirations.size() > 2 * _scheduled_downtimes.size() + 64) {
+    _expirations.clear();
+    for (auto const& p : _scheduled_downtimes)
+      _expirations.emplace_back(p.second->get_end_time(),
+                                p.second->get_downtime_id());
+    std::make_heap(_expirations.begin(), _expirations.end(),
+                   std::greater<expiration>());
+  } else {
+    _expirations.emplace_back(dt->get_end_time(), dt->get_downtime_id());
+    std::push_heap(_expirations.begin(), _expirations.end(),
+                   std::greater<expiration>());
+  }
+}
+
+/**
+ *  Remove a downtime from the scheduled downtimes and from the indexes.
+ *
+ *  @param[in] it  The downtime to remove.
+ *
+ *  @return An iterator to the following downtime.
+ */
+downtime_manager::downtime_map::iterator downtime_manager::_erase(
+    downtime_map::iterator it) {
+  downtime* dt{it->second.get()};
+  erase_index(_downtimes_by_id, dt->get_downtime_id(), it);
+  erase_index(_downtimes_by_host, dt->get_hostname(), dt);
+  if (dt->get_type() == downtime::service_downtime) {
+    service_downtime* sdt{static_cast<service_downtime*>(dt)};
+    erase_index(_downtimes_by_service,
+                std::make_pair(sdt->get_hostname(),
+                               sdt->get_service_description()),
+                sdt);
+  }
+  if (dt->get_triggered_by())
+    erase_index(_downtimes_by_trigger, dt->get_triggered_by(), dt);
+  else if (!dt->is_fixed())
+    erase_index(_pending_flex_downtimes, _object_key(dt), dt);
+  return _scheduled_downtimes.erase(it);
+}
+
 /**
  *  Remove a service/host downtime from its id.
  *
@@ -41,24 +153,16 @@ using namespace com::centreon::engine::logging;
  */
 void downtime_manager::delete_downtime(uint64_t downtime_id) {
   /* find the downtime we should remove */
-  for (auto it = _scheduled_downtimes.begin(), end = _scheduled_downtimes.end();
-       it != end; ++it) {
-    if (it->second->get_downtime_id() == downtime_id) {
-      logger(dbg_downtime, basic)
-          << "delete downtime(id: " << downtime_id << ")";
-      _scheduled_downtimes.erase(it);
-      break;
-    }
+  downtime_map::iterator it{_find(downtime_id)};
+  if (it != _scheduled_downtimes.end()) {
+    logger(dbg_downtime, basic) << "delete downtime(id: " << downtime_id << ")";
+    _erase(it);
   }
 }
 
 /* unschedules a host or service downtime */
 int downtime_manager::unschedule_downtime(uint64_t downtime_id) {
-  auto found = std::find_if(
-      _scheduled_downtimes.begin(), _scheduled_downtimes.end(),
-      [&downtime_id](std::pair<time_t, std::shared_ptr<downtime>> d) {
-        return downtime_id == d.second->get_downtime_id();
-      });
+  downtime_map::iterator found{_find(downtime_id)};
 
   logger(dbg_functions, basic) << "unschedule_downtime()";
   logger(dbg_downtime, basic)
@@ -75,15 +179,13 @@ int downtime_manager::unschedule_downtime(uint64_t downtime_id) {
   events::loop::instance().remove_downtime(downtime_id);
 
   /* delete downtime entry */
-  _scheduled_downtimes.erase(found);
+  _erase(found);
 
   /* unschedule all downtime entries that were triggered by this one */
   std::list<uint64_t> lst;
-  for (auto it = _scheduled_downtimes.begin(), end = _scheduled_downtimes.end();
-       it != end; ++it) {
-    if (it->second->get_triggered_by() == downtime_id)
-      lst.push_back(it->second->get_downtime_id());
-  }
+  auto range(_downtimes_by_trigger.equal_range(downtime_id));
+  for (auto it = range.first; it != range.second; ++it)
+    lst.push_back(it->second->get_downtime_id());
 
   for (uint64_t id : lst) {
     logger(dbg_downtime, basic)
@@ -97,16 +199,11 @@ int downtime_manager::unschedule_downtime(uint64_t downtime_id) {
 std::shared_ptr<downtime> downtime_manager::find_downtime(
     downtime::type type,
     uint64_t downtime_id) {
-  for (std::multimap<time_t, std::shared_ptr<downtime>>::iterator
-           it{_scheduled_downtimes.begin()},
-       end{_scheduled_downtimes.end()};
-       it != end; ++it) {
-    if (type != downtime::any_downtime && it->second->get_type() != type)
-      continue;
-    if (it->second->get_downtime_id() == downtime_id)
-      return it->second;
-  }
-  return nullptr;
+  downtime_map::iterator it{_find(downtime_id)};
+  if (it == _scheduled_downtimes.end() ||
+      (type != downtime::any_downtime && it->second->get_type() != type))
+    return nullptr;
+  return it->second;
 }
 
 /* checks for flexible (non-fixed) host downtime that should start now */
@@ -124,35 +221,32 @@ int downtime_manager::check_pending_flex_host_downtime(host* hst) {
   if (hst->get_current_state() == host::state_up)
     return OK;
 
-  /* check all downtime entries */
-  for (std::multimap<time_t, std::shared_ptr<downtime>>::iterator
-           it{_scheduled_downtimes.begin()},
-       end{_scheduled_downtimes.end()};
-       it != end; ++it) {
-    if (it->second->get_type() != downtime::host_downtime ||
-        it->second->is_fixed() || it->second->is_in_effect() ||
-        it->second->get_triggered_by() != 0)
+  /* check the pending flexible downtimes of this host, the started ones
+   * leave the index and handle() may change it */
+  std::list<uint64_t> lst;
+  auto range(
+      _pending_flex_downtimes.equal_range({hst->get_name(), std::string()}));
+  for (auto it = range.first; it != range.second;) {
+    downtime* dt{it->second};
+    /* if the time boundaries are okay, start this scheduled downtime */
+    if (!dt->is_in_effect() && dt->get_start_time() <= current_time &&
+        current_time <= dt->get_end_time()) {
+      lst.push_back(dt->get_downtime_id());
+      it = _pending_flex_downtimes.erase(it);
+    } else
+      ++it;
+  }
+
+  for (uint64_t id : lst) {
+    std::shared_ptr<downtime> dt{find_downtime(downtime::host_downtime, id)};
+    if (!dt)
       continue;
+    logger(dbg_downtime, basic)
+        << "Flexible downtime (id=" << dt->get_downtime_id() << ") for host '"
+        << hst->get_name() << "' starting now...";
 
-    /* this entry matches our host! */
-    host* temp_host(nullptr);
-    host_map::const_iterator it_hg(
-        host::hosts.find(it->second->get_hostname()));
-    if (it_hg != host::hosts.end())
-      temp_host = it_hg->second.get();
-
-    if (temp_host == hst) {
-      /* if the time boundaries are okay, start this scheduled downtime */
-      if (it->second->get_start_time() <= current_time &&
-          current_time <= it->second->get_end_time()) {
-        logger(dbg_downtime, basic)
-            << "Flexible downtime (id=" << it->second->get_downtime_id()
-            << ") for host '" << hst->get_name() << "' starting now...";
-
-        it->second->start_flex_downtime();
-        it->second->handle();
-      }
-    }
+    dt->start_flex_downtime();
+    dt->handle();
   }
   return OK;
 }
@@ -172,36 +266,33 @@ int downtime_manager::check_pending_flex_service_downtime(service* svc) {
   if (svc->get_current_state() == service::state_ok)
     return OK;
 
-  /* check all downtime entries */
-  for (std::multimap<time_t, std::shared_ptr<downtime>>::iterator
-           it{_scheduled_downtimes.begin()},
-       end{_scheduled_downtimes.end()};
-       it != end; ++it) {
-    if (it->second->get_type() != downtime::service_downtime ||
-        it->second->is_fixed() || it->second->is_in_effect() ||
-        it->second->get_triggered_by() != 0)
-      continue;
-
-    service_downtime& dt(
-        *std::static_pointer_cast<service_downtime>(it->second));
-
-    service_map::const_iterator found(service::services.find(
-        {dt.get_hostname(), dt.get_service_description()}));
+  /* check the pending flexible downtimes of this service, the started
+   * ones leave the index and handle() may change it */
+  std::list<uint64_t> lst;
+  auto range(_pending_flex_downtimes.equal_range(
+      {svc->get_hostname(), svc->get_description()}));
+  for (auto it = range.first; it != range.second;) {
+    downtime* dt{it->second};
+    /* if the time boundaries are okay, start this scheduled downtime */
+    if (!dt->is_in_effect() && dt->get_start_time() <= current_time &&
+        current_time <= dt->get_end_time()) {
+      lst.push_back(dt->get_downtime_id());
+      it = _pending_flex_downtimes.erase(it);
+    } else
+      ++it;
+  }
 
-    /* this entry matches our service! */
-    if (found != service::services.end() && found->second.get() == svc) {
-      /* if the time boundaries are okay, start this scheduled downtime */
-      if (dt.get_start_time() <= current_time &&
-          current_time <= dt.get_end_time()) {
-        logger(dbg_downtime, basic)
-            << "Flexible downtime (id=" << dt.get_downtime_id()
-            << ") for service '" << svc->get_description() << "' on host '"
-            << svc->get_hostname() << "' starting now...";
+  for (uint64_t id : lst) {
+    std::shared_ptr<downtime> dt{find_downtime(downtime::service_downtime, id)};
+    if (!dt)
+      continue;
+    logger(dbg_downtime, basic)
+        << "Flexible downtime (id=" << dt->get_downtime_id()
+        << ") for service '" << svc->get_description() << "' on host '"
+        << svc->get_hostname() << "' starting now...";
 
-        dt.start_flex_downtime();
-        dt.handle();
-      }
-    }
+    dt->start_flex_downtime();
+    dt->handle();
   }
   return OK;
 }
@@ -213,11 +304,16 @@ downtime_manager::get_scheduled_downtimes() const {
 
 void downtime_manager::clear_scheduled_downtimes() {
   _scheduled_downtimes.clear();
+  _downtimes_by_id.clear();
+  _downtimes_by_host.clear();
+  _downtimes_by_service.clear();
+  _downtimes_by_trigger.clear();
+  _pending_flex_downtimes.clear();
+  _expirations.clear();
 }
 
 void downtime_manager::add_downtime(downtime* dt) noexcept {
-  _scheduled_downtimes.insert(
-      {dt->get_start_time(), std::shared_ptr<downtime>(dt)});
+  _insert(std::shared_ptr<downtime>(dt));
 }
 
 int downtime_manager::check_for_expired_downtime() {
@@ -227,23 +323,40 @@ int downtime_manager::check_for_expired_downtime() {
 
   time(&current_time);
 
-  /* check all downtime entries... */
-  auto next_it = downtime_manager::instance()._scheduled_downtimes.begin();
-  for (auto it = _scheduled_downtimes.begin(), end = _scheduled_downtimes.end();
-       it != end; it = next_it) {
+  /* only look at downtime entries that are over... */
+  std::vector<expiration> in_effect;
+  while (!_expirations.empty() && _expirations.front().first < current_time) {
+    expiration e{_expirations.front()};
+    std::pop_heap(_expirations.begin(), _expirations.end(),
+                  std::greater<expiration>());
+    _expirations.pop_back();
+
+    /* the downtime was removed or replaced */
+    downtime_map::iterator it{_find(e.second)};
+    if (it == _scheduled_downtimes.end() ||
+        it->second->get_end_time() != e.first)
+      continue;
+
     downtime& dt(*it->second);
-    ++next_it;
+    /* it will be checked again on the next call */
+    if (dt.is_in_effect()) {
+      in_effect.push_back(e);
+      continue;
+    }
 
     /* this entry should be removed */
-    if (!dt.is_in_effect() && dt.get_end_time() < current_time) {
-      logger(dbg_downtime, basic)
-          << "Expiring "
-          << (dt.get_type() == downtime::host_downtime ? "host" : "service")
-          << " downtime (id=" << dt.get_downtime_id() << ")...";
-
-      /* delete the downtime entry */
-      delete_downtime(dt.get_downtime_id());
-    }
+    logger(dbg_downtime, basic)
+        << "Expiring "
+        << (dt.get_type() == downtime::host_downtime ? "host" : "service")
+        << " downtime (id=" << dt.get_downtime_id() << ")...";
+
+    /* delete the downtime entry */
+    delete_downtime(dt.get_downtime_id());
+  }
+  for (expiration const& e : in_effect) {
+    _expirations.push_back(e);
+    std::push_heap(_expirations.begin(), _expirations.end(),
+                   std::greater<expiration>());
   }
   return OK;
 }
@@ -271,39 +384,52 @@ int downtime_manager::
       comment.empty())
     return deleted;
 
-  std::pair<std::multimap<time_t, std::shared_ptr<downtime>>::iterator,
-            std::multimap<time_t, std::shared_ptr<downtime>>::iterator>
-      range;
-
-  if (start_time.first)
-    range = _scheduled_downtimes.equal_range(start_time.second);
-  else
-    range = {_scheduled_downtimes.begin(), _scheduled_downtimes.end()};
-
   std::list<uint64_t> lst;
-  for (auto it = range.first, end = range.second; it != end; ++it) {
-    if (!comment.empty() && it->second->get_comment() != comment)
-      continue;
-    if (downtime::host_downtime == it->second->get_type()) {
+  auto match = [&](downtime const& dt) {
+    if (!comment.empty() && dt.get_comment() != comment)
+      return;
+    if (start_time.first && dt.get_start_time() != start_time.second)
+      return;
+    if (downtime::host_downtime == dt.get_type()) {
       /* If service is specified, then do not delete the host downtime. */
       if (!service_description.empty())
-        continue;
-      if (!hostname.empty() && it->second->get_hostname() != hostname)
-        continue;
-    } else if (downtime::service_downtime == it->second->get_type()) {
-      if (!hostname.empty() && it->second->get_hostname() != hostname)
-        continue;
+        return;
+      if (!hostname.empty() && dt.get_hostname() != hostname)
+        return;
+    } else if (downtime::service_downtime == dt.get_type()) {
+      if (!hostname.empty() && dt.get_hostname() != hostname)
+        return;
       if (!service_description.empty()) {
-        service_downtime* svc{
-            dynamic_cast<service_downtime*>(it->second.get())};
+        service_downtime const* svc{
+            dynamic_cast<service_downtime const*>(&dt)};
 
         if (!svc || svc->get_service_description() != service_description)
-          continue;
+          return;
       }
     }
-    lst.push_back(it->second->get_downtime_id());
+    lst.push_back(dt.get_downtime_id());
     ++deleted;
-  }
+  };
+
+  /* Use the narrowest index available. */
+  if (start_time.first) {
+    auto range(_scheduled_downtimes.equal_range(start_time.second));
+    for (auto it = range.first; it != range.second; ++it)
+      match(*it->second);
+  } else if (!hostname.empty() && !service_description.empty()) {
+    auto range(
+        _downtimes_by_service.equal_range({hostname, service_description}));
+    for (auto it = range.first; it != range.second; ++it)
+      match(*it->second);
+  } else if (!hostname.empty()) {
+    auto range(_downtimes_by_host.equal_range(hostname));
+    for (auto it = range.first; it != range.second; ++it)
+      match(*it->second);
+  } else
+    for (auto it = _scheduled_downtimes.begin(),
+              end = _scheduled_downtimes.end();
+         it != end; ++it)
+      match(*it->second);
 
   for (auto id : lst)
     unschedule_downtime(id);
@@ -312,8 +438,7 @@ int downtime_manager::
 }
 void downtime_manager::insert_downtime(std::shared_ptr<downtime> dt) {
   logger(dbg_functions, basic) << "downtime_manager::insert_downtime()";
-  time_t start{dt->get_start_time()};
-  _scheduled_downtimes.insert({start, dt});
+  _insert(dt);
 }
 
 /**
@@ -343,7 +468,7 @@ int downtime_manager::xdddefault_validate_downtime_data() {
     /* delete downtimes with invalid host names, invalid service descriptions
      * or that have expired. */
     if (temp_downtime->is_stale())
-      it = _scheduled_downtimes.erase(it);
+      it = _erase(it);
     else
       ++it;
   }
@@ -365,7 +490,7 @@ int downtime_manager::xdddefault_validate_downtime_data() {
 
     /* delete the downtime */
     if (!save)
-      it = _scheduled_downtimes.erase(it);
+      it = _erase(it);
     else
       ++it;
   }
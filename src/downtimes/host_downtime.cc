@@ -256,7 +256,7 @@ int host_downtime::subscribe() {
                   time(NULL), "(Centreon Engine Process)", oss.str(), false,
                   comment::internal, false, (time_t)0)};
 
-  comment::comments.insert({com->get_comment_id(), com});
+  comment::insert_comment(com);
   _comment_id = com->get_comment_id();
 
   /*** SCHEDULE DOWNTIME - FLEXIBLE (NON-FIXED) DOWNTIME IS HANDLED AT A LATER
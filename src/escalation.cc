@@ -39,6 +39,7 @@ escalation::escalation(uint32_t first_notification,
           (notification_interval < 0) ? 0 : notification_interval},
       _escalation_period{escalation_period},
       _escalate_on{escalate_on},
+      _resolved_contacts_version{0},
       _uuid{uuid} {}
 
 std::string const& escalation::get_escalation_period() const {
@@ -150,6 +151,7 @@ void escalation::resolve(int& w __attribute__((unused)), int& e) {
       it->second = it_cg->second.get();
     }
   }
+  contactgroup::members_changed();
 
   if (errors) {
     e += errors;
@@ -157,6 +159,24 @@ void escalation::resolve(int& w __attribute__((unused)), int& e) {
   }
 }
 
+/**
+ *  Get the members of the escalation contact groups, each contact once.
+ *  The list is built again only when contact memberships changed since the
+ *  last call.
+ *
+ *  @return A list of contacts.
+ */
+std::vector<contact*> const& escalation::get_resolved_contacts() {
+  if (_resolved_contacts_version != contactgroup::get_members_version()) {
+    std::unordered_set<contact*> seen;
+    _resolved_contacts.clear();
+    contactgroup::flatten(_contact_groups, _resolved_contacts, seen);
+    _resolved_contacts.shrink_to_fit();
+    _resolved_contacts_version = contactgroup::get_members_version();
+  }
+  return _resolved_contacts;
+}
+
 Uuid const& escalation::get_uuid() const {
   return _uuid;
 }
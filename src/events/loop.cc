@@ -21,14 +21,18 @@
 */
 
 #include "com/centreon/engine/events/loop.hh"
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <chrono>
+#include <cmath>
 #include <cstdlib>
 #include <ctime>
+#include <functional>
 #include <future>
 #include <thread>
 #include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/checks/exec_time_estimator.hh"
 #include "com/centreon/engine/command_manager.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/configuration/parser.hh"
@@ -60,8 +64,11 @@ void loop::clear() {
     delete ev;
     ev = nullptr;
   }
+  for (timed_event* ev : _waiting_checks)
+    delete ev;
   _event_list_low.clear();
   _event_list_high.clear();
+  _waiting_checks.clear();
 
   _need_reload = 0;
   _reload_running = false;
@@ -195,7 +202,8 @@ void loop::_dispatching() {
       logger(dbg_events, more) << "No low priority events are scheduled...";
     logger(dbg_events, more)
         << "Current/Max Service Checks: " << currently_running_service_checks
-        << '/' << config->max_parallel_service_checks();
+        << '/' << config->max_parallel_service_checks() << " ("
+        << _waiting_checks.size() << " waiting)";
 
     // Update status information occassionally - NagVis watches the
     // NDOUtils DB to see if Engine is alive.
@@ -204,8 +212,12 @@ void loop::_dispatching() {
       update_program_status(false);
     }
 
+    // Launch the service checks that wait for a free slot.
+    _launch_waiting_checks();
+
     // Handle high priority events.
     bool run_event(true);
+    bool waiting(false);
     if (!_event_list_high.empty() &&
         (current_time >= (*_event_list_high.begin())->run_time)) {
       // Remove the first event from the timing loop.
@@ -233,35 +245,9 @@ void loop::_dispatching() {
       // Run a few checks before executing a service check...
       if ((*_event_list_low.begin())->event_type ==
           timed_event::EVENT_SERVICE_CHECK) {
-        int nudge_seconds(0);
         service* temp_service(
             static_cast<service*>((*_event_list_low.begin())->event_data));
 
-        // Don't run a service check if we're already maxed out on the
-        // number of parallel service checks...
-        if (config->max_parallel_service_checks() != 0 &&
-            (currently_running_service_checks >=
-             config->max_parallel_service_checks())) {
-          // Move it at least 5 seconds (to overcome the current peak),
-          // with a random 10 seconds (to spread the load).
-          nudge_seconds = 5 + (rand() % 10);
-          logger(dbg_events | dbg_checks, basic)
-              << "**WARNING** Max concurrent service checks ("
-              << currently_running_service_checks << "/"
-              << config->max_parallel_service_checks()
-              << ") has been reached!  Nudging " << temp_service->get_hostname()
-              << ":" << temp_service->get_description() << " by "
-              << nudge_seconds << " seconds...";
-          logger(log_runtime_warning, basic)
-              << "\tMax concurrent service checks ("
-              << currently_running_service_checks << "/"
-              << config->max_parallel_service_checks()
-              << ") has been reached.  Nudging " << temp_service->get_hostname()
-              << ":" << temp_service->get_description() << " by "
-              << nudge_seconds << " seconds...";
-          run_event = false;
-        }
-
         // Don't run a service check if active checks are disabled.
         if (!config->execute_service_checks()) {
           logger(dbg_events | dbg_checks, more)
@@ -271,7 +257,9 @@ void loop::_dispatching() {
         }
 
         // Forced checks override normal check logic.
-        if (temp_service->get_check_options() & CHECK_OPTION_FORCE_EXECUTION)
+        bool forced(temp_service->get_check_options() &
+                    CHECK_OPTION_FORCE_EXECUTION);
+        if (forced)
           run_event = true;
 
         // Reschedule the check if we can't run it now.
@@ -283,31 +271,47 @@ void loop::_dispatching() {
           timed_event* temp_event{*_event_list_low.begin()};
           _event_list_low.pop_front();
 
-          // We nudge the next check time when it is
-          // due to too many concurrent service checks.
-          if (nudge_seconds)
+          // Reschedule (TODO: This should be smarter as it doesn't
+          // consider its timeperiod).
+          if (notifier::soft == temp_service->get_state_type() &&
+              temp_service->get_current_state() != service::state_ok)
             temp_service->set_next_check(
-                (time_t)(temp_service->get_next_check() + nudge_seconds));
-          // Otherwise reschedule (TODO: This should be smarter as it
-          // doesn't consider its timeperiod).
-          else {
-            if (notifier::soft == temp_service->get_state_type() &&
-                temp_service->get_current_state() != service::state_ok)
-              temp_service->set_next_check(
-                  (time_t)(temp_service->get_next_check() +
-                           temp_service->get_retry_interval() *
-                               config->interval_length()));
-            else
-              temp_service->set_next_check(
-                  (time_t)(temp_service->get_next_check() +
-                           (temp_service->get_check_interval() *
-                            config->interval_length())));
-          }
+                (time_t)(temp_service->get_next_check() +
+                         temp_service->get_retry_interval() *
+                             config->interval_length()));
+          else
+            temp_service->set_next_check(
+                (time_t)(temp_service->get_next_check() +
+                         (temp_service->get_check_interval() *
+                          config->interval_length())));
           temp_event->run_time = temp_service->get_next_check();
           reschedule_event(temp_event, events::loop::low);
           temp_service->update_status();
           run_event = false;
         }
+        // Don't run a service check if we're already maxed out on the
+        // number of parallel service checks: it waits for a free slot
+        // behind the checks that were due before it.
+        else if (!forced && config->max_parallel_service_checks() != 0 &&
+                 (currently_running_service_checks >=
+                  config->max_parallel_service_checks())) {
+          if (_waiting_checks.empty())
+            logger(log_runtime_warning, basic)
+                << "Warning: Max concurrent service checks ("
+                << currently_running_service_checks << "/"
+                << config->max_parallel_service_checks()
+                << ") has been reached, due service checks wait for a "
+                   "free slot";
+          logger(dbg_events | dbg_checks, more)
+              << "Service '" << temp_service->get_description()
+              << "' on host '" << temp_service->get_hostname()
+              << "' waits for a free check slot (" << _waiting_checks.size()
+              << " checks before it)";
+          _waiting_checks.push_back(*_event_list_low.begin());
+          _event_list_low.pop_front();
+          run_event = false;
+          waiting = true;
+        }
       }
       // Run a few checks before executing a host check...
       else if (timed_event::EVENT_HOST_CHECK ==
@@ -374,7 +378,7 @@ void loop::_dispatching() {
           delete temp_event;
       }
       // Wait a while so we don't hog the CPU...
-      else {
+      else if (!waiting) {
         logger(dbg_events, most)
             << "Did not execute scheduled event. Idling for a bit...";
         uint64_t d = static_cast<uint64_t>(config->sleep_time() * 1000000000);
@@ -430,166 +434,259 @@ void loop::_dispatching() {
 }
 
 /**
- *  Adjusts scheduling of host and service checks.
+ *  Get the host or service of a check event.
+ *
+ *  @param[in] evt  The event.
+ *
+ *  @return The checked object, nullptr if the event is not a check.
  */
-void loop::adjust_check_scheduling() {
-  static double const projected_host_check_overhead(0.1);
-  static double const projected_service_check_overhead(0.1);
-  double current_exec_time(0.0);
-  double current_exec_time_offset(0.0);
-  double exec_time_factor(0.0);
-  double inter_check_delay(0.0);
-  double last_check_exec_time(0.0);
-  double total_check_exec_time(0.0);
-  int adjust_scheduling(false);
-  int total_checks(0);
-  time_t last_check_time(0L);
-  host* hst(nullptr);
-  com::centreon::engine::service* svc(nullptr);
-
-  logger(dbg_functions, basic) << "adjust_check_scheduling()";
-
-  /* TODO:
-     - Track host check overhead on a per-host basis
-     - Figure out how to calculate service check overhead
-  */
-
-  // determine our adjustment window.
-  time_t current_time(time(NULL));
-  time_t first_window_time(current_time);
-  time_t last_window_time(first_window_time +
-                          config->auto_rescheduling_window());
-
-  // get current scheduling data.
-  for (timed_event_list::iterator it{_event_list_low.begin()},
-       end{_event_list_low.end()};
-       it != end; ++it) {
-    // skip events outside of our current window.
-    if ((*it)->run_time <= first_window_time)
-      continue;
-    if ((*it)->run_time > last_window_time)
-      break;
-
-    if ((*it)->event_type == timed_event::EVENT_HOST_CHECK) {
-      if (!(hst = (host*)(*it)->event_data))
-        continue;
-
-      // ignore forced checks.
-      if (hst->get_check_options() & CHECK_OPTION_FORCE_EXECUTION)
-        continue;
+static notifier* checked_object(timed_event const* evt) {
+  if (evt->event_type == timed_event::EVENT_HOST_CHECK)
+    return static_cast<host*>(evt->event_data);
+  else if (evt->event_type == timed_event::EVENT_SERVICE_CHECK)
+    return static_cast<service*>(evt->event_data);
+  return nullptr;
+}
 
-      // does the last check "bump" into this one?
-      if ((last_check_time + last_check_exec_time) > (*it)->run_time)
-        adjust_scheduling = true;
+typedef std::pair<double, size_t> second_load;
 
-      last_check_time = (*it)->run_time;
+/**
+ *  Rebuild the min-heap of the seconds by load.
+ *
+ *  @param[in]  load    Expected number of checks running at each second.
+ *  @param[out] lowest  The heap.
+ */
+static void build_lowest(std::vector<double> const& load,
+                         std::vector<second_load>& lowest) {
+  lowest.clear();
+  for (size_t i(0); i < load.size(); ++i)
+    lowest.emplace_back(load[i], i);
+  std::make_heap(lowest.begin(), lowest.end(), std::greater<second_load>());
+}
 
-      // calculate time needed to perform check.
-      // NOTE: host check execution time is not taken into account,
-      // as scheduled host checks are run in parallel.
-      last_check_exec_time = projected_host_check_overhead;
-      total_check_exec_time += last_check_exec_time;
-    } else if ((*it)->event_type == timed_event::EVENT_SERVICE_CHECK) {
-      if (!(svc = (com::centreon::engine::service*)(*it)->event_data))
-        continue;
+/**
+ *  Add or remove the load of a check to the seconds it runs, from its start
+ *  second to the end of its expected execution time. The window is a cycle:
+ *  a check ending after its last second runs during its first ones. A check
+ *  longer than the window loads all the seconds evenly.
+ *
+ *  @param[in,out] load    Expected number of checks running at each second.
+ *  @param[in,out] lowest  Min-heap of the seconds by load, the new load of
+ *                         each changed second is pushed in it.
+ *  @param[in]     start   Start second of the check.
+ *  @param[in]     cost    Expected execution time of the check.
+ *  @param[in]     sign    1 to add the check, -1 to remove it.
+ */
+static void spread_load(std::vector<double>& load,
+                        std::vector<second_load>& lowest,
+                        size_t start,
+                        double cost,
+                        double sign) {
+  size_t window(load.size());
+  if (cost >= window) {
+    for (double& l : load)
+      l += sign * cost / window;
+    build_lowest(load, lowest);
+    return;
+  }
+  for (size_t k(0); k < cost; ++k) {
+    size_t i((start + k) % window);
+    load[i] += sign * std::min(1.0, cost - k);
+    lowest.emplace_back(load[i], i);
+    std::push_heap(lowest.begin(), lowest.end(), std::greater<second_load>());
+  }
 
-      // ignore forced checks.
-      if (svc->get_check_options() & CHECK_OPTION_FORCE_EXECUTION)
-        continue;
+  /* Too many outdated entries, the heap is rebuilt. */
+  if (lowest.size() > 4 * window + 64)
+    build_lowest(load, lowest);
+}
 
-      // does the last check "bump" into this one?
-      if ((last_check_time + last_check_exec_time) > (*it)->run_time)
-        adjust_scheduling = true;
+/**
+ *  Get the least loaded seconds. Entries of the heap whose load is not the
+ *  current one of their second are outdated and dropped.
+ *
+ *  @param[in]     load    Expected number of checks running at each second.
+ *  @param[in,out] lowest  Min-heap of the seconds by load.
+ *  @param[in]     count   Number of seconds wanted.
+ *
+ *  @return Up to count seconds, the least loaded first.
+ */
+static std::vector<size_t> lowest_seconds(std::vector<double> const& load,
+                                          std::vector<second_load>& lowest,
+                                          size_t count) {
+  std::vector<second_load> found;
+  while (found.size() < count && !lowest.empty()) {
+    std::pop_heap(lowest.begin(), lowest.end(), std::greater<second_load>());
+    second_load l(lowest.back());
+    lowest.pop_back();
+    if (l.first == load[l.second] &&
+        std::find(found.begin(), found.end(), l) == found.end())
+      found.push_back(l);
+  }
 
-      last_check_time = (*it)->run_time;
+  std::vector<size_t> retval;
+  for (second_load const& l : found) {
+    retval.push_back(l.second);
+    lowest.push_back(l);
+    std::push_heap(lowest.begin(), lowest.end(), std::greater<second_load>());
+  }
+  return retval;
+}
 
-      // calculate time needed to perform check.
-      // NOTE: service check execution time is not taken into
-      // account, as service checks are run in parallel.
-      last_check_exec_time = projected_service_check_overhead;
-      total_check_exec_time += last_check_exec_time;
-    } else
-      continue;
+/**
+ *  Get the peak of running checks over the seconds a check would run,
+ *  if it started at a given second.
+ *
+ *  @param[in] load   Expected number of checks running at each second,
+ *                    without the check.
+ *  @param[in] start  Start second of the check.
+ *  @param[in] cost   Expected execution time of the check, shorter than
+ *                    the window.
+ *
+ *  @return The highest number of running checks, the check included.
+ */
+static double span_peak(std::vector<double> const& load,
+                        size_t start,
+                        double cost) {
+  size_t window(load.size());
+  double peak(load[start] + std::min(1.0, cost));
+  for (size_t k(1); k < cost; ++k)
+    peak = std::max(peak,
+                    load[(start + k) % window] + std::min(1.0, cost - k));
+  return peak;
+}
 
-    ++total_checks;
-  }
+/**
+ *  Adjusts scheduling of host and service checks.
+ *
+ *  Each check loads the seconds of the rescheduling window it is expected
+ *  to run, so the load of a second is the expected number of checks
+ *  running then. A check whose seconds go above the mean of the window is
+ *  moved if this lowers its peak. Its new start is chosen among the spans
+ *  starting or ending at the least loaded seconds, taken from a min-heap:
+ *  a check costs its expected execution time plus log(window) per moved
+ *  second, instead of a scan of the whole window. The other checks keep
+ *  their time.
+ */
+void loop::adjust_check_scheduling() {
+  logger(dbg_functions, basic) << "adjust_check_scheduling()";
 
-  // nothing to do...
-  if (total_checks == 0 || adjust_scheduling == false)
+  // determine our adjustment window.
+  size_t window(config->auto_rescheduling_window());
+  if (!window)
     return;
+  time_t first_window_time(time(nullptr));
+  time_t last_window_time(first_window_time + window);
 
-  if ((unsigned long)total_check_exec_time >
-      config->auto_rescheduling_window()) {
-    inter_check_delay = 0.0;
-    exec_time_factor = (double)((double)config->auto_rescheduling_window() /
-                                total_check_exec_time);
-  } else {
-    inter_check_delay = (double)((((double)config->auto_rescheduling_window()) -
-                                  total_check_exec_time) /
-                                 (double)(total_checks * 1.0));
-    exec_time_factor = 1.0;
-  }
-
-  auto compute_new_run_time = [](double current_exec_time_offset,
-                                 double current_icd_offset,
-                                 time_t first_window_time) {
-    double offset = current_exec_time_offset + current_icd_offset;
-    time_t retval = first_window_time + static_cast<unsigned long>(offset);
-    return retval;
+  auto before = [](time_t t, timed_event const* evt) {
+    return t < evt->run_time;
   };
-  // adjust check scheduling.
-  double current_icd_offset(inter_check_delay / 2.0);
-  for (timed_event_list::iterator it = _event_list_low.begin(),
-                                  end = _event_list_low.end();
-       it != end; ++it) {
-    // skip events outside of our current window.
-    if ((*it)->run_time <= first_window_time)
+  timed_event_list::iterator window_begin(std::upper_bound(
+      _event_list_low.begin(), _event_list_low.end(), first_window_time,
+      before));
+  timed_event_list::iterator window_end(std::upper_bound(
+      window_begin, _event_list_low.end(), last_window_time, before));
+
+  // get current scheduling data: the expected number of checks running
+  // at each second.
+  checks::exec_time_estimator const& estimator(
+      checks::exec_time_estimator::instance());
+  std::vector<double> load(window, 0.0);
+  std::vector<second_load> lowest;
+  std::vector<std::vector<std::pair<timed_event*, double> > > slots(window);
+  double total_load(0.0);
+  for (timed_event_list::iterator it(window_begin); it != window_end; ++it) {
+    // ignore forced checks.
+    notifier* n(checked_object(*it));
+    if (!n || (n->get_check_options() & CHECK_OPTION_FORCE_EXECUTION))
       continue;
-    if ((*it)->run_time > last_window_time)
-      break;
-
-    if ((*it)->event_type == timed_event::EVENT_HOST_CHECK) {
-      if (!(hst = (host*)(*it)->event_data))
-        continue;
-
-      // ignore forced checks.
-      if (hst->get_check_options() & CHECK_OPTION_FORCE_EXECUTION)
-        continue;
-
-      current_exec_time =
-          (hst->get_execution_time() + projected_host_check_overhead) *
-          exec_time_factor;
-      time_t new_run_time = compute_new_run_time(
-          current_exec_time_offset, current_icd_offset, first_window_time);
-      (*it)->run_time = new_run_time;
-      hst->set_next_check(new_run_time);
-      hst->update_status();
-    } else if ((*it)->event_type == timed_event::EVENT_SERVICE_CHECK) {
-      if (!(svc = (com::centreon::engine::service*)(*it)->event_data))
-        continue;
-
-      // ignore forced checks.
-      if (svc->get_check_options() & CHECK_OPTION_FORCE_EXECUTION)
+    double cost(estimator.estimate(*n));
+    size_t slot((*it)->run_time - first_window_time - 1);
+    spread_load(load, lowest, slot, cost, 1.0);
+    slots[slot].emplace_back(*it, cost);
+    total_load += cost;
+  }
+  build_lowest(load, lowest);
+  double target(total_load / window);
+
+  // adjust check scheduling. Checks are taken from the end of their
+  // second so that they are found right before the next second. Checks
+  // longer than the window load it evenly wherever they start.
+  unsigned int moved(0);
+  for (size_t i(0); i < window; ++i) {
+    for (auto it(slots[i].rbegin()), end(slots[i].rend()); it != end; ++it) {
+      double cost(it->second);
+      if (cost <= 0.0 || cost >= window)
         continue;
+      spread_load(load, lowest, i, cost, -1.0);
+      double peak(span_peak(load, i, cost));
+      size_t dest(i);
+      if (peak > target) {
+        // the check starts or ends at one of the least loaded seconds.
+        std::vector<size_t> starts(lowest_seconds(load, lowest, 4));
+        size_t last(static_cast<size_t>(std::ceil(cost)) - 1);
+        for (size_t j(0), size(starts.size()); j < size; ++j)
+          starts.push_back((starts[j] + window - last) % window);
+        double lowest_peak(peak);
+        for (size_t s : starts) {
+          double p(span_peak(load, s, cost));
+          if (p < lowest_peak) {
+            lowest_peak = p;
+            dest = s;
+          }
+        }
+      }
+      spread_load(load, lowest, dest, cost, 1.0);
+      if (dest != i) {
+        _move_event(it->first, first_window_time + 1 + dest);
+        ++moved;
+      }
+    }
+  }
 
-      // NOTE: service check execution time is not taken into
-      // account, as service checks are run in parallel.
-      current_exec_time = projected_service_check_overhead * exec_time_factor;
-      time_t new_run_time = compute_new_run_time(
-          current_exec_time_offset, current_icd_offset, first_window_time);
-      (*it)->run_time = new_run_time;
-      svc->set_next_check(new_run_time);
-      svc->update_status();
-    } else
-      continue;
+  logger(dbg_events, more) << "Auto-rescheduling moved " << moved
+                           << " checks to flatten the expected load of "
+                           << target << " running checks";
+}
 
-    current_icd_offset += inter_check_delay;
-    current_exec_time_offset += current_exec_time;
-  }
+/**
+ *  Move a check event of the low priority list to another time.
+ *
+ *  @param[in] evt       The event.
+ *  @param[in] run_time  Its new execution time.
+ */
+void loop::_move_event(timed_event* evt, time_t run_time) {
+  auto before = [](time_t t, timed_event const* e) { return t < e->run_time; };
+
+  // look for the event from the last one of its second.
+  timed_event_list::iterator it(std::upper_bound(
+      _event_list_low.begin(), _event_list_low.end(), evt->run_time, before));
+  do {
+    if (it == _event_list_low.begin() ||
+        (*(it - 1))->run_time != evt->run_time)
+      return;
+    --it;
+  } while (*it != evt);
+
+  // the events between the old and the new place are shifted by one.
+  time_t old_time(evt->run_time);
+  evt->run_time = run_time;
+  if (run_time > old_time)
+    std::rotate(it, it + 1,
+                std::upper_bound(it + 1, _event_list_low.end(), run_time,
+                                 before));
+  else if (run_time < old_time)
+    std::rotate(
+        std::upper_bound(_event_list_low.begin(), it, run_time, before), it,
+        it + 1);
+
+  notifier* n(checked_object(evt));
+  n->set_next_check(run_time);
+  n->update_status();
 
-  // resort event list (some events may be out of order at
-  // this point).
-  resort_event_list(events::loop::low);
+  // send event data to broker.
+  broker_timed_event(NEBTYPE_TIMEDEVENT_ADD, NEBFLAG_NONE, NEBATTR_NONE, evt,
+                     nullptr);
 }
 
 /**
@@ -840,9 +937,10 @@ void loop::remove_event(timed_event* event, loop::priority priority) {
       }
     }
   };
-  if (priority == loop::low)
+  if (priority == loop::low) {
     eraser(_event_list_low, event);
-  else
+    eraser(_waiting_checks, event);
+  } else
     eraser(_event_list_high, event);
 }
 
@@ -860,6 +958,28 @@ void loop::remove_events(loop::priority priority,
       delete *it;
       list->erase(it);
     }
+
+  if (priority == loop::low)
+    for (auto it = _waiting_checks.begin(); it != _waiting_checks.end();)
+      if ((*it)->event_type == event_type && (*it)->event_data == data) {
+        delete *it;
+        it = _waiting_checks.erase(it);
+      } else
+        ++it;
+}
+
+/**
+ *  Get the number of events in a list. Service checks waiting for a free
+ *  slot are low priority events.
+ *
+ *  @param[in] priority  The list priority.
+ *
+ *  @return The number of events.
+ */
+size_t loop::events_count(loop::priority priority) const noexcept {
+  return priority == loop::low
+             ? _event_list_low.size() + _waiting_checks.size()
+             : _event_list_high.size();
 }
 
 timed_event* loop::find_event(loop::priority priority,
@@ -879,6 +999,11 @@ timed_event* loop::find_event(loop::priority priority,
     if ((*it)->event_type == event_type && (*it)->event_data == data)
       return *it;
 
+  if (priority == loop::low)
+    for (timed_event* evt : _waiting_checks)
+      if (evt->event_type == event_type && evt->event_data == data)
+        return evt;
+
   return nullptr;
 }
 
@@ -959,3 +1084,66 @@ void loop::schedule(timed_event* evt, bool high_priority) {
   else
     add_event(evt, loop::low);
 }
+
+/**
+ *  Get the number of service checks waiting for a free slot.
+ *
+ *  @return The number of checks.
+ */
+size_t loop::waiting_checks_count() const noexcept {
+  return _waiting_checks.size();
+}
+
+/**
+ *  Account the latency of a scheduled check.
+ *
+ *  @param[in] source   Host or service check.
+ *  @param[in] latency  Latency in seconds.
+ */
+void loop::add_check_latency(check_source source, double latency) noexcept {
+  _check_latency[source].add(latency);
+}
+
+/**
+ *  Get the latencies of the scheduled checks since the engine started.
+ *
+ *  @param[in] source  Host or service check.
+ *
+ *  @return The latency distribution.
+ */
+checks::latency_histogram const& loop::check_latency(
+    check_source source) const noexcept {
+  return _check_latency[source];
+}
+
+/**
+ *  Launch the service checks waiting for a free slot, in the order they
+ *  were due, as long as slots are free. Slots are released when check
+ *  results are reaped.
+ */
+void loop::_launch_waiting_checks() {
+  // Checks disabled meanwhile go back to the event list where they are
+  // rescheduled as usual.
+  if (!config->execute_service_checks()) {
+    for (timed_event* evt : _waiting_checks)
+      add_event(evt, loop::low);
+    _waiting_checks.clear();
+    return;
+  }
+
+  while (!_waiting_checks.empty() &&
+         (config->max_parallel_service_checks() == 0 ||
+          currently_running_service_checks <
+              config->max_parallel_service_checks())) {
+    timed_event* evt(_waiting_checks.front());
+    _waiting_checks.pop_front();
+
+    logger(dbg_events, more) << "Running waiting service check...";
+    evt->handle_timed_event();
+
+    if (evt->recurring)
+      reschedule_event(evt, loop::low);
+    else
+      delete evt;
+  }
+}
@@ -32,6 +32,7 @@
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/objects.hh"
+#include "com/centreon/engine/profiler.hh"
 #include "com/centreon/engine/retention/dump.hh"
 #include "com/centreon/engine/statusdata.hh"
 #include "com/centreon/engine/string.hh"
@@ -108,6 +109,7 @@ void timed_event::_exec_event_service_check() {
       << "** Service Check Event ==> Host: '" << svc->get_hostname()
       << "', Service: '" << svc->get_description()
       << "', Options: " << event_options << ", Latency: " << latency << " sec";
+  events::loop::instance().add_check_latency(service_check, latency);
 
   // run the service check.
   svc->run_scheduled_check(event_options, latency);
@@ -276,6 +278,7 @@ void timed_event::_exec_event_host_check() {
   logger(dbg_events, basic)
       << "** Host Check Event ==> Host: '" << hst->get_name()
       << "', Options: " << event_options << ", Latency: " << latency << " sec";
+  events::loop::instance().add_check_latency(host_check, latency);
 
   // run the host check.
   hst->run_scheduled_check(event_options, latency);
@@ -406,6 +409,7 @@ int timed_event::handle_timed_event() {
       &timed_event::_exec_event_enginerpc_check};
 
   logger(dbg_functions, basic) << "handle_timed_event()";
+  profiler::scope timer{profiler::event_dispatch};
 
   // send event data to broker.
   broker_timed_event(NEBTYPE_TIMEDEVENT_EXECUTE, NEBFLAG_NONE, NEBATTR_NONE,
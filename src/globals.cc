@@ -68,6 +68,7 @@ int test_scheduling(false);
 int verify_circular_paths(true);
 int verify_config(false);
 nebcallback* neb_callback_list[NEBCALLBACK_NUMITEMS];
+uint64_t neb_callback_subscriptions(0);
 sched_info scheduling_info;
 time_t event_start((time_t)-1);
 time_t last_command_check((time_t)-1);
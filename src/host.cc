@@ -19,11 +19,14 @@
 
 #include "com/centreon/engine/host.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <iomanip>
 
 #include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/checks/check_result_pool.hh"
 #include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/checks/exec_time_estimator.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/downtimes/downtime_manager.hh"
 #include "com/centreon/engine/events/loop.hh"
@@ -37,6 +40,7 @@
 #include "com/centreon/engine/neberrors.hh"
 #include "com/centreon/engine/notification.hh"
 #include "com/centreon/engine/objects.hh"
+#include "com/centreon/engine/profiler.hh"
 #include "com/centreon/engine/sehandlers.hh"
 #include "com/centreon/engine/shared.hh"
 #include "com/centreon/engine/statusdata.hh"
@@ -59,6 +63,7 @@ std::array<std::pair<uint32_t, std::string>, 3> const host::tab_host_states{
 
 host_map host::hosts;
 host_id_map host::hosts_by_id;
+host_address_map host::hosts_by_address;
 
 /*
  *  @param[in] name                          Host name.
@@ -1119,6 +1124,24 @@ host& engine::find_host(uint64_t host_id) {
   return *it->second;
 }
 
+/**
+ *  Get a host by its name or, if no host has this name, by its address.
+ *  Several hosts may share an address, one of them is returned.
+ *
+ *  @param[in] name The host name or address.
+ *
+ *  @return The host or nullptr if it is not found.
+ */
+host* engine::find_host_by_name_or_address(std::string const& name) {
+  host_map::const_iterator it{host::hosts.find(name)};
+  if (it != host::hosts.end() && it->second)
+    return it->second.get();
+  host_address_map::const_iterator ita{host::hosts_by_address.find(name)};
+  if (ita != host::hosts_by_address.end())
+    return ita->second;
+  return nullptr;
+}
+
 /**
  *  Get if host exist.
  *
@@ -1185,6 +1208,7 @@ int host::log_event() {
 
 /* process results of an asynchronous host check */
 int host::handle_async_check_result_3x(check_result* queued_check_result) {
+  profiler::scope timer{profiler::result_handling};
   enum service::service_state svc_res{service::state_ok};
   enum host::host_state hst_res{host::state_up};
   int reschedule_check{false};
@@ -1314,6 +1338,8 @@ int host::handle_async_check_result_3x(check_result* queued_check_result) {
 
   /* update the execution time for this check (millisecond resolution) */
   set_execution_time(execution_time);
+  if (queued_check_result->get_check_type() == check_active)
+    checks::exec_time_estimator::instance().add(*this, execution_time);
 
   /* set the checked flag */
   set_has_been_checked(true);
@@ -1659,8 +1685,7 @@ int host::run_async_check(int check_options,
   nagios_macros* macros(get_global_macros());
   grab_host_macros_r(macros, this);
   std::string tmp;
-  get_raw_command_line_r(macros, get_check_command_ptr(),
-                         get_check_command().c_str(), tmp, 0);
+  get_check_command_line_r(macros, this, tmp, 0);
 
   // Time to start command.
   gettimeofday(&start_time, nullptr);
@@ -1699,13 +1724,13 @@ int host::run_async_check(int check_options,
 
   // Run command.
   bool retry;
-  std::unique_ptr<check_result> check_result_info;
+  checks::check_result_pool::pointer check_result_info;
   do {
     // Init check result info.
-    check_result_info.reset(
-        new check_result(host_check, this, checkable::check_active,
-                         check_options, reschedule_check, latency, start_time,
-                         start_time, false, true, service::state_ok, ""));
+    check_result_info.reset(checks::check_result_pool::instance().get(
+        host_check, this, checkable::check_active, check_options,
+        reschedule_check, latency, start_time, start_time, false, true,
+        service::state_ok, ""));
 
     retry = false;
     try {
@@ -1714,7 +1739,9 @@ int host::run_async_check(int check_options,
           cmd->run(processed_cmd, *macros, config->host_check_timeout());
       if (id != 0)
         checks::checker::instance().add_check_result(
-            id, check_result_info.release());
+            id, check_result_info.release(),
+            start_time.tv_sec + config->host_check_timeout() +
+                DEFAULT_ORPHAN_CHECK_GRACE);
     } catch (com::centreon::exceptions::interruption const& e) {
       retry = true;
     } catch (std::exception const& e) {
@@ -1741,6 +1768,42 @@ int host::run_async_check(int check_options,
   return OK;
 }
 
+/**
+ *  Request an on-demand check of the host for an object whose state was
+ *  observed at a given time. Requests are coalesced: a check of the host
+ *  that is being executed, that is due in the event list or that started
+ *  after the observation answers the request, so no other check is
+ *  launched. This avoids a burst of host checks when many services of the
+ *  host change state together.
+ *
+ *  @param[in] observed  Time of the observation that needs the host state.
+ */
+void host::request_check(time_t observed) {
+  time_t now(time(nullptr));
+  char const* reason(nullptr);
+  if (get_is_executing())
+    reason = "is being executed";
+  else if (has_been_checked() && get_last_check() >= observed)
+    reason = "started after the request";
+  else if (get_next_check() <= now && config->execute_host_checks()) {
+    timed_event* evt(events::loop::instance().find_event(
+        events::loop::low, timed_event::EVENT_HOST_CHECK, this));
+    if (evt && evt->run_time <= now)
+      reason = "is due";
+  }
+
+  if (reason) {
+    logger(dbg_checks, more)
+        << "On-demand check of host '" << get_name()
+        << "' is coalesced with the check that " << reason;
+    update_check_stats(ACTIVE_ONDEMAND_HOST_CHECK_STATS, now);
+    update_check_stats(ACTIVE_CACHED_HOST_CHECK_STATS, now);
+    return;
+  }
+
+  run_async_check(CHECK_OPTION_NONE, 0.0, false, false, nullptr, nullptr);
+}
+
 /**
  * @brief Schedules an immediate or delayed host check
  *
@@ -2045,7 +2108,7 @@ void host::set_flap(double percent_change,
                   time(nullptr), "(Centreon Engine Process)", oss.str(), false,
                   comment::internal, false, (time_t)0)};
 
-  comment::comments.insert({com->get_comment_id(), com});
+  comment::insert_comment(com);
 
   uint64_t comment_id{com->get_comment_id()};
   set_flapping_comment_id(comment_id);
@@ -2100,9 +2163,11 @@ void host::clear_flap(double percent_change,
 }
 
 /**
- * @brief Updates host status info. Data are sent to event broker.
+ * @brief Updates host status info. Data are sent to event broker and the
+ *        status file block of the host will be rendered again.
  */
 void host::update_status() {
+  get_status_blocks().dirty = true;
   broker_host_status(NEBTYPE_HOSTSTATUS_UPDATE, NEBFLAG_NONE, NEBATTR_NONE,
                      this, nullptr);
 }
@@ -2624,20 +2689,15 @@ bool host::is_valid_escalation_for_notification(escalation const* e,
   return true;
 }
 
-/* checks to see if a hosts's check results are fresh */
-bool host::is_result_fresh(time_t current_time, int log_this) {
-  time_t expiration_time = 0L;
-  int freshness_threshold = 0;
-  int days = 0;
-  int hours = 0;
-  int minutes = 0;
-  int seconds = 0;
-  int tdays = 0;
-  int thours = 0;
-  int tminutes = 0;
-  int tseconds = 0;
-
-  logger(dbg_checks, most) << "Checking freshness of host '" << _name << "'...";
+/**
+ *  Compute the time the last check result of the host becomes stale.
+ *
+ *  @param[out] freshness_threshold  The threshold used, in seconds.
+ *
+ *  @return The expiration time.
+ */
+time_t host::get_freshness_expiration(int& freshness_threshold) {
+  time_t expiration_time;
 
   /* use user-supplied freshness threshold or auto-calculate a freshness
    * threshold to use? */
@@ -2653,10 +2713,6 @@ bool host::is_result_fresh(time_t current_time, int log_this) {
   } else
     freshness_threshold = get_freshness_threshold();
 
-  logger(dbg_checks, most) << "Freshness thresholds: host="
-                           << get_freshness_threshold()
-                           << ", use=" << freshness_threshold;
-
   /* calculate expiration time */
   /* CHANGED 11/10/05 EG - program start is only used in expiration time
    * calculation if > last check AND active checks are enabled, so active checks
@@ -2676,6 +2732,28 @@ bool host::is_result_fresh(time_t current_time, int log_this) {
                  (config->max_host_check_spread() * config->interval_length()));
   else
     expiration_time = (time_t)(get_last_check() + freshness_threshold);
+  return expiration_time;
+}
+
+/* checks to see if a hosts's check results are fresh */
+bool host::is_result_fresh(time_t current_time, int log_this) {
+  int freshness_threshold = 0;
+  int days = 0;
+  int hours = 0;
+  int minutes = 0;
+  int seconds = 0;
+  int tdays = 0;
+  int thours = 0;
+  int tminutes = 0;
+  int tseconds = 0;
+
+  logger(dbg_checks, most) << "Checking freshness of host '" << _name << "'...";
+
+  time_t expiration_time(get_freshness_expiration(freshness_threshold));
+
+  logger(dbg_checks, most) << "Freshness thresholds: host="
+                           << get_freshness_threshold()
+                           << ", use=" << freshness_threshold;
 
   logger(dbg_checks, most) << "HBC: " << has_been_checked()
                            << ", PS: " << program_start
@@ -3314,11 +3392,8 @@ int host::process_check_result_3x(enum host::host_state new_state,
                                   current_time - temp_host->get_last_check()) <=
                               check_timestamp_horizon))
       run_async_check = false;
-    if (temp_host->get_is_executing())
-      run_async_check = false;
     if (run_async_check)
-      temp_host->run_async_check(CHECK_OPTION_NONE, 0.0, false, false, nullptr,
-                                 nullptr);
+      temp_host->request_check(get_last_check());
   }
   return OK;
 }
@@ -3462,44 +3537,55 @@ void host::check_result_freshness() {
   /* get the current time */
   time(&current_time);
 
-  /* check all hosts... */
-  for (host_map::iterator it{host::hosts.begin()}, end{host::hosts.end()};
-       it != end; ++it) {
-    /* skip hosts we shouldn't be checking for freshness */
-    if (!it->second->get_check_freshness())
+  /* only the hosts whose freshness deadline is reached are checked */
+  checkable_state_store& states{checkable_state_store::hosts()};
+  for (checkable_state* st : states.pop_freshness_due(current_time)) {
+    /* skip hosts we shouldn't be checking for freshness, they are watched
+     * again when their settings change */
+    if (!st->check_freshness)
       continue;
 
     /* skip hosts that have both active and passive checks disabled */
-    if (!it->second->get_checks_enabled() &&
-        !it->second->get_accept_passive_checks())
+    if (!st->checks_enabled && !st->accept_passive_checks)
       continue;
 
-    /* skip hosts that are currently executing (problems here will be caught by
-     * orphaned host check) */
-    if (it->second->get_is_executing())
-      continue;
+    host* hst{static_cast<host*>(st->owner)};
 
-    /* skip hosts that are already being freshened */
-    if (it->second->get_is_being_freshened())
+    /* hosts that are currently executing (problems here will be caught by
+     * orphaned host check) or already being freshened are looked at again
+     * at the next sweep */
+    if (st->is_executing || hst->get_is_being_freshened()) {
+      states.watch_freshness(*st, current_time + 1);
       continue;
+    }
 
     // See if the time is right...
     {
-      timezone_locker lock(it->second->get_timezone());
-      if (!check_time_against_period(current_time,
-                                     it->second->check_period_ptr))
+      timezone_locker lock(hst->get_timezone());
+      if (!check_time_against_period(current_time, hst->check_period_ptr)) {
+        time_t next_valid_time;
+        get_next_valid_time(current_time, &next_valid_time,
+                            hst->check_period_ptr);
+        states.watch_freshness(*st,
+                               std::max(next_valid_time, current_time + 1));
         continue;
+      }
     }
 
     /* the results for the last check of this host are stale */
-    if (!it->second->is_result_fresh(current_time, true)) {
+    if (!hst->is_result_fresh(current_time, true)) {
       /* set the freshen flag */
-      it->second->set_is_being_freshened(true);
+      hst->set_is_being_freshened(true);
 
       /* schedule an immediate forced check of the host */
-      it->second->schedule_check(
+      hst->schedule_check(
           current_time,
           CHECK_OPTION_FORCE_EXECUTION | CHECK_OPTION_FRESHNESS_CHECK);
+      states.watch_freshness(*st, current_time + 1);
+    } else {
+      int freshness_threshold;
+      states.watch_freshness(
+          *st, hst->get_freshness_expiration(freshness_threshold) + 1);
     }
   }
 }
@@ -3541,54 +3627,36 @@ void host::adjust_check_attempt(bool is_active) {
 /* check for hosts that never returned from a check... */
 void host::check_for_orphaned() {
   time_t current_time = 0L;
-  time_t expected_time = 0L;
 
   logger(dbg_functions, basic) << "check_for_orphaned_hosts()";
 
   /* get the current time */
   time(&current_time);
 
-  /* check all hosts... */
-  for (host_map::iterator it{host::hosts.begin()}, end{host::hosts.end()};
-       it != end; ++it) {
-    /* skip hosts that don't have a set check interval (on-demand checks are
-     * missed by the orphan logic) */
-    if (it->second->get_next_check() == (time_t)0L)
-      continue;
-
-    /* skip hosts that are not currently executing */
-    if (!it->second->get_is_executing())
-      continue;
-
-    /* determine the time at which the check results should have come in (allow
-     * 10 minutes slack time) */
-    expected_time = (time_t)(
-        it->second->get_next_check() + it->second->get_latency() +
-        config->host_check_timeout() + config->check_reaper_interval() + 600);
+  /* only the checks whose deadline is reached without result are given */
+  for (notifier* n : checks::checker::instance().get_orphaned_checks(
+           host_check, current_time)) {
+    host* hst{static_cast<host*>(n)};
 
-    /* this host was supposed to have executed a while ago, but for some reason
-     * the results haven't come back in... */
-    if (expected_time < current_time) {
-      /* log a warning */
-      logger(log_runtime_warning, basic)
-          << "Warning: The check of host '" << it->second->get_name()
-          << "' looks like it was orphaned (results never came back).  "
-             "I'm scheduling an immediate check of the host...";
+    /* log a warning */
+    logger(log_runtime_warning, basic)
+        << "Warning: The check of host '" << hst->get_name()
+        << "' looks like it was orphaned (results never came back).  "
+           "I'm scheduling an immediate check of the host...";
 
-      logger(dbg_checks, more)
-          << "Host '" << it->second->get_name()
-          << "' was orphaned, so we're scheduling an immediate check...";
+    logger(dbg_checks, more)
+        << "Host '" << hst->get_name()
+        << "' was orphaned, so we're scheduling an immediate check...";
 
-      /* decrement the number of running host checks */
-      if (currently_running_host_checks > 0)
-        currently_running_host_checks--;
+    /* decrement the number of running host checks */
+    if (currently_running_host_checks > 0)
+      currently_running_host_checks--;
 
-      /* disable the executing flag */
-      it->second->set_is_executing(false);
+    /* disable the executing flag */
+    hst->set_is_executing(false);
 
-      /* schedule an immediate check of the host */
-      it->second->schedule_check(current_time, CHECK_OPTION_ORPHAN_CHECK);
-    }
+    /* schedule an immediate check of the host */
+    hst->schedule_check(current_time, CHECK_OPTION_ORPHAN_CHECK);
   }
 }
 
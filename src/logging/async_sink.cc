@@ -0,0 +1,309 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/logging/async_sink.hh"
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/exceptions/error.hh"
+#include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/nebstructs.hh"
+
+using namespace com::centreon::engine::logging;
+
+/* Maximum number of records handled in one write. */
+static size_t const batch_size = 128;
+
+/**
+ *  Constructor. Open the log file and start the thread.
+ *
+ *  @param[in] path      Log file path, empty to only send log events to
+ *                       the broker.
+ *  @param[in] show_pid  Write the process id in the line headers.
+ */
+async_sink::async_sink(std::string const& path, bool show_pid)
+    : backend(false, show_pid, com::centreon::logging::second, false),
+      _path{path},
+      _fd{-1},
+      _broker{false},
+      _cells{new cell[queue_size]},
+      _head{0},
+      _tail{0},
+      _done{0},
+      _sleeping{false},
+      _exit{false} {
+  for (size_t i = 0; i < queue_size; ++i)
+    _cells[i].seq.store(i, std::memory_order_relaxed);
+  open();
+  _thread = std::thread(&async_sink::_run, this);
+}
+
+/**
+ *  Destructor. The queued records are handled before the thread stops.
+ */
+async_sink::~async_sink() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(_m);
+    _exit = true;
+  }
+  _cv.notify_all();
+  _thread.join();
+  close();
+}
+
+/**
+ *  Close the log file.
+ */
+void async_sink::close() noexcept {
+  std::lock_guard<std::mutex> lock(_file_m);
+  if (_fd >= 0) {
+    ::close(_fd);
+    _fd = -1;
+  }
+}
+
+/**
+ *  Enable or disable the log events sent to the broker. Records queued
+ *  before the call are handled with the previous setting, and when the
+ *  method returns, the thread is not in a broker callback anymore.
+ *
+ *  @param[in] enable  true to send log events.
+ */
+void async_sink::enable_broker(bool enable) {
+  flush();
+  std::lock_guard<std::mutex> lock(_broker_m);
+  _broker = enable;
+}
+
+/**
+ *  Get the log file path.
+ *
+ *  @return The path given to the constructor.
+ */
+std::string const& async_sink::filename() const noexcept {
+  return _path;
+}
+
+/**
+ *  Wait for the records queued before the call to be handled.
+ */
+void async_sink::flush() {
+  if (std::this_thread::get_id() == _thread.get_id())
+    return;
+  size_t target(_head.load());
+  std::unique_lock<std::mutex> lock(_m);
+  _cv.notify_all();
+  _cv.wait(lock, [this, target] { return _done.load() >= target; });
+}
+
+/**
+ *  Queue a message.
+ *
+ *  @param[in] types    Logging types.
+ *  @param[in] verbose  Verbosity level.
+ *  @param[in] msg      Message to log.
+ *  @param[in] size     Message length.
+ */
+void async_sink::log(uint64_t types,
+                     uint32_t verbose,
+                     char const* msg,
+                     uint32_t size) noexcept {
+  /* Reserve a cell: its sequence equals the position when it is free. */
+  size_t pos(_head.load(std::memory_order_relaxed));
+  cell* c;
+  for (;;) {
+    c = &_cells[pos & (queue_size - 1)];
+    size_t seq(c->seq.load(std::memory_order_acquire));
+    if (seq == pos) {
+      if (_head.compare_exchange_weak(pos, pos + 1,
+                                      std::memory_order_relaxed))
+        break;
+    } else if (seq < pos) {
+      /* Full, the thread must free a record first. */
+      if (std::this_thread::get_id() == _thread.get_id())
+        return;
+      _cv.notify_all();
+      std::this_thread::yield();
+      pos = _head.load(std::memory_order_relaxed);
+    } else
+      pos = _head.load(std::memory_order_relaxed);
+  }
+
+  record& r(c->rec);
+  r.time = time(nullptr);
+  r.types = types;
+  r.verbose = verbose;
+  r.size = size;
+  /* As the synchronous broker backend, do not send to the broker messages
+   * logged by a broker callback. */
+  r.broker = verbose == basic && (types & log_all) &&
+             std::this_thread::get_id() != _thread.get_id();
+  if (size < inline_size)
+    memcpy(r.msg, msg, size);
+  else
+    r.large.assign(msg, size);
+  r.data()[size] = 0;
+  c->seq.store(pos + 1, std::memory_order_release);
+
+  /* Pairs with the fence of _run(): either the thread sees the record or
+   * we see it is sleeping. */
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (_sleeping.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> lock(_m);
+    _cv.notify_all();
+  }
+}
+
+/**
+ *  Open the log file.
+ */
+void async_sink::open() {
+  if (_path.empty())
+    return;
+  std::lock_guard<std::mutex> lock(_file_m);
+  if (_fd < 0) {
+    _fd = ::open(_path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC,
+                 S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (_fd < 0) {
+      char const* msg(strerror(errno));
+      throw engine_error() << "Cannot open log file '" << _path
+                           << "': " << msg;
+    }
+  }
+}
+
+/**
+ *  Open the log file again, for example after it has been rotated.
+ */
+void async_sink::reopen() {
+  close();
+  open();
+}
+
+/**
+ *  Handle the ready records, at most batch_size of them.
+ *
+ *  @return The number of handled records.
+ */
+size_t async_sink::_drain() {
+  size_t count(0);
+  while (count < batch_size) {
+    cell& c(_cells[(_tail + count) & (queue_size - 1)]);
+    if (c.seq.load(std::memory_order_acquire) != _tail + count + 1)
+      break;
+    ++count;
+  }
+  if (!count)
+    return 0;
+
+  if (!_path.empty()) {
+    fmt::memory_buffer buffer;
+    for (size_t i = 0; i < count; ++i) {
+      record& r(_cells[(_tail + i) & (queue_size - 1)].rec);
+      char const* line(r.data());
+      char const* end(line + r.size);
+      while (line < end) {
+        char const* eol(
+            static_cast<char const*>(memchr(line, '\n', end - line)));
+        if (!eol)
+          eol = end;
+        if (_show_pid)
+          fmt::format_to(std::back_inserter(buffer), "[{}] [{}] ", r.time,
+                         getpid());
+        else
+          fmt::format_to(std::back_inserter(buffer), "[{}] ", r.time);
+        buffer.append(line, eol);
+        buffer.push_back('\n');
+        line = eol + 1;
+      }
+    }
+    _write(buffer.data(), buffer.size());
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_broker_m);
+    if (_broker)
+      for (size_t i = 0; i < count; ++i) {
+        record& r(_cells[(_tail + i) & (queue_size - 1)].rec);
+        if (r.broker)
+          broker_log_data(NEBTYPE_LOG_DATA, NEBFLAG_NONE, NEBATTR_NONE,
+                          r.data(), r.types, r.time, nullptr);
+      }
+  }
+
+  /* Give the cells back to the producers, one lap later. */
+  for (size_t i = 0; i < count; ++i) {
+    cell& c(_cells[(_tail + i) & (queue_size - 1)]);
+    if (c.rec.size >= inline_size)
+      std::string().swap(c.rec.large);
+    c.seq.store(_tail + i + queue_size, std::memory_order_release);
+  }
+  _tail += count;
+  return count;
+}
+
+/**
+ *  Thread: handle records until destruction.
+ */
+void async_sink::_run() {
+  for (;;) {
+    if (_drain()) {
+      _done.store(_tail);
+      std::lock_guard<std::mutex> lock(_m);
+      _cv.notify_all();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(_m);
+    _sleeping.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    cell& c(_cells[_tail & (queue_size - 1)]);
+    if (c.seq.load(std::memory_order_acquire) != _tail + 1) {
+      if (_exit)
+        break;
+      _cv.wait_for(lock, std::chrono::milliseconds(100));
+    }
+    _sleeping.store(false, std::memory_order_relaxed);
+  }
+}
+
+/**
+ *  Write a buffer into the log file.
+ *
+ *  @param[in] data  Buffer.
+ *  @param[in] size  Buffer size.
+ */
+void async_sink::_write(char const* data, size_t size) {
+  std::lock_guard<std::mutex> lock(_file_m);
+  while (_fd >= 0 && size) {
+    ssize_t wb(::write(_fd, data, size));
+    if (wb < 0) {
+      if (errno == EINTR)
+        continue;
+      break;
+    }
+    data += wb;
+    size -= wb;
+  }
+}
@@ -21,6 +21,7 @@
 #include "com/centreon/engine/macros/process.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/profiler.hh"
 #include "com/centreon/engine/string.hh"
 
 using namespace com::centreon::engine;
@@ -43,6 +44,7 @@ int process_macros_r(nagios_macros* mac,
   int macro_options = 0;
 
   logger(dbg_functions, basic) << "process_macros_r()";
+  profiler::scope timer{profiler::macro_expansion};
 
   output_buffer = "";
 
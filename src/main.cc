@@ -375,6 +375,8 @@ int main(int argc, char* argv[]) {
         // Add broker backend.
         com::centreon::logging::engine::instance().add(
             &backend_broker_log, logging::log_all, logging::basic);
+        configuration::applier::logging::instance().set_broker_backend(
+            &backend_broker_log);
 
         // Apply configuration.
         configuration::applier::state::instance().apply(config, state);
@@ -0,0 +1,258 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/memory_stats.hh"
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include "com/centreon/engine/broker/loader.hh"
+#include "com/centreon/engine/checkable_state.hh"
+#include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/comment.hh"
+#include "com/centreon/engine/contact.hh"
+#include "com/centreon/engine/downtimes/downtime_manager.hh"
+#include "com/centreon/engine/events/loop.hh"
+#include "com/centreon/engine/events/timed_event.hh"
+#include "com/centreon/engine/host.hh"
+#include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/macros/misc.hh"
+#include "com/centreon/engine/service.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::logging;
+
+/* Number of hosts and services listed in the profile dump. */
+static size_t const largest_count = 10;
+
+/**
+ *  Memory used by the heap parts of custom variables.
+ */
+static uint64_t custom_variables_size(map_customvar const& vars) {
+  uint64_t retval(0);
+  for (auto const& p : vars)
+    retval += sizeof(p) + memory_stats::string_size(p.first) +
+              memory_stats::string_size(p.second.get_value());
+  return retval;
+}
+
+/**
+ *  Memory used by the strings common to hosts and services.
+ */
+static uint64_t checkable_strings_size(checkable& c) {
+  checkable::status_blocks& blocks(c.get_status_blocks());
+  return memory_stats::string_size(c.get_display_name()) +
+         memory_stats::string_size(c.get_check_command()) +
+         memory_stats::string_size(c.get_check_period()) +
+         memory_stats::string_size(c.get_event_handler()) +
+         memory_stats::string_size(c.get_action_url()) +
+         memory_stats::string_size(c.get_icon_image()) +
+         memory_stats::string_size(c.get_icon_image_alt()) +
+         memory_stats::string_size(c.get_notes()) +
+         memory_stats::string_size(c.get_notes_url()) +
+         memory_stats::string_size(c.get_plugin_output()) +
+         memory_stats::string_size(c.get_long_plugin_output()) +
+         memory_stats::string_size(c.get_perf_data()) +
+         memory_stats::string_size(c.get_timezone()) +
+         (blocks.head ? blocks.head->capacity() : 0) +
+         (blocks.tail ? blocks.tail->capacity() : 0);
+}
+
+static uint64_t host_size(host& hst) {
+  return sizeof(hst) + checkable_strings_size(hst) +
+         memory_stats::string_size(hst.get_name()) +
+         memory_stats::string_size(hst.get_alias()) +
+         memory_stats::string_size(hst.get_address());
+}
+
+static uint64_t service_size(service& svc) {
+  return sizeof(svc) + checkable_strings_size(svc) +
+         memory_stats::string_size(svc.get_hostname()) +
+         memory_stats::string_size(svc.get_description());
+}
+
+/**
+ *  Get the memory used by each subsystem.
+ *
+ *  @return One entry per subsystem.
+ */
+std::vector<memory_stats::usage> memory_stats::get_usage() {
+  std::vector<usage> retval;
+
+  usage hosts{"hosts", host::hosts.size(), 0};
+  usage host_vars{"host_custom_variables", 0, 0};
+  for (auto const& p : host::hosts) {
+    hosts.bytes += host_size(*p.second);
+    host_vars.objects += p.second->custom_variables.size();
+    host_vars.bytes += custom_variables_size(p.second->custom_variables);
+  }
+  retval.push_back(hosts);
+  retval.push_back(host_vars);
+
+  usage services{"services", service::services.size(), 0};
+  usage service_vars{"service_custom_variables", 0, 0};
+  for (auto const& p : service::services) {
+    services.bytes += service_size(*p.second);
+    service_vars.objects += p.second->custom_variables.size();
+    service_vars.bytes += custom_variables_size(p.second->custom_variables);
+  }
+  retval.push_back(services);
+  retval.push_back(service_vars);
+
+  checkable_state_store const& hst_states(checkable_state_store::hosts());
+  checkable_state_store const& svc_states(checkable_state_store::services());
+  retval.push_back(usage{
+      "checkable_states", hst_states.size() + svc_states.size(),
+      (hst_states.capacity() + svc_states.capacity()) *
+          sizeof(checkable_state)});
+
+  usage contacts{"contacts", contact::contacts.size(), 0};
+  for (auto const& p : contact::contacts) {
+    contact const& cntct(*p.second);
+    contacts.bytes += sizeof(cntct) + string_size(cntct.get_name()) +
+                      string_size(cntct.get_alias()) +
+                      string_size(cntct.get_email()) +
+                      string_size(cntct.get_pager()) +
+                      custom_variables_size(cntct.get_custom_variables());
+  }
+  retval.push_back(contacts);
+
+  usage comments{"comments", comment::comments.size(), 0};
+  for (auto const& p : comment::comments)
+    comments.bytes += sizeof(comment) + string_size(p.second->get_author()) +
+                      string_size(p.second->get_comment_data());
+  retval.push_back(comments);
+
+  auto const& dts(
+      downtimes::downtime_manager::instance().get_scheduled_downtimes());
+  usage downtimes{"downtimes", dts.size(), 0};
+  for (auto const& p : dts)
+    downtimes.bytes += sizeof(downtimes::downtime) +
+                       string_size(p.second->get_author()) +
+                       string_size(p.second->get_comment());
+  retval.push_back(downtimes);
+
+  events::loop& loop(events::loop::instance());
+  uint64_t events(loop.events_count(events::loop::low) +
+                  loop.events_count(events::loop::high));
+  retval.push_back(usage{"timed_events", events, events * sizeof(timed_event)});
+
+  uint64_t waiting, to_reap, bytes;
+  checks::checker::instance().get_check_results_usage(waiting, to_reap, bytes);
+  retval.push_back(usage{"check_results", waiting + to_reap, bytes});
+
+  nagios_macros const* mac(get_global_macros());
+  usage macros{"global_macros", 0, sizeof(*mac)};
+  for (std::string const& s : mac->x)
+    macros.bytes += string_size(s);
+  for (std::string const& s : mac->argv)
+    macros.bytes += string_size(s);
+  for (std::string const& s : mac->contactaddress)
+    macros.bytes += string_size(s);
+  macros.bytes += string_size(mac->ondemand);
+  macros.objects = mac->x.size() + mac->argv.size() +
+                   mac->contactaddress.size() + 1;
+  retval.push_back(macros);
+
+  /* Modules allocate with their own allocators, only their number is known.
+   * Their memory is part of what the resident size does not explain. */
+  retval.push_back(usage{"broker_modules",
+                         broker::loader::instance().get_modules().size(), 0});
+
+  uint64_t resident(0);
+  std::ifstream statm("/proc/self/statm");
+  uint64_t pages;
+  if (statm >> pages >> pages)
+    resident = pages * sysconf(_SC_PAGESIZE);
+  retval.push_back(usage{"process_resident", 1, resident});
+
+  return retval;
+}
+
+/**
+ *  Write the memory profile into a file: the usage of each subsystem, then
+ *  the largest hosts and services.
+ *
+ *  @param[in] path  File to write.
+ *
+ *  @return true on success.
+ */
+bool memory_stats::dump(std::string const& path) {
+  std::ofstream ofs(path, std::ios::trunc);
+  if (!ofs.is_open()) {
+    char const* msg(strerror(errno));
+    logger(log_runtime_error, basic)
+        << "Error: Unable to open memory profile file '" << path
+        << "': " << msg;
+    return false;
+  }
+
+  ofs << std::left << std::setw(28) << "subsystem" << std::right
+      << std::setw(12) << "objects" << std::setw(16) << "bytes" << '\n';
+  uint64_t total(0);
+  for (usage const& u : get_usage()) {
+    ofs << std::left << std::setw(28) << u.subsystem << std::right
+        << std::setw(12) << u.objects << std::setw(16) << u.bytes << '\n';
+    if (u.subsystem != "process_resident")
+      total += u.bytes;
+  }
+  ofs << std::left << std::setw(28) << "total_tracked" << std::right
+      << std::setw(12) << "" << std::setw(16) << total << "\n\n";
+
+  std::vector<std::pair<uint64_t, std::string> > largest;
+  for (auto const& p : host::hosts)
+    largest.emplace_back(host_size(*p.second) +
+                             custom_variables_size(p.second->custom_variables),
+                         "host " + p.first);
+  for (auto const& p : service::services)
+    largest.emplace_back(
+        service_size(*p.second) +
+            custom_variables_size(p.second->custom_variables),
+        "service " + p.first.first + ";" + p.first.second);
+  size_t count(std::min(largest.size(), largest_count));
+  std::partial_sort(largest.begin(), largest.begin() + count, largest.end(),
+                    std::greater<std::pair<uint64_t, std::string> >());
+  ofs << "largest objects\n";
+  for (size_t i(0); i < count; ++i)
+    ofs << std::right << std::setw(16) << largest[i].first << ' '
+        << largest[i].second << '\n';
+
+  ofs.close();
+  if (!ofs) {
+    logger(log_runtime_error, basic)
+        << "Error: Unable to write memory profile file '" << path << "'";
+    return false;
+  }
+  return true;
+}
+
+/**
+ *  Get the heap memory used by a string. Short strings are stored in the
+ *  string object itself and use none.
+ *
+ *  @param[in] str  The string.
+ *
+ *  @return A size in bytes.
+ */
+uint64_t memory_stats::string_size(std::string const& str) noexcept {
+  return str.capacity() > std::string().capacity() ? str.capacity() + 1 : 0;
+}
@@ -20,18 +20,24 @@
 
 #include "com/centreon/engine/nebmods.hh"
 #include <cerrno>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
+#include "com/centreon/engine/broker/callback_stats.hh"
 #include "com/centreon/engine/broker/loader.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/neberrors.hh"
+#include "com/centreon/engine/profiler.hh"
 #include "com/centreon/engine/utils.hh"
 
 using namespace com::centreon;
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::logging;
 
+static_assert(NEBCALLBACK_NUMITEMS <= 64,
+              "neb_callback_subscriptions cannot hold all callback types");
+
 /****************************************************************************/
 /****************************************************************************/
 /* INITIALIZATION/CLEANUP FUNCTIONS                                         */
@@ -339,6 +345,8 @@ int neb_register_callback(int callback_type,
   new_callback->priority = priority;
   new_callback->module_handle = (void*)mod_handle;
   new_callback->callback_func = callback.data;
+  new_callback->stats =
+      broker::callback_stats::instance().get(mod_handle, callback_type);
 
   /* add new function to callback list, sorted by priority (first come, first
    * served for same priority) */
@@ -365,6 +373,7 @@ int neb_register_callback(int callback_type,
       }
     }
   }
+  neb_callback_subscriptions |= uint64_t(1) << callback_type;
   return OK;
 }
 
@@ -403,6 +412,10 @@ int neb_deregister_callback(int callback_type,
   if (!callback_func)
     return NEBERROR_NOCALLBACKFUNC;
 
+  /* make sure the callback type is within bounds */
+  if (callback_type < 0 || callback_type >= NEBCALLBACK_NUMITEMS)
+    return NEBERROR_CALLBACKBOUNDS;
+
   /* find the callback to remove */
   for (temp_callback = last_callback = neb_callback_list[callback_type];
        temp_callback != NULL; temp_callback = next_callback) {
@@ -425,12 +438,14 @@ int neb_deregister_callback(int callback_type,
     return NEBERROR_CALLBACKNOTFOUND;
 
   else {
-    /* only one item in the list */
+    /* first item in the list */
     if (temp_callback != last_callback->next)
-      neb_callback_list[callback_type] = nullptr;
+      neb_callback_list[callback_type] = next_callback;
     else
       last_callback->next = next_callback;
     delete temp_callback;
+    if (!neb_callback_list[callback_type])
+      neb_callback_subscriptions &= ~(uint64_t(1) << callback_type);
   }
 
   return OK;
@@ -460,7 +475,14 @@ int neb_make_callbacks(int callback_type, void* data) {
       void* data;
     } neb;
     neb.data = temp_callback->callback_func;
+    std::chrono::steady_clock::time_point start{
+        std::chrono::steady_clock::now()};
     cbresult = (*neb.func)(callback_type, data);
+    std::chrono::nanoseconds elapsed{std::chrono::steady_clock::now() -
+                                     start};
+    broker::callback_stats::instance().record(temp_callback->stats, elapsed);
+    if (profiler::enabled())
+      profiler::record(profiler::neb_callback, elapsed);
 
     total_callbacks++;
     logger(dbg_eventbroker, most)
@@ -486,6 +508,7 @@ int neb_init_callback_list() {
   /* initialize list pointers */
   for (int x = 0; x < NEBCALLBACK_NUMITEMS; x++)
     neb_callback_list[x] = nullptr;
+  neb_callback_subscriptions = 0;
   return OK;
 }
 
@@ -503,6 +526,7 @@ int neb_free_callback_list() {
 
     neb_callback_list[x] = nullptr;
   }
+  neb_callback_subscriptions = 0;
 
   return OK;
 }
@@ -31,6 +31,7 @@
 #include "com/centreon/engine/macros.hh"
 #include "com/centreon/engine/neberrors.hh"
 #include "com/centreon/engine/notification.hh"
+#include "com/centreon/engine/profiler.hh"
 #include "com/centreon/engine/timezone_locker.hh"
 #include "com/centreon/engine/utils.hh"
 
@@ -62,6 +63,7 @@ std::array<notifier::is_viable, 6> const notifier::_is_notification_viable{{
 }};
 
 uint64_t notifier::_next_notification_id{1L};
+uint64_t notifier::_next_generation{1L};
 
 notifier::notifier(notifier::notifier_type notifier_type,
                    std::string const& display_name,
@@ -96,7 +98,10 @@ notifier::notifier(notifier::notifier_type notifier_type,
                    bool retain_status_information,
                    bool retain_nonstatus_information,
                    bool is_volatile)
-    : checkable{display_name,
+    : checkable{notifier_type == host_notification
+                    ? checkable_state_store::hosts()
+                    : checkable_state_store::services(),
+                display_name,
                 check_command,
                 checks_enabled,
                 accept_passive_checks,
@@ -152,9 +157,12 @@ notifier::notifier(notifier::notifier_type notifier_type,
       _is_volatile{is_volatile},
       _notification_to_interval_on_timeperiod_in{false},
       _notification_number{0},
+      _resolved_contacts_version{0},
       _notification{{}},
       _state_history{{}},
-      _pending_flex_downtime{0} {
+      _pending_flex_downtime{0},
+      _generation{_next_generation++},
+      _pending_check_results{0} {
   if (retry_interval <= 0) {
     logger(log_config_error, basic)
         << "Error: Invalid notification_interval value for notifier '"
@@ -677,6 +685,7 @@ std::unordered_set<contact*> notifier::get_contacts_to_notify(
   uint32_t notif_interv{_notification_interval};
 
   /* Let's start looking at escalations */
+  std::unordered_set<contact*> checked;
   for (auto* e : _escalations) {
     if (e->is_viable(get_current_state_int(), _notification_number)) {
       /* Among escalations, we choose the smallest notification interval. */
@@ -690,53 +699,45 @@ std::unordered_set<contact*> notifier::get_contacts_to_notify(
         notif_interv = e->get_notification_interval();
       }
 
-      /* For each contact group, we also add its contacts. */
-      for (contactgroup_map_unsafe::const_iterator
-               cgit{e->get_contactgroups().begin()},
-           cgend{e->get_contactgroups().end()};
-           cgit != cgend; ++cgit) {
-        for (contact_map_unsafe::const_iterator
-                 cit{cgit->second->get_members().begin()},
-             cend{cgit->second->get_members().end()};
-             cit != cend; ++cit) {
-          assert(cit->second);
-          if (cit->second->should_be_notified(cat, type, *this))
-            retval.insert(cit->second);
-        }
-      }
+      /* Contacts shared by several escalations are only checked once. */
+      for (contact* c : e->get_resolved_contacts())
+        if (checked.insert(c).second && c->should_be_notified(cat, type, *this))
+          retval.insert(c);
     }
   }
 
   if (!escalated) {
-    /* Construction of the set containing contacts to notify. We don't know
-     * for the moment if those contacts accept notification. */
-    for (contact_map_unsafe::const_iterator it{get_contacts().begin()},
-         end{get_contacts().end()};
-         it != end; ++it) {
-      assert(it->second);
-      if (it->second->should_be_notified(cat, type, *this))
-        retval.insert(it->second);
-    }
-
-    /* For each contact group, we also add its contacts. */
-    for (contactgroup_map_unsafe::const_iterator
-             it{get_contactgroups().begin()},
-         end{get_contactgroups().end()};
-         it != end; ++it) {
-      for (contact_map_unsafe::const_iterator
-               cit{it->second->get_members().begin()},
-           cend{it->second->get_members().end()};
-           cit != cend; ++cit) {
-        assert(cit->second);
-        if (cit->second->should_be_notified(cat, type, *this))
-          retval.insert(cit->second);
-      }
-    }
+    /* Direct contacts and contact group members, without duplicates. We
+     * don't know for the moment if those contacts accept notification. */
+    for (contact* c : get_resolved_contacts())
+      if (c->should_be_notified(cat, type, *this))
+        retval.insert(c);
   }
   notification_interval = notif_interv;
   return retval;
 }
 
+/**
+ * @brief Get the direct contacts of the notifier and the members of its
+ * contact groups, each contact once. The list is built again only when
+ * contact memberships changed since the last call.
+ *
+ * @return A list of contacts.
+ */
+std::vector<contact*> const& notifier::get_resolved_contacts() {
+  if (_resolved_contacts_version != contactgroup::get_members_version()) {
+    std::unordered_set<contact*> seen;
+    _resolved_contacts.clear();
+    for (auto const& p : _contacts)
+      if (p.second && seen.insert(p.second).second)
+        _resolved_contacts.push_back(p.second);
+    contactgroup::flatten(_contact_groups, _resolved_contacts, seen);
+    _resolved_contacts.shrink_to_fit();
+    _resolved_contacts_version = contactgroup::get_members_version();
+  }
+  return _resolved_contacts;
+}
+
 notifier::notification_category notifier::get_category(reason_type type) {
   if (type == 99)
     return cat_custom;
@@ -758,6 +759,7 @@ int notifier::notify(notifier::reason_type type,
                      std::string const& not_data,
                      notification_option options) {
   logger(dbg_functions, basic) << "notifier::notify()";
+  profiler::scope timer{profiler::notification};
   notification_category cat{get_category(type)};
 
   /* Has this notification got sense? */
@@ -1243,6 +1245,7 @@ void notifier::resolve(int& w, int& e) {
     } else
       it->second = found_it->second.get();
   }
+  contactgroup::members_changed();
 
   // Check notification timeperiod.
   if (!get_notification_period().empty()) {
@@ -1301,6 +1304,29 @@ void notifier::dec_pending_flex_downtime() noexcept {
   --_pending_flex_downtime;
 }
 
+/**
+ * @brief Get the generation of this notifier. It identifies this object among
+ * all the notifiers created since the start, so a check result can be matched
+ * with its notifier even after a reload freed it.
+ *
+ * @return A number greater than 0.
+ */
+uint64_t notifier::get_generation() const noexcept {
+  return _generation;
+}
+
+uint32_t notifier::get_pending_check_results() const noexcept {
+  return _pending_check_results;
+}
+
+void notifier::inc_pending_check_results() noexcept {
+  ++_pending_check_results;
+}
+
+void notifier::dec_pending_check_results() noexcept {
+  --_pending_check_results;
+}
+
 /**
  * @brief Calculates next acceptable re-notification time for this notifier.
  *
@@ -0,0 +1,263 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/perfdata.hh"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+using namespace com::centreon::engine;
+
+/**
+ *  Check if a character ends a metric.
+ */
+static inline bool is_space(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/**
+ *  Check if a character ends a metric field.
+ */
+static inline bool is_field_end(char c) {
+  return c == ';' || c == '\0' || is_space(c);
+}
+
+/**
+ *  Parse a number, NaN if there is no number before the field end.
+ *
+ *  @param[in,out] p  Where to start, moved after the number.
+ *
+ *  @return The number.
+ */
+static double parse_number(char const*& p) {
+  char* end;
+  double retval{std::strtod(p, &end)};
+  if (end == p || (!is_field_end(*end) && *end != ':'))
+    retval = NAN;
+  p = end;
+  return retval;
+}
+
+/**
+ *  Parse a Nagios threshold range ("10", "10:", "~:10", "@10:20").
+ *
+ *  @param[in,out] p  Where to start, moved at the end of the field.
+ *
+ *  @return The range, low and high are NaN if it is empty or invalid.
+ */
+static perfdata::range parse_range(char const*& p) {
+  perfdata::range retval{NAN, NAN, false};
+  if (*p == '@') {
+    retval.inside = true;
+    ++p;
+  }
+  if (is_field_end(*p))
+    return retval;
+
+  char const* colon{p};
+  while (!is_field_end(*colon) && *colon != ':')
+    ++colon;
+  if (*colon == ':') {
+    if (*p == '~') {
+      retval.low = -INFINITY;
+      ++p;
+    } else if (p == colon)
+      retval.low = 0.0;
+    else
+      retval.low = parse_number(p);
+    p = colon + 1;
+    retval.high = is_field_end(*p) ? INFINITY : parse_number(p);
+  } else {
+    retval.low = 0.0;
+    retval.high = parse_number(p);
+  }
+  while (!is_field_end(*p))
+    ++p;
+  return retval;
+}
+
+/**
+ *  Check if the metric label is the given one.
+ *
+ *  @param[in] name  Label to compare with.
+ *
+ *  @return True if they are equal.
+ */
+bool perfdata::metric::label_is(std::string const& name) const noexcept {
+  return label_size == name.size() &&
+         std::memcmp(label, name.data(), label_size) == 0;
+}
+
+/**
+ *  Parse a perfdata string. Malformed metrics are skipped.
+ *
+ *  @param[in] perfdata  The perfdata, it must stay unchanged while metrics
+ *                       are used.
+ */
+void perfdata::parse(std::string const& perfdata) {
+  _metrics.clear();
+  _unescaped_labels.clear();
+  char const* p{perfdata.c_str()};
+  for (;;) {
+    while (is_space(*p))
+      ++p;
+    if (!*p)
+      break;
+
+    metric m;
+    m.text = p;
+    m.type = '\0';
+
+    /* Label, quotes are doubled inside a quoted label. */
+    char const* label_end;
+    bool escaped{false};
+    if (*p == '\'') {
+      m.label = ++p;
+      while (*p && (*p != '\'' || p[1] == '\'')) {
+        if (*p == '\'') {
+          escaped = true;
+          ++p;
+        }
+        ++p;
+      }
+      label_end = p;
+      if (*p)
+        ++p;
+
+      /* Metric type inside the quotes: "'d[label]'". */
+      if (label_end - m.label >= 3 &&
+          (*m.label == 'a' || *m.label == 'd' || *m.label == 'g') &&
+          m.label[1] == '[' && label_end[-1] == ']') {
+        m.type = *m.label;
+        m.label += 2;
+        --label_end;
+      }
+    } else {
+      m.label = p;
+      /* Metric type: "d[label]=", the label may contain spaces but it ends
+       * at the first '='. */
+      char const* bracket{nullptr};
+      if ((*p == 'a' || *p == 'd' || *p == 'g') && p[1] == '[') {
+        bracket = p + 2;
+        while (*bracket && *bracket != '=' && *bracket != ']')
+          ++bracket;
+        if (*bracket != ']' || bracket[1] != '=')
+          bracket = nullptr;
+      }
+      if (bracket) {
+        m.type = *p;
+        m.label = p + 2;
+        p = bracket + 1;
+        label_end = bracket;
+      } else {
+        while (*p && *p != '=' && !is_space(*p))
+          ++p;
+        label_end = p;
+      }
+    }
+    m.label_size = label_end - m.label;
+
+    if (*p != '=' || !m.label_size) {
+      while (*p && !is_space(*p))
+        ++p;
+      continue;
+    }
+    ++p;
+
+    /* Labels with doubled quotes are the only ones copied. They are shorter
+     * than the perfdata, so the buffer is never reallocated once reserved. */
+    if (escaped) {
+      if (_unescaped_labels.empty())
+        _unescaped_labels.reserve(perfdata.size());
+      size_t offset{_unescaped_labels.size()};
+      for (char const* c = m.label; c < label_end; ++c) {
+        _unescaped_labels.push_back(*c);
+        if (*c == '\'')
+          ++c;
+      }
+      m.label = _unescaped_labels.data() + offset;
+      m.label_size = _unescaped_labels.size() - offset;
+    }
+
+    /* Value and unit, strtod() would skip spaces after the '='. */
+    char* end{const_cast<char*>(p)};
+    if (!is_space(*p))
+      m.value = std::strtod(p, &end);
+    if (end == p)
+      m.value = NAN;
+    p = end;
+    m.uom = p;
+    while (!is_field_end(*p))
+      ++p;
+    m.uom_size = p - m.uom;
+
+    /* Thresholds and bounds. */
+    m.warning = {NAN, NAN, false};
+    m.critical = {NAN, NAN, false};
+    m.min = NAN;
+    m.max = NAN;
+    if (*p == ';')
+      m.warning = parse_range(++p);
+    if (*p == ';')
+      m.critical = parse_range(++p);
+    if (*p == ';' && !is_field_end(*++p))
+      m.min = parse_number(p);
+    while (!is_field_end(*p))
+      ++p;
+    if (*p == ';' && !is_field_end(*++p))
+      m.max = parse_number(p);
+    while (*p && !is_space(*p))
+      ++p;
+
+    m.text_size = p - m.text;
+    _metrics.push_back(m);
+  }
+}
+
+/**
+ *  Remove all the metrics, the memory is kept.
+ */
+void perfdata::clear() noexcept {
+  _metrics.clear();
+  _unescaped_labels.clear();
+}
+
+/**
+ *  Get the parsed metrics.
+ *
+ *  @return The metrics, in the perfdata order.
+ */
+std::vector<perfdata::metric> const& perfdata::metrics() const noexcept {
+  return _metrics;
+}
+
+/**
+ *  Find a metric by its label.
+ *
+ *  @param[in] label  The metric label, without quotes nor type.
+ *
+ *  @return The first metric with this label or nullptr.
+ */
+perfdata::metric const* perfdata::find(std::string const& label) const
+    noexcept {
+  for (metric const& m : _metrics)
+    if (m.label_is(label))
+      return &m;
+  return nullptr;
+}
@@ -0,0 +1,210 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/profiler.hh"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace com::centreon::engine;
+
+constexpr std::array<uint64_t, 7> profiler::bounds;
+std::atomic<bool> profiler::_enabled{false};
+
+namespace {
+/* Counters of one thread. Only the thread owning them writes them, the
+ * atomics let the statistics be read from another thread. */
+struct thread_counters {
+  struct counters {
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> total_ns;
+    std::atomic<uint64_t> max_ns;
+    std::array<std::atomic<uint64_t>, profiler::bounds.size() + 1> histogram;
+  };
+
+  thread_counters() : in_use{true}, generation{0} { clear(); }
+  void clear() noexcept {
+    for (counters& c : phases) {
+      c.calls.store(0, std::memory_order_relaxed);
+      c.total_ns.store(0, std::memory_order_relaxed);
+      c.max_ns.store(0, std::memory_order_relaxed);
+      for (std::atomic<uint64_t>& b : c.histogram)
+        b.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  std::atomic<bool> in_use;
+  /* Counters of an older generation were reset since. */
+  std::atomic<uint64_t> generation;
+  std::array<counters, profiler::phase_count> phases;
+};
+
+/* Counters of all the threads. Counters of an exited thread are kept and
+ * given to the next thread. Never destroyed: threads may still record while
+ * the engine exits. */
+struct registry {
+  std::mutex m;
+  std::vector<std::unique_ptr<thread_counters> > counters;
+};
+
+registry& get_registry() {
+  static registry* r = new registry;
+  return *r;
+}
+
+/* Incremented by reset(). */
+std::atomic<uint64_t> current_generation{1};
+
+/* Give back the counters of the thread when it exits. */
+struct counters_owner {
+  thread_counters* counters = nullptr;
+  ~counters_owner() {
+    if (counters)
+      counters->in_use.store(false, std::memory_order_release);
+  }
+};
+
+/**
+ *  Get the counters of the current thread, attached on the first call.
+ *
+ *  @return The counters, null if they could not be allocated.
+ */
+thread_counters* local_counters() noexcept {
+  static thread_local counters_owner owner;
+  if (!owner.counters) {
+    registry& r(get_registry());
+    try {
+      std::lock_guard<std::mutex> lock(r.m);
+      for (std::unique_ptr<thread_counters>& c : r.counters)
+        if (!c->in_use.load(std::memory_order_acquire)) {
+          c->in_use.store(true, std::memory_order_relaxed);
+          owner.counters = c.get();
+          break;
+        }
+      if (!owner.counters) {
+        r.counters.emplace_back(new thread_counters);
+        owner.counters = r.counters.back().get();
+      }
+    } catch (...) {
+    }
+  }
+  return owner.counters;
+}
+}  // namespace
+
+/**
+ *  Enable or disable the profiling. Counters are reset when it is
+ *  enabled, so the statistics cover the time since then.
+ *
+ *  @param[in] enabled  true to enable.
+ */
+void profiler::set_enabled(bool enabled) noexcept {
+  if (enabled && !_enabled.load())
+    reset();
+  _enabled.store(enabled);
+}
+
+/**
+ *  Account one execution of a phase in the counters of the current thread.
+ *
+ *  @param[in] p        The phase.
+ *  @param[in] elapsed  Its duration.
+ */
+void profiler::record(phase p, std::chrono::nanoseconds elapsed) noexcept {
+  thread_counters* local = local_counters();
+  if (!local)
+    return;
+  uint64_t generation = current_generation.load(std::memory_order_relaxed);
+  if (local->generation.load(std::memory_order_relaxed) != generation) {
+    local->clear();
+    local->generation.store(generation, std::memory_order_release);
+  }
+
+  /* A single thread writes these counters, no read-modify-write is
+   * needed. */
+  thread_counters::counters& c = local->phases[p];
+  uint64_t ns = elapsed.count();
+  c.calls.store(c.calls.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+  c.total_ns.store(c.total_ns.load(std::memory_order_relaxed) + ns,
+                   std::memory_order_relaxed);
+  if (ns > c.max_ns.load(std::memory_order_relaxed))
+    c.max_ns.store(ns, std::memory_order_relaxed);
+
+  uint64_t us = ns / 1000;
+  size_t idx = 0;
+  while (idx < bounds.size() && us >= bounds[idx])
+    ++idx;
+  c.histogram[idx].store(c.histogram[idx].load(std::memory_order_relaxed) + 1,
+                         std::memory_order_relaxed);
+}
+
+/**
+ *  Sum the counters of all the threads.
+ *
+ *  @return The statistics of each phase, indexed by phase.
+ */
+std::array<profiler::phase_stat, profiler::phase_count> profiler::get_stats() {
+  std::array<phase_stat, phase_count> retval{};
+  uint64_t generation = current_generation.load();
+  registry& r(get_registry());
+  std::lock_guard<std::mutex> lock(r.m);
+  for (std::unique_ptr<thread_counters> const& t : r.counters) {
+    if (t->generation.load(std::memory_order_acquire) != generation)
+      continue;
+    for (size_t i = 0; i < phase_count; ++i) {
+      thread_counters::counters const& c = t->phases[i];
+      phase_stat& s = retval[i];
+      s.calls += c.calls.load(std::memory_order_relaxed);
+      s.total_ns += c.total_ns.load(std::memory_order_relaxed);
+      uint64_t max = c.max_ns.load(std::memory_order_relaxed);
+      if (max > s.max_ns)
+        s.max_ns = max;
+      for (size_t j = 0; j < s.histogram.size(); ++j)
+        s.histogram[j] += c.histogram[j].load(std::memory_order_relaxed);
+    }
+  }
+  return retval;
+}
+
+/**
+ *  Reset the counters. Each thread clears its own counters on its next
+ *  record, until then they are ignored.
+ */
+void profiler::reset() noexcept {
+  ++current_generation;
+}
+
+/**
+ *  Get the name of a phase.
+ *
+ *  @param[in] p  The phase.
+ *
+ *  @return A static string.
+ */
+char const* profiler::phase_name(phase p) noexcept {
+  static char const* const names[phase_count]{
+      "event_dispatch", "macro_expansion", "command_spawn",
+      "output_parsing", "result_handling", "neb_callback",
+      "notification",   "status_dump",     "retention_dump",
+      "configuration_apply"};
+  if (p < 0 || p >= phase_count)
+    return "unknown";
+  return names[p];
+}
@@ -62,7 +62,7 @@ void applier::comment::_add_host_comment(
       static_cast<engine::comment::src>(obj.source()), obj.expires(),
       obj.expire_time(), obj.comment_id())};
 
-  engine::comment::comments.insert({com->get_comment_id(), com});
+  engine::comment::insert_comment(com);
 
   // acknowledgement comments get deleted if they're not persistent
   // and the original problem is no longer acknowledged.
@@ -97,7 +97,7 @@ void applier::comment::_add_service_comment(
       static_cast<engine::comment::src>(obj.source()), obj.expires(),
       obj.expire_time(), obj.comment_id())};
 
-  engine::comment::comments.insert({com->get_comment_id(), com});
+  engine::comment::insert_comment(com);
 
   // acknowledgement comments get deleted if they're not persistent
   // and the original problem is no longer acknowledged.
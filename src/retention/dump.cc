@@ -30,6 +30,7 @@
 #include "com/centreon/engine/exceptions/error.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/profiler.hh"
 
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::configuration::applier;
@@ -543,6 +544,7 @@ std::ostream& dump::program(std::ostream& os) {
 bool dump::save(std::string const& path) {
   if (!config->retain_state_information())
     return true;
+  profiler::scope timer{profiler::retention_dump};
 
   // send data to event broker
   broker_retention_data(NEBTYPE_RETENTIONDATA_STARTSAVE, NEBFLAG_NONE,
@@ -19,10 +19,13 @@
 
 #include "com/centreon/engine/service.hh"
 
+#include <algorithm>
 #include <iomanip>
 
 #include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/checks/check_result_pool.hh"
 #include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/checks/exec_time_estimator.hh"
 #include "com/centreon/engine/deleter/listmember.hh"
 #include "com/centreon/engine/downtimes/downtime_manager.hh"
 #include "com/centreon/engine/events/loop.hh"
@@ -38,6 +41,7 @@
 #include "com/centreon/engine/neberrors.hh"
 #include "com/centreon/engine/notification.hh"
 #include "com/centreon/engine/objects.hh"
+#include "com/centreon/engine/profiler.hh"
 #include "com/centreon/engine/sehandlers.hh"
 #include "com/centreon/engine/shared.hh"
 #include "com/centreon/engine/string.hh"
@@ -957,6 +961,7 @@ std::string const& service::get_check_command_args() const {
 }
 
 int service::handle_async_check_result(check_result* queued_check_result) {
+  profiler::scope timer{profiler::result_handling};
   time_t next_service_check = 0L;
   time_t preferred_time = 0L;
   time_t next_valid_time = 0L;
@@ -1066,6 +1071,8 @@ int service::handle_async_check_result(check_result* queued_check_result) {
   set_latency(queued_check_result->get_latency());
 
   set_execution_time(execution_time);
+  if (queued_check_result->get_check_type() == check_active)
+    checks::exec_time_estimator::instance().add(*this, execution_time);
 
   /* get the last check time */
   set_last_check(queued_check_result->get_start_time().tv_sec);
@@ -1220,8 +1227,7 @@ int service::handle_async_check_result(check_result* queued_check_result) {
       /* set a flag to remember that we launched a check */
       first_host_check_initiated = true;
 
-      hst->run_async_check(CHECK_OPTION_NONE, 0.0, false, false, nullptr,
-                           nullptr);
+      hst->request_check(queued_check_result->get_finish_time().tv_sec);
     }
   }
 
@@ -1386,8 +1392,7 @@ int service::handle_async_check_result(check_result* queued_check_result) {
 
         /* else launch an async (parallel) check of the host */
         else
-          hst->run_async_check(CHECK_OPTION_NONE, 0.0, false, false, nullptr,
-                               nullptr);
+          hst->request_check(queued_check_result->get_finish_time().tv_sec);
       }
     }
 
@@ -1497,8 +1502,7 @@ int service::handle_async_check_result(check_result* queued_check_result) {
       else if (state_change) {
         /* use current host state as route result */
         route_result = hst->get_current_state();
-        hst->run_async_check(CHECK_OPTION_NONE, 0.0, false, false, nullptr,
-                             nullptr);
+        hst->request_check(queued_check_result->get_finish_time().tv_sec);
       }
 
       /* ADDED 02/15/08 */
@@ -1526,8 +1530,7 @@ int service::handle_async_check_result(check_result* queued_check_result) {
         /* previous logic was to simply run a sync (serial) host check */
         /* use current host state as route result */
         route_result = hst->get_current_state();
-        hst->run_async_check(CHECK_OPTION_NONE, 0.0, false, false, nullptr,
-                             nullptr);
+        hst->request_check(queued_check_result->get_finish_time().tv_sec);
         /*perform_on_demand_host_check(hst,&route_result,CHECK_OPTION_NONE,true,config->cached_host_check_horizon());
          */
       }
@@ -2323,8 +2326,7 @@ int service::run_async_check(int check_options,
   grab_host_macros_r(macros, get_host_ptr());
   grab_service_macros_r(macros, this);
   std::string tmp;
-  get_raw_command_line_r(macros, get_check_command_ptr(),
-                         get_check_command().c_str(), tmp, 0);
+  get_check_command_line_r(macros, this, tmp, 0);
 
   // Time to start command.
   gettimeofday(&start_time, nullptr);
@@ -2354,6 +2356,11 @@ int service::run_async_check(int check_options,
 
   // Service check was override by neb_module.
   if (NEBERROR_CALLBACKOVERRIDE == res) {
+    // The module gives the result, the check is orphaned if it does not.
+    checks::checker::instance().add_check_without_command(
+        service_check, this,
+        start_time.tv_sec + config->service_check_timeout() +
+            DEFAULT_ORPHAN_CHECK_GRACE);
     clear_volatile_macros_r(macros);
     return OK;
   }
@@ -2364,13 +2371,13 @@ int service::run_async_check(int check_options,
                      start_time.tv_sec);
 
   bool retry;
-  std::unique_ptr<check_result> check_result_info;
+  checks::check_result_pool::pointer check_result_info;
   do {
     // Init check result info.
-    check_result_info.reset(
-        new check_result(service_check, this, checkable::check_active,
-                         check_options, reschedule_check, latency, start_time,
-                         start_time, false, true, service::state_ok, ""));
+    check_result_info.reset(checks::check_result_pool::instance().get(
+        service_check, this, checkable::check_active, check_options,
+        reschedule_check, latency, start_time, start_time, false, true,
+        service::state_ok, ""));
 
     retry = false;
     try {
@@ -2379,7 +2386,9 @@ int service::run_async_check(int check_options,
           cmd->run(processed_cmd, *macros, config->service_check_timeout());
       if (id != 0)
         checks::checker::instance().add_check_result(
-            id, check_result_info.release());
+            id, check_result_info.release(),
+            start_time.tv_sec + config->service_check_timeout() +
+                DEFAULT_ORPHAN_CHECK_GRACE);
     } catch (com::centreon::exceptions::interruption const& e) {
       retry = true;
     } catch (std::exception const& e) {
@@ -2566,7 +2575,7 @@ void service::set_flap(double percent_change,
                   _service_id, time(nullptr), "(Centreon Engine Process)",
                   oss.str(), false, comment::internal, false, (time_t)0)};
 
-  comment::comments.insert({com->get_comment_id(), com});
+  comment::insert_comment(com);
 
   this->set_flapping_comment_id(com->get_comment_id());
 
@@ -2681,9 +2690,11 @@ void service::disable_flap_detection() {
 }
 
 /**
- * @brief Updates service status info. Send data to event broker.
+ * @brief Updates service status info. Send data to event broker and mark
+ *        the status file block of the service to be rendered again.
  */
 void service::update_status() {
+  get_status_blocks().dirty = true;
   broker_service_status(NEBTYPE_SERVICESTATUS_UPDATE, NEBFLAG_NONE,
                         NEBATTR_NONE, this, nullptr);
 }
@@ -2989,22 +3000,15 @@ bool service::is_valid_escalation_for_notification(escalation const* e,
   return true;
 }
 
-/* tests whether or not a service's check results are fresh */
-bool service::is_result_fresh(time_t current_time, int log_this) {
-  int freshness_threshold;
-  time_t expiration_time = 0L;
-  int days = 0;
-  int hours = 0;
-  int minutes = 0;
-  int seconds = 0;
-  int tdays = 0;
-  int thours = 0;
-  int tminutes = 0;
-  int tseconds = 0;
-
-  logger(dbg_checks, most) << "Checking freshness of service '"
-                           << this->get_description() << "' on host '"
-                           << this->get_hostname() << "'...";
+/**
+ *  Compute the time the last check result of the service becomes stale.
+ *
+ *  @param[out] freshness_threshold  The threshold used, in seconds.
+ *
+ *  @return The expiration time.
+ */
+time_t service::get_freshness_expiration(int& freshness_threshold) {
+  time_t expiration_time;
 
   /* use user-supplied freshness threshold or auto-calculate a freshness
    * threshold to use? */
@@ -3020,10 +3024,6 @@ bool service::is_result_fresh(time_t current_time, int log_this) {
   } else
     freshness_threshold = this->get_freshness_threshold();
 
-  logger(dbg_checks, most) << "Freshness thresholds: service="
-                           << this->get_freshness_threshold()
-                           << ", use=" << freshness_threshold;
-
   /* calculate expiration time */
   /* CHANGED 11/10/05 EG - program start is only used in expiration time
    * calculation if > last check AND active checks are enabled, so active checks
@@ -3047,6 +3047,30 @@ bool service::is_result_fresh(time_t current_time, int log_this) {
         (config->max_service_check_spread() * config->interval_length()));
   else
     expiration_time = (time_t)(get_last_check() + freshness_threshold);
+  return expiration_time;
+}
+
+/* tests whether or not a service's check results are fresh */
+bool service::is_result_fresh(time_t current_time, int log_this) {
+  int freshness_threshold;
+  int days = 0;
+  int hours = 0;
+  int minutes = 0;
+  int seconds = 0;
+  int tdays = 0;
+  int thours = 0;
+  int tminutes = 0;
+  int tseconds = 0;
+
+  logger(dbg_checks, most) << "Checking freshness of service '"
+                           << this->get_description() << "' on host '"
+                           << this->get_hostname() << "'...";
+
+  time_t expiration_time(get_freshness_expiration(freshness_threshold));
+
+  logger(dbg_checks, most) << "Freshness thresholds: service="
+                           << this->get_freshness_threshold()
+                           << ", use=" << freshness_threshold;
 
   logger(dbg_checks, most) << "HBC: " << this->has_been_checked()
                            << ", PS: " << program_start
@@ -3206,53 +3230,39 @@ bool service::authorized_by_dependencies(
 /* check for services that never returned from a check... */
 void service::check_for_orphaned() {
   time_t current_time{0L};
-  time_t expected_time{0L};
 
   logger(dbg_functions, basic) << "check_for_orphaned_services()";
 
   /* get the current time */
   time(&current_time);
 
-  /* check all services... */
-  for (service_map::iterator it(service::services.begin()),
-       end(service::services.end());
-       it != end; ++it) {
-    /* skip services that are not currently executing */
-    if (!it->second->get_is_executing())
-      continue;
+  /* only the checks whose deadline is reached without result are given */
+  for (notifier* n : checks::checker::instance().get_orphaned_checks(
+           service_check, current_time)) {
+    service* svc{static_cast<service*>(n)};
 
-    /* determine the time at which the check results should have come in (allow
-     * 10 minutes slack time) */
-    expected_time =
-        (time_t)(it->second->get_next_check() + it->second->get_latency() +
-                 config->service_check_timeout() +
-                 config->check_reaper_interval() + 600);
-
-    /* this service was supposed to have executed a while ago, but for some
-     * reason the results haven't come back in... */
-    if (expected_time < current_time) {
-      /* log a warning */
-      logger(log_runtime_warning, basic)
-          << "Warning: The check of service '" << it->first.second
-          << "' on host '" << it->first.first
-          << "' looks like it was orphaned "
-             "(results never came back).  I'm scheduling an immediate check "
-             "of the service...";
+    /* log a warning */
+    logger(log_runtime_warning, basic)
+        << "Warning: The check of service '" << svc->get_description()
+        << "' on host '" << svc->get_hostname()
+        << "' looks like it was orphaned "
+           "(results never came back).  I'm scheduling an immediate check "
+           "of the service...";
 
-      logger(dbg_checks, more)
-          << "Service '" << it->first.second << "' on host '" << it->first.first
-          << "' was orphaned, so we're scheduling an immediate check...";
+    logger(dbg_checks, more)
+        << "Service '" << svc->get_description() << "' on host '"
+        << svc->get_hostname()
+        << "' was orphaned, so we're scheduling an immediate check...";
 
-      /* decrement the number of running service checks */
-      if (currently_running_service_checks > 0)
-        currently_running_service_checks--;
+    /* decrement the number of running service checks */
+    if (currently_running_service_checks > 0)
+      currently_running_service_checks--;
 
-      /* disable the executing flag */
-      it->second->set_is_executing(false);
+    /* disable the executing flag */
+    svc->set_is_executing(false);
 
-      /* schedule an immediate check of the service */
-      it->second->schedule_check(current_time, CHECK_OPTION_ORPHAN_CHECK);
-    }
+    /* schedule an immediate check of the service */
+    svc->schedule_check(current_time, CHECK_OPTION_ORPHAN_CHECK);
   }
 }
 
@@ -3272,52 +3282,61 @@ void service::check_result_freshness() {
   /* get the current time */
   time(&current_time);
 
-  /* check all services... */
-  for (service_map::iterator it(service::services.begin()),
-       end(service::services.end());
-       it != end; ++it) {
-    /* skip services we shouldn't be checking for freshness */
-    if (!it->second->get_check_freshness())
-      continue;
-
-    /* skip services that are currently executing (problems here will be caught
-     * by orphaned service check) */
-    if (it->second->get_is_executing())
+  /* only the services whose freshness deadline is reached are checked */
+  checkable_state_store& states{checkable_state_store::services()};
+  for (checkable_state* st : states.pop_freshness_due(current_time)) {
+    /* skip services we shouldn't be checking for freshness, they are
+     * watched again when their settings change */
+    if (!st->check_freshness)
       continue;
 
     /* skip services that have both active and passive checks disabled */
-    if (!it->second->get_checks_enabled() &&
-        !it->second->get_accept_passive_checks())
+    if (!st->checks_enabled && !st->accept_passive_checks)
       continue;
 
-    /* skip services that are already being freshened */
-    if (it->second->get_is_being_freshened())
+    service* svc{static_cast<service*>(st->owner)};
+
+    /* services that are currently executing (problems here will be caught
+     * by orphaned service check) or already being freshened are looked at
+     * again at the next sweep */
+    if (st->is_executing || svc->get_is_being_freshened()) {
+      states.watch_freshness(*st, current_time + 1);
       continue;
+    }
 
     // See if the time is right...
     {
-      timezone_locker lock(it->second->get_timezone());
-      if (!check_time_against_period(current_time,
-                                     it->second->check_period_ptr))
+      timezone_locker lock(svc->get_timezone());
+      if (!check_time_against_period(current_time, svc->check_period_ptr)) {
+        time_t next_valid_time;
+        get_next_valid_time(current_time, &next_valid_time,
+                            svc->check_period_ptr);
+        states.watch_freshness(*st,
+                               std::max(next_valid_time, current_time + 1));
         continue;
+      }
     }
 
     /* EXCEPTION */
     /* don't check freshness of services without regular check intervals if
      * we're using auto-freshness threshold */
-    if (it->second->get_check_interval() == 0 &&
-        it->second->get_freshness_threshold() == 0)
+    if (svc->get_check_interval() == 0 && st->freshness_threshold == 0)
       continue;
 
     /* the results for the last check of this service are stale! */
-    if (!it->second->is_result_fresh(current_time, true)) {
+    if (!svc->is_result_fresh(current_time, true)) {
       /* set the freshen flag */
-      it->second->set_is_being_freshened(true);
+      svc->set_is_being_freshened(true);
 
       /* schedule an immediate forced check of the service */
-      it->second->schedule_check(
+      svc->schedule_check(
           current_time,
           CHECK_OPTION_FORCE_EXECUTION | CHECK_OPTION_FRESHNESS_CHECK);
+      states.watch_freshness(*st, current_time + 1);
+    } else {
+      int freshness_threshold;
+      states.watch_freshness(
+          *st, svc->get_freshness_expiration(freshness_threshold) + 1);
     }
   }
 }
@@ -0,0 +1,174 @@
+/*
+** Copyright 2021 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/status_writer.hh"
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include "com/centreon/engine/logging/logger.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::logging;
+
+/**
+ *  Constructor. Start the writer thread.
+ *
+ *  @param[in] path Status file path.
+ */
+status_writer::status_writer(std::string const& path)
+    : _path{path},
+      _tmp_path{path + ".tmp"},
+      _has_pending{false},
+      _writing{false},
+      _exit{false},
+      _thread{&status_writer::_run, this} {}
+
+/**
+ *  Destructor. The write in progress is completed, a pending snapshot is
+ *  dropped.
+ */
+status_writer::~status_writer() {
+  {
+    std::lock_guard<std::mutex> lock(_m);
+    _exit = true;
+  }
+  _cv.notify_all();
+  _thread.join();
+}
+
+/**
+ *  Wait for the last published snapshot to be written.
+ */
+void status_writer::flush() {
+  std::unique_lock<std::mutex> lock(_m);
+  _cv.wait(lock, [this] { return !_has_pending && !_writing; });
+}
+
+/**
+ *  Give a new snapshot to write. It replaces the pending one if the
+ *  thread did not start to write it yet.
+ *
+ *  @param[in] data Blocks to write, in order.
+ */
+void status_writer::publish(blocks&& data) {
+  {
+    std::lock_guard<std::mutex> lock(_m);
+    _pending = std::move(data);
+    _has_pending = true;
+  }
+  _cv.notify_all();
+}
+
+/**
+ *  Writer thread.
+ */
+void status_writer::_run() {
+  std::unique_lock<std::mutex> lock(_m);
+  for (;;) {
+    _cv.wait(lock, [this] { return _exit || _has_pending; });
+    if (_exit)
+      break;
+    blocks data;
+    data.swap(_pending);
+    _has_pending = false;
+    _writing = true;
+    lock.unlock();
+
+    _write(data);
+    /* Blocks shared with objects are released out of the lock. */
+    data.clear();
+
+    lock.lock();
+    _writing = false;
+    _cv.notify_all();
+  }
+}
+
+/**
+ *  Write blocks into the temporary file and rename it over the status
+ *  file.
+ *
+ *  @param[in] data Blocks to write.
+ *
+ *  @return true on success.
+ */
+bool status_writer::_write(blocks const& data) {
+  int fd(open(_tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+              S_IRUSR | S_IWUSR | S_IRGRP));
+  if (fd == -1) {
+    char const* msg(strerror(errno));
+    logger(log_runtime_error, basic)
+        << "Error: Unable to open status data file '" << _tmp_path
+        << "': " << msg;
+    return false;
+  }
+
+  std::vector<iovec> iov;
+  iov.reserve(data.size() < IOV_MAX ? data.size() : IOV_MAX);
+  auto it(data.begin());
+  bool retval(true);
+  while (retval && it != data.end()) {
+    iov.clear();
+    for (; it != data.end() && iov.size() < IOV_MAX; ++it)
+      if (!(*it)->empty())
+        iov.push_back({const_cast<char*>((*it)->data()), (*it)->size()});
+
+    /* writev() may write less than asked: skip what was written and
+     * go on with the rest. */
+    size_t first(0);
+    while (first < iov.size()) {
+      ssize_t wb(writev(fd, &iov[first], iov.size() - first));
+      if (wb <= 0) {
+        if (wb < 0 && errno == EINTR)
+          continue;
+        char const* msg(strerror(errno));
+        logger(log_runtime_error, basic)
+            << "Error: Unable to update status data file '" << _tmp_path
+            << "': " << msg;
+        retval = false;
+        break;
+      }
+      size_t written(wb);
+      while (first < iov.size() && written >= iov[first].iov_len)
+        written -= iov[first++].iov_len;
+      if (written) {
+        iov[first].iov_base =
+            static_cast<char*>(iov[first].iov_base) + written;
+        iov[first].iov_len -= written;
+      }
+    }
+  }
+  close(fd);
+
+  if (retval && rename(_tmp_path.c_str(), _path.c_str())) {
+    char const* msg(strerror(errno));
+    logger(log_runtime_error, basic)
+        << "Error: Unable to update status data file '" << _path
+        << "': " << msg;
+    retval = false;
+  }
+  if (!retval)
+    unlink(_tmp_path.c_str());
+  return retval;
+}
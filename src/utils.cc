@@ -27,8 +27,14 @@
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <unistd.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #include <algorithm>
+#include <cctype>
 #include <cerrno>
 #include <cmath>
 #include <csignal>
@@ -43,6 +49,7 @@
 #include "com/centreon/engine/checks/checker.hh"
 #include "com/centreon/engine/commands/raw.hh"
 #include "com/centreon/engine/comment.hh"
+#include "com/centreon/engine/configuration/applier/logging.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/downtimes/downtime_manager.hh"
 #include "com/centreon/engine/events/loop.hh"
@@ -50,6 +57,7 @@
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/macros.hh"
 #include "com/centreon/engine/nebmods.hh"
+#include "com/centreon/engine/profiler.hh"
 #include "com/centreon/engine/shared.hh"
 #include "com/centreon/engine/string.hh"
 
@@ -131,19 +139,33 @@ char const* my_ctime(time_t const* t) {
   return buf;
 }
 
+/**
+ *  Fill the $ARGn$ macros. Arguments without macros are copied as they
+ *  are, the others are processed.
+ *
+ *  @param[in,out] mac            Macros.
+ *  @param[in]     argv           Parsed command arguments.
+ *  @param[in]     macro_options  Macro processing options.
+ */
+static void set_argv_macros_r(nagios_macros* mac,
+                              checkable::command_args const& argv,
+                              int macro_options) {
+  std::string arg_buffer;
+  for (size_t x = 0; x < argv.size(); ++x) {
+    if (argv[x].has_macros) {
+      process_macros_r(mac, argv[x].value, arg_buffer, macro_options);
+      mac->argv[x] = arg_buffer;
+    } else
+      mac->argv[x] = argv[x].value;
+  }
+}
+
 /* given a "raw" command, return the "expanded" or "whole" command line */
 int get_raw_command_line_r(nagios_macros* mac,
                            commands::command* cmd_ptr,
                            std::string const& cmd,
                            std::string& full_command,
                            int macro_options) {
-  char temp_arg[MAX_COMMAND_BUFFER] = "";
-  std::string arg_buffer;
-  unsigned int x = 0;
-  unsigned int y = 0;
-  int arg_index = 0;
-  int escaped = false;
-
   logger(dbg_functions, basic) << "get_raw_command_line_r()";
 
   /* clear the argv macros */
@@ -162,52 +184,45 @@ int get_raw_command_line_r(nagios_macros* mac,
 
   /* get the command arguments */
   if (!cmd.empty()) {
-    /* skip the command name (we're about to get the arguments)... */
-    for (arg_index = 0;; arg_index++) {
-      if (cmd[arg_index] == '!' || cmd[arg_index] == '\x0')
-        break;
-    }
+    checkable::command_args argv;
+    checkable::parse_command_args(cmd, argv);
+    set_argv_macros_r(mac, argv, macro_options);
+  }
 
-    /* get each command argument */
-    for (x = 0; x < MAX_COMMAND_ARGUMENTS; x++) {
-      /* we reached the end of the arguments... */
-      if (cmd[arg_index] == '\x0')
-        break;
-
-      /* get the next argument */
-      /* can't use strtok(), as that's used in process_macros... */
-      for (arg_index++, y = 0; y < sizeof(temp_arg) - 1; arg_index++) {
-        /* backslashes escape */
-        if (cmd[arg_index] == '\\' && escaped == false) {
-          escaped = true;
-          continue;
-        }
-
-        /* end of argument */
-        if ((cmd[arg_index] == '!' && escaped == false) ||
-            cmd[arg_index] == '\x0')
-          break;
-
-        /* normal of escaped char */
-        temp_arg[y] = cmd[arg_index];
-        y++;
-
-        /* clear escaped flag */
-        escaped = false;
-      }
-      temp_arg[y] = '\x0';
+  logger(dbg_commands | dbg_checks | dbg_macros, most)
+      << "Expanded Command Output: " << full_command;
 
-      /* ADDED 01/29/04 EG */
-      /* process any macros we find in the argument */
-      process_macros_r(mac, temp_arg, arg_buffer, macro_options);
+  return OK;
+}
 
-      mac->argv[x] = arg_buffer;
-    }
-  }
+/**
+ *  Same as get_raw_command_line_r() for the check command of a host or a
+ *  service, with the arguments parsed when the check command was set.
+ *
+ *  @param[in,out] mac            Macros.
+ *  @param[in]     chk            Host or service.
+ *  @param[out]    full_command   The command line.
+ *  @param[in]     macro_options  Macro processing options.
+ *
+ *  @return OK on success.
+ */
+int get_check_command_line_r(nagios_macros* mac,
+                             com::centreon::engine::checkable const* chk,
+                             std::string& full_command,
+                             int macro_options) {
+  logger(dbg_functions, basic) << "get_check_command_line_r()";
+
+  clear_argv_macros_r(mac);
+  commands::command* cmd_ptr{chk->get_check_command_ptr()};
+  if (cmd_ptr == nullptr)
+    return ERROR;
 
+  logger(dbg_commands | dbg_checks | dbg_macros, most)
+      << "Raw Command Input: " << cmd_ptr->get_command_line();
+  full_command = cmd_ptr->get_command_line();
+  set_argv_macros_r(mac, chk->get_check_command_argv(), macro_options);
   logger(dbg_commands | dbg_checks | dbg_macros, most)
       << "Expanded Command Output: " << full_command;
-
   return OK;
 }
 
@@ -248,12 +263,98 @@ void sighandler(int sig) {
 /************************* IPC FUNCTIONS **************************/
 /******************************************************************/
 
+/**
+ *  Find the first '\n', '\\' or '|' character.
+ *
+ *  @param[in] p    Where to start.
+ *  @param[in] end  Buffer end.
+ *
+ *  @return A pointer to the character found or end.
+ */
+static char const* find_split_char(char const* p, char const* end) {
+#ifdef __AVX2__
+  __m256i const nl32{_mm256_set1_epi8('\n')};
+  __m256i const bs32{_mm256_set1_epi8('\\')};
+  __m256i const pipe32{_mm256_set1_epi8('|')};
+  for (; end - p >= 32; p += 32) {
+    __m256i v{_mm256_loadu_si256(reinterpret_cast<__m256i const*>(p))};
+    uint32_t mask = _mm256_movemask_epi8(
+        _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, nl32),
+                                        _mm256_cmpeq_epi8(v, bs32)),
+                        _mm256_cmpeq_epi8(v, pipe32)));
+    if (mask)
+      return p + __builtin_ctz(mask);
+  }
+#endif
+#ifdef __SSE2__
+  __m128i const nl16{_mm_set1_epi8('\n')};
+  __m128i const bs16{_mm_set1_epi8('\\')};
+  __m128i const pipe16{_mm_set1_epi8('|')};
+  for (; end - p >= 16; p += 16) {
+    __m128i v{_mm_loadu_si128(reinterpret_cast<__m128i const*>(p))};
+    uint32_t mask = _mm_movemask_epi8(
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, nl16),
+                                  _mm_cmpeq_epi8(v, bs16)),
+                     _mm_cmpeq_epi8(v, pipe16)));
+    if (mask)
+      return p + __builtin_ctz(mask);
+  }
+#endif
+  for (; p < end; ++p)
+    if (*p == '\n' || *p == '\\' || *p == '|')
+      return p;
+  return end;
+}
+
+/**
+ *  Find the end of a check output line and its last pipe.
+ *
+ *  @param[in]  p        Line start.
+ *  @param[in]  end      Buffer end.
+ *  @param[in]  escaped  Lines are separated by "\\n" instead of '\n'.
+ *  @param[out] pipe     Last '|' of the line, nullptr if there is none.
+ *
+ *  @return The separator position or end if this is the last line.
+ */
+static char const* find_line_end(char const* p,
+                                 char const* end,
+                                 bool escaped,
+                                 char const*& pipe) {
+  pipe = nullptr;
+  for (;; ++p) {
+    p = find_split_char(p, end);
+    if (p == end)
+      return end;
+    if (*p == '|')
+      pipe = p;
+    else if (escaped ? *p == '\\' && p + 1 < end && p[1] == 'n' : *p == '\n')
+      return p;
+  }
+}
+
+/**
+ *  Remove trailing spaces, the first character is always kept.
+ *
+ *  @param[in] s    String.
+ *  @param[in] len  String length.
+ *
+ *  @return The trimmed length.
+ */
+static size_t trimmed_size(char const* s, size_t len) {
+  while (len > 1 && std::isspace(static_cast<unsigned char>(s[len - 1])))
+    --len;
+  return len;
+}
+
 /**
  * @brief Parse buffer and fill the three strings given as references:
  *    * short_output
  *    * long_output
  *    * perf_data
  *
+ * The buffer is scanned once, only stopping on newlines, backslashes and
+ * pipes, and lines are appended to the output strings without copies.
+ *
  * @param[in] buffer
  * @param[out] short_output
  * @param[out] long_output
@@ -268,82 +369,71 @@ void parse_check_output(std::string const& buffer,
                         std::string& pd_buffer,
                         bool escape_newlines_please,
                         bool newlines_are_escaped) {
+  profiler::scope timer{profiler::output_parsing};
   bool long_pipe{false};
   bool perfdata_already_filled{false};
+  char const* newline{escape_newlines_please ? "\\n" : "\n"};
+  size_t newline_size{escape_newlines_please ? 2u : 1u};
 
-  bool eof{false};
-  std::string line;
-  /* pos_line is used to cut a line
-   * start_line is the position of the line begin
-   * end_line is the position of the line end. */
-  size_t start_line{0}, end_line, pos_line;
+  char const* end{buffer.data() + buffer.size()};
+  char const* line{buffer.data()};
   int line_number{1};
-  while (!eof) {
-    if (newlines_are_escaped &&
-        (pos_line = buffer.find("\\n", start_line)) != std::string::npos) {
-      end_line = pos_line;
-      pos_line += 2;
-    } else if ((pos_line = buffer.find("\n", start_line)) !=
-               std::string::npos) {
-      end_line = pos_line;
-      pos_line++;
-    } else {
-      end_line = buffer.size();
-      eof = true;
+  for (;;) {
+    char const* pipe;
+    char const* line_end{find_line_end(line, end, newlines_are_escaped, pipe)};
+    /* Once there is no escaped newline left, the end of the buffer is split
+     * on real newlines. */
+    if (newlines_are_escaped && line_end == end) {
+      newlines_are_escaped = false;
+      line_end = find_line_end(line, end, false, pipe);
     }
-    line = buffer.substr(start_line, end_line - start_line);
-    size_t pipe;
-    if (!long_pipe)
-      pipe = line.find_last_of('|');
-    else
-      pipe = std::string::npos;
-
-    if (pipe != std::string::npos) {
-      end_line = pipe;
-      /* Let's trim the output */
-      while (end_line > 1 && std::isspace(line[end_line - 1]))
-        end_line--;
+    size_t size = line_end - line;
 
+    if (line_number == 2)
+      long_buffer.reserve(long_buffer.size() + (end - line));
+
+    if (pipe && !long_pipe) {
+      size_t pipe_pos = pipe - line;
       /* Let's trim the output */
-      pipe++;
-      while (pipe < line.size() - 1 && std::isspace(line[pipe]))
-        pipe++;
+      size_t output_size{trimmed_size(line, pipe_pos)};
+      size_t pd_pos{pipe_pos + 1};
+      while (pd_pos < size - 1 &&
+             std::isspace(static_cast<unsigned char>(line[pd_pos])))
+        ++pd_pos;
 
       if (line_number == 1) {
-        short_buffer.append(line.substr(0, end_line));
-        pd_buffer.append(line.substr(pipe));
+        short_buffer.append(line, output_size);
+        pd_buffer.append(line + pd_pos, size - pd_pos);
         perfdata_already_filled = true;
       } else {
         if (line_number > 2)
-          long_buffer.append(escape_newlines_please ? "\\n" : "\n");
-        long_buffer.append(line.substr(0, end_line));
+          long_buffer.append(newline, newline_size);
+        long_buffer.append(line, output_size);
         if (perfdata_already_filled)
-          pd_buffer.append(" ");
-        pd_buffer.append(line.substr(pipe));
+          pd_buffer.push_back(' ');
+        pd_buffer.append(line + pd_pos, size - pd_pos);
         // Now, all new lines contain perfdata.
         long_pipe = true;
       }
     } else {
       /* Let's trim the output */
-      end_line = line.size();
-      while (end_line > 1 && std::isspace(line[end_line - 1]))
-        end_line--;
-      line.erase(end_line);
+      size = trimmed_size(line, size);
       if (line_number == 1)
-        short_buffer.append(line);
-      else {
-        if (!long_pipe) {
-          if (line_number > 2)
-            long_buffer.append(escape_newlines_please ? "\\n" : "\n");
-          long_buffer.append(line);
-        } else {
-          if (perfdata_already_filled)
-            pd_buffer.append(" ");
-          pd_buffer.append(line);
-        }
+        short_buffer.append(line, size);
+      else if (!long_pipe) {
+        if (line_number > 2)
+          long_buffer.append(newline, newline_size);
+        long_buffer.append(line, size);
+      } else {
+        if (perfdata_already_filled)
+          pd_buffer.push_back(' ');
+        pd_buffer.append(line, size);
       }
     }
-    start_line = pos_line;
+
+    if (line_end == end)
+      break;
+    line = line_end + (newlines_are_escaped ? 2 : 1);
     line_number++;
   }
 }
@@ -416,6 +506,8 @@ void cleanup() {
   // Unload modules.
   if (!test_scheduling && !verify_config) {
     checks::checker::deinit();
+    // Log events still queued are sent before modules are unloaded.
+    configuration::applier::logging::instance().set_broker_backend(nullptr);
     neb_free_callback_list();
     neb_unload_all_modules(NEBMODULE_FORCE_UNLOAD, sigshutdown
                                                        ? NEBMODULE_NEB_SHUTDOWN
@@ -435,7 +527,7 @@ void cleanup() {
  */
 void free_memory(nagios_macros* mac) {
   // Free memory allocated to comments.
-  comment::comments.clear();
+  comment::clear_comments();
 
   // Free memory allocated to downtimes.
   downtimes::downtime_manager::instance().clear_scheduled_downtimes();
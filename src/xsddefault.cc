@@ -21,24 +21,27 @@
 */
 
 #include "com/centreon/engine/xsddefault.hh"
-#include <fcntl.h>
-#include <sys/stat.h>
 #include <unistd.h>
-#include <cerrno>
 #include <cstdio>
 #include <cstdlib>
 #include <iomanip>
+#include <memory>
 #include <sstream>
 #include <string>
+#include "com/centreon/engine/broker/callback_stats.hh"
 #include "com/centreon/engine/comment.hh"
 #include "com/centreon/engine/common.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/contact.hh"
 #include "com/centreon/engine/downtimes/downtime.hh"
 #include "com/centreon/engine/downtimes/downtime_manager.hh"
+#include "com/centreon/engine/events/loop.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/memory_stats.hh"
+#include "com/centreon/engine/profiler.hh"
+#include "com/centreon/engine/status_writer.hh"
 #include "com/centreon/engine/statusdata.hh"
 
 using namespace com::centreon;
@@ -46,7 +49,13 @@ using namespace com::centreon::engine;
 using namespace com::centreon::engine::downtimes;
 using namespace com::centreon::engine::configuration::applier;
 
-static int xsddefault_status_log_fd(-1);
+static std::unique_ptr<status_writer> xsddefault_writer;
+
+// Memory usage walks all the objects, its blocks are rendered again at most
+// once per interval and written as is by the dumps in between.
+static time_t const xsddefault_memory_interval(300);
+static std::string xsddefault_memory_blocks;
+static time_t xsddefault_memory_time(0);
 
 /******************************************************************/
 /********************* INIT/CLEANUP FUNCTIONS *********************/
@@ -57,19 +66,10 @@ int xsddefault_initialize_status_data() {
   if (verify_config || config->status_file().empty())
     return OK;
 
-  if (xsddefault_status_log_fd == -1) {
+  if (!xsddefault_writer) {
     // delete the old status log (it might not exist).
     unlink(config->status_file().c_str());
-
-    if ((xsddefault_status_log_fd =
-             open(config->status_file().c_str(), O_WRONLY | O_CREAT,
-                  S_IRUSR | S_IWUSR | S_IRGRP)) == -1) {
-      logger(engine::logging::log_runtime_error, engine::logging::basic)
-          << "Error: Unable to open status data file '" << config->status_file()
-          << "': " << strerror(errno);
-      return ERROR;
-    }
-    set_cloexec(xsddefault_status_log_fd);
+    xsddefault_writer.reset(new status_writer(config->status_file()));
   }
   return OK;
 }
@@ -79,15 +79,20 @@ int xsddefault_cleanup_status_data(int delete_status_data) {
   if (verify_config)
     return OK;
 
-  // delete the status log.
-  if (delete_status_data && !config->status_file().empty()) {
-    if (unlink(config->status_file().c_str()))
-      return ERROR;
+  // stop the writer before the file is removed.
+  if (xsddefault_writer) {
+    if (!delete_status_data)
+      xsddefault_writer->flush();
+    xsddefault_writer.reset();
   }
 
-  if (xsddefault_status_log_fd != -1) {
-    close(xsddefault_status_log_fd);
-    xsddefault_status_log_fd = -1;
+  // forget the memory usage and delete the status log.
+  if (delete_status_data) {
+    xsddefault_memory_blocks.clear();
+    xsddefault_memory_time = 0;
+    if (!config->status_file().empty() &&
+        unlink(config->status_file().c_str()))
+      return ERROR;
   }
   return OK;
 }
@@ -96,10 +101,411 @@ int xsddefault_cleanup_status_data(int delete_status_data) {
 /****************** STATUS DATA OUTPUT FUNCTIONS ******************/
 /******************************************************************/
 
+/**
+ *  Get the memorystatus blocks, computed again if they are older than the
+ *  memory interval.
+ *
+ *  @param[in] current_time  Time of the dump.
+ *
+ *  @return The blocks.
+ */
+static std::string const& xsddefault_memory_status(time_t current_time) {
+  if (xsddefault_memory_blocks.empty() ||
+      current_time < xsddefault_memory_time ||
+      current_time - xsddefault_memory_time >= xsddefault_memory_interval) {
+    std::ostringstream oss;
+    for (memory_stats::usage const& u : memory_stats::get_usage())
+      oss << "memorystatus {\n"
+             "\tsubsystem="
+          << u.subsystem
+          << "\n"
+             "\tobjects="
+          << u.objects
+          << "\n"
+             "\tbytes="
+          << u.bytes
+          << "\n"
+             "\t}\n\n";
+    xsddefault_memory_blocks = oss.str();
+    xsddefault_memory_time = current_time;
+  }
+  return xsddefault_memory_blocks;
+}
+
+/**
+ *  Render the status file blocks of a host. The last_update line is not
+ *  part of them: it is the same for all objects of a dump.
+ *
+ *  @param[in,out] hst The host.
+ */
+static void xsddefault_render_host_status(host& hst) {
+  checkable::status_blocks& blocks(hst.get_status_blocks());
+  std::ostringstream stream;
+  stream << "hoststatus {\n"
+            "\thost_name="
+         << hst.get_name()
+         << "\n"
+            "\tmodified_attributes="
+         << hst.get_modified_attributes()
+         << "\n"
+            "\tcheck_command="
+         << hst.get_check_command()
+         << "\n"
+            "\tcheck_period="
+         << hst.get_check_period()
+         << "\n"
+            "\tnotification_period="
+         << hst.get_notification_period()
+         << "\n"
+            "\tcheck_interval="
+         << hst.get_check_interval()
+         << "\n"
+            "\tretry_interval="
+         << hst.get_retry_interval()
+         << "\n"
+            "\tevent_handler="
+         << hst.get_event_handler()
+         << "\n"
+            "\thas_been_checked="
+         << hst.has_been_checked()
+         << "\n"
+            "\tshould_be_scheduled="
+         << hst.get_should_be_scheduled()
+         << "\n"
+            "\tcheck_execution_time="
+         << std::setprecision(3) << std::fixed
+         << hst.get_execution_time()
+         << "\n"
+            "\tcheck_latency="
+         << std::setprecision(3) << std::fixed << hst.get_latency()
+         << "\n"
+            "\tcheck_type="
+         << hst.get_check_type()
+         << "\n"
+            "\tcurrent_state="
+         << hst.get_current_state()
+         << "\n"
+            "\tlast_hard_state="
+         << hst.get_last_hard_state()
+         << "\n"
+            "\tlast_event_id="
+         << hst.get_last_event_id()
+         << "\n"
+            "\tcurrent_event_id="
+         << hst.get_current_event_id()
+         << "\n"
+            "\tcurrent_problem_id="
+         << hst.get_current_problem_id()
+         << "\n"
+            "\tlast_problem_id="
+         << hst.get_last_problem_id()
+         << "\n"
+            "\tplugin_output="
+         << hst.get_plugin_output()
+         << "\n"
+            "\tlong_plugin_output="
+         << hst.get_long_plugin_output()
+         << "\n"
+            "\tperformance_data="
+         << hst.get_perf_data()
+         << "\n"
+            "\tlast_check="
+         << static_cast<unsigned long>(hst.get_last_check())
+         << "\n"
+            "\tnext_check="
+         << static_cast<unsigned long>(hst.get_next_check())
+         << "\n"
+            "\tcheck_options="
+         << hst.get_check_options()
+         << "\n"
+            "\tcurrent_attempt="
+         << hst.get_current_attempt()
+         << "\n"
+            "\tmax_attempts="
+         << hst.get_max_attempts()
+         << "\n"
+            "\tstate_type="
+         << hst.get_state_type()
+         << "\n"
+            "\tlast_state_change="
+         << static_cast<unsigned long>(hst.get_last_state_change())
+         << "\n"
+            "\tlast_hard_state_change="
+         << static_cast<unsigned long>(hst.get_last_hard_state_change())
+         << "\n"
+            "\tlast_time_up="
+         << static_cast<unsigned long>(hst.get_last_time_up())
+         << "\n"
+            "\tlast_time_down="
+         << static_cast<unsigned long>(hst.get_last_time_down())
+         << "\n"
+            "\tlast_time_unreachable="
+         << static_cast<unsigned long>(hst.get_last_time_unreachable())
+         << "\n"
+            "\tlast_notification="
+         << static_cast<unsigned long>(hst.get_last_notification())
+         << "\n"
+            "\tnext_notification="
+         << static_cast<unsigned long>(hst.get_next_notification())
+         << "\n"
+            "\tno_more_notifications="
+         << hst.get_no_more_notifications()
+         << "\n"
+            "\tcurrent_notification_number="
+         << hst.get_notification_number()
+         << "\n"
+            "\tcurrent_notification_id="
+         << hst.get_current_notification_id()
+         << "\n"
+            "\tnotifications_enabled="
+         << hst.get_notifications_enabled()
+         << "\n"
+            "\tproblem_has_been_acknowledged="
+         << hst.get_problem_has_been_acknowledged()
+         << "\n"
+            "\tacknowledgement_type="
+         << hst.get_acknowledgement_type()
+         << "\n"
+            "\tactive_checks_enabled="
+         << hst.get_checks_enabled()
+         << "\n"
+            "\tpassive_checks_enabled="
+         << hst.get_accept_passive_checks()
+         << "\n"
+            "\tevent_handler_enabled="
+         << hst.get_event_handler_enabled()
+         << "\n"
+            "\tflap_detection_enabled="
+         << hst.get_flap_detection_enabled()
+         << "\n"
+            "\tprocess_performance_data="
+         << hst.get_process_performance_data()
+         << "\n"
+            "\tobsess_over_host="
+         << hst.get_obsess_over() << "\n";
+  blocks.head = std::make_shared<std::string const>(stream.str());
+
+  stream.str("");
+  stream << "\tis_flapping="
+         << hst.get_is_flapping()
+         << "\n"
+            "\tpercent_state_change="
+         << std::setprecision(2) << std::fixed
+         << hst.get_percent_state_change()
+         << "\n"
+            "\tscheduled_downtime_depth="
+         << hst.get_scheduled_downtime_depth() << "\n";
+
+  // custom variables
+  for (auto const& cv : hst.custom_variables) {
+    if (!cv.first.empty())
+      stream << "\t_" << cv.first << "=" << cv.second.has_been_modified()
+             << ";" << cv.second.get_value() << "\n";
+  }
+  stream << "\t}\n\n";
+  blocks.tail = std::make_shared<std::string const>(stream.str());
+  blocks.dirty = false;
+}
+
+/**
+ *  Render the status file blocks of a service. The last_update line is not
+ *  part of them: it is the same for all objects of a dump.
+ *
+ *  @param[in,out] svc The service.
+ */
+static void xsddefault_render_service_status(service& svc) {
+  checkable::status_blocks& blocks(svc.get_status_blocks());
+  std::ostringstream stream;
+  stream << "servicestatus {\n"
+            "\thost_name="
+         << svc.get_hostname()
+         << "\n"
+            "\tservice_description="
+         << svc.get_description()
+         << "\n"
+            "\tmodified_attributes="
+         << svc.get_modified_attributes()
+         << "\n"
+            "\tcheck_command="
+         << svc.get_check_command()
+         << "\n"
+            "\tcheck_period="
+         << svc.get_check_period()
+         << "\n"
+            "\tnotification_period="
+         << svc.get_notification_period()
+         << "\n"
+            "\tcheck_interval="
+         << svc.get_check_interval()
+         << "\n"
+            "\tretry_interval="
+         << svc.get_retry_interval()
+         << "\n"
+            "\tevent_handler="
+         << svc.get_event_handler()
+         << "\n"
+            "\thas_been_checked="
+         << svc.has_been_checked()
+         << "\n"
+            "\tshould_be_scheduled="
+         << svc.get_should_be_scheduled()
+         << "\n"
+            "\tcheck_execution_time="
+         << std::setprecision(3) << std::fixed
+         << svc.get_execution_time()
+         << "\n"
+            "\tcheck_latency="
+         << std::setprecision(3) << std::fixed << svc.get_latency()
+         << "\n"
+            "\tcheck_type="
+         << svc.get_check_type()
+         << "\n"
+            "\tcurrent_state="
+         << svc.get_current_state()
+         << "\n"
+            "\tlast_hard_state="
+         << svc.get_last_hard_state()
+         << "\n"
+            "\tlast_event_id="
+         << svc.get_last_event_id()
+         << "\n"
+            "\tcurrent_event_id="
+         << svc.get_current_event_id()
+         << "\n"
+            "\tcurrent_problem_id="
+         << svc.get_current_problem_id()
+         << "\n"
+            "\tlast_problem_id="
+         << svc.get_last_problem_id()
+         << "\n"
+            "\tcurrent_attempt="
+         << svc.get_current_attempt()
+         << "\n"
+            "\tmax_attempts="
+         << svc.get_max_attempts()
+         << "\n"
+            "\tstate_type="
+         << svc.get_state_type()
+         << "\n"
+            "\tlast_state_change="
+         << static_cast<unsigned long>(svc.get_last_state_change())
+         << "\n"
+            "\tlast_hard_state_change="
+         << static_cast<unsigned long>(svc.get_last_hard_state_change())
+         << "\n"
+            "\tlast_time_ok="
+         << static_cast<unsigned long>(svc.get_last_time_ok())
+         << "\n"
+            "\tlast_time_warning="
+         << static_cast<unsigned long>(svc.get_last_time_warning())
+         << "\n"
+            "\tlast_time_unknown="
+         << static_cast<unsigned long>(svc.get_last_time_unknown())
+         << "\n"
+            "\tlast_time_critical="
+         << static_cast<unsigned long>(svc.get_last_time_critical())
+         << "\n"
+            "\tplugin_output="
+         << svc.get_plugin_output()
+         << "\n"
+            "\tlong_plugin_output="
+         << svc.get_long_plugin_output()
+         << "\n"
+            "\tperformance_data="
+         << svc.get_perf_data()
+         << "\n"
+            "\tlast_check="
+         << static_cast<unsigned long>(svc.get_last_check())
+         << "\n"
+            "\tnext_check="
+         << static_cast<unsigned long>(svc.get_next_check())
+         << "\n"
+            "\tcheck_options="
+         << svc.get_check_options()
+         << "\n"
+            "\tcurrent_notification_number="
+         << svc.get_notification_number()
+         << "\n"
+            "\tcurrent_notification_id="
+         << svc.get_current_notification_id()
+         << "\n"
+            "\tlast_notification="
+         << static_cast<unsigned long>(svc.get_last_notification())
+         << "\n"
+            "\tnext_notification="
+         << static_cast<unsigned long>(svc.get_next_notification())
+         << "\n"
+            "\tno_more_notifications="
+         << svc.get_no_more_notifications()
+         << "\n"
+            "\tnotifications_enabled="
+         << svc.get_notifications_enabled()
+         << "\n"
+            "\tactive_checks_enabled="
+         << svc.get_checks_enabled()
+         << "\n"
+            "\tpassive_checks_enabled="
+         << svc.get_accept_passive_checks()
+         << "\n"
+            "\tevent_handler_enabled="
+         << svc.get_event_handler_enabled()
+         << "\n"
+            "\tproblem_has_been_acknowledged="
+         << svc.get_problem_has_been_acknowledged()
+         << "\n"
+            "\tacknowledgement_type="
+         << svc.get_acknowledgement_type()
+         << "\n"
+            "\tflap_detection_enabled="
+         << svc.get_flap_detection_enabled()
+         << "\n"
+            "\tprocess_performance_data="
+         << svc.get_process_performance_data()
+         << "\n"
+            "\tobsess_over_service="
+         << svc.get_obsess_over() << "\n";
+  blocks.head = std::make_shared<std::string const>(stream.str());
+
+  stream.str("");
+  stream << "\tis_flapping="
+         << svc.get_is_flapping()
+         << "\n"
+            "\tpercent_state_change="
+         << std::setprecision(2) << std::fixed
+         << svc.get_percent_state_change()
+         << "\n"
+            "\tscheduled_downtime_depth="
+         << svc.get_scheduled_downtime_depth() << "\n";
+
+  // custom variables
+  for (auto const& cv : svc.custom_variables) {
+    if (!cv.first.empty())
+      stream << "\t_" << cv.first << "=" << cv.second.has_been_modified()
+             << ";" << cv.second.get_value() << "\n";
+  }
+  stream << "\t}\n\n";
+  blocks.tail = std::make_shared<std::string const>(stream.str());
+  blocks.dirty = false;
+}
+
+/**
+ *  Format the 50th, 90th and 99th percentiles of the scheduled check
+ *  latencies, in seconds.
+ */
+static std::string latency_percentiles(check_source source) {
+  checks::latency_histogram const& h(
+      events::loop::instance().check_latency(source));
+  std::ostringstream oss;
+  oss << std::setprecision(3) << std::fixed << h.percentile(50) << ","
+      << h.percentile(90) << "," << h.percentile(99);
+  return oss.str();
+}
+
 /* write all status data to file */
 int xsddefault_save_status_data() {
-  if (xsddefault_status_log_fd == -1)
+  if (!xsddefault_writer)
     return OK;
+  profiler::scope timer{profiler::status_dump};
 
   int used_external_command_buffer_slots(0);
   int high_external_command_buffer_slots(0);
@@ -286,353 +692,51 @@ int xsddefault_save_status_data() {
       << check_statistics[SERIAL_HOST_CHECK_STATS].minute_stats[0] << ","
       << check_statistics[SERIAL_HOST_CHECK_STATS].minute_stats[1] << ","
       << check_statistics[SERIAL_HOST_CHECK_STATS].minute_stats[2]
+      << "\n"
+         "\twaiting_service_checks="
+      << events::loop::instance().waiting_checks_count()
+      << "\n"
+         "\tactive_host_check_latency_percentiles="
+      << latency_percentiles(host_check)
+      << "\n"
+         "\tactive_service_check_latency_percentiles="
+      << latency_percentiles(service_check)
       << "\n"
          "\t}\n\n";
 
+  // Hosts and services blocks are shared with the snapshot, so
+  // everything else is written in separate blocks.
+  status_writer::blocks blocks;
+  blocks.reserve(3 * (host::hosts.size() + service::services.size()) + 2);
+  blocks.push_back(std::make_shared<std::string const>(stream.str()));
+  stream.str("");
+
+  std::shared_ptr<std::string const> last_update{
+      std::make_shared<std::string const>(
+          "\tlast_update=" + std::to_string(current_time) + "\n")};
+
   /* save host status data */
   for (host_map::iterator it(com::centreon::engine::host::hosts.begin()),
        end(com::centreon::engine::host::hosts.end());
        it != end; ++it) {
-    stream
-        << "hoststatus {\n"
-           "\thost_name="
-        << it->second->get_name()
-        << "\n"
-           "\tmodified_attributes="
-        << it->second->get_modified_attributes()
-        << "\n"
-           "\tcheck_command="
-        << it->second->get_check_command()
-        << "\n"
-           "\tcheck_period="
-        << it->second->get_check_period()
-        << "\n"
-           "\tnotification_period="
-        << it->second->get_notification_period()
-        << "\n"
-           "\tcheck_interval="
-        << it->second->get_check_interval()
-        << "\n"
-           "\tretry_interval="
-        << it->second->get_retry_interval()
-        << "\n"
-           "\tevent_handler="
-        << it->second->get_event_handler()
-        << "\n"
-           "\thas_been_checked="
-        << it->second->has_been_checked()
-        << "\n"
-           "\tshould_be_scheduled="
-        << it->second->get_should_be_scheduled()
-        << "\n"
-           "\tcheck_execution_time="
-        << std::setprecision(3) << std::fixed
-        << it->second->get_execution_time()
-        << "\n"
-           "\tcheck_latency="
-        << std::setprecision(3) << std::fixed << it->second->get_latency()
-        << "\n"
-           "\tcheck_type="
-        << it->second->get_check_type()
-        << "\n"
-           "\tcurrent_state="
-        << it->second->get_current_state()
-        << "\n"
-           "\tlast_hard_state="
-        << it->second->get_last_hard_state()
-        << "\n"
-           "\tlast_event_id="
-        << it->second->get_last_event_id()
-        << "\n"
-           "\tcurrent_event_id="
-        << it->second->get_current_event_id()
-        << "\n"
-           "\tcurrent_problem_id="
-        << it->second->get_current_problem_id()
-        << "\n"
-           "\tlast_problem_id="
-        << it->second->get_last_problem_id()
-        << "\n"
-           "\tplugin_output="
-        << it->second->get_plugin_output()
-        << "\n"
-           "\tlong_plugin_output="
-        << it->second->get_long_plugin_output()
-        << "\n"
-           "\tperformance_data="
-        << it->second->get_perf_data()
-        << "\n"
-           "\tlast_check="
-        << static_cast<unsigned long>(it->second->get_last_check())
-        << "\n"
-           "\tnext_check="
-        << static_cast<unsigned long>(it->second->get_next_check())
-        << "\n"
-           "\tcheck_options="
-        << it->second->get_check_options()
-        << "\n"
-           "\tcurrent_attempt="
-        << it->second->get_current_attempt()
-        << "\n"
-           "\tmax_attempts="
-        << it->second->get_max_attempts()
-        << "\n"
-           "\tstate_type="
-        << it->second->get_state_type()
-        << "\n"
-           "\tlast_state_change="
-        << static_cast<unsigned long>(it->second->get_last_state_change())
-        << "\n"
-           "\tlast_hard_state_change="
-        << static_cast<unsigned long>(it->second->get_last_hard_state_change())
-        << "\n"
-           "\tlast_time_up="
-        << static_cast<unsigned long>(it->second->get_last_time_up())
-        << "\n"
-           "\tlast_time_down="
-        << static_cast<unsigned long>(it->second->get_last_time_down())
-        << "\n"
-           "\tlast_time_unreachable="
-        << static_cast<unsigned long>(it->second->get_last_time_unreachable())
-        << "\n"
-           "\tlast_notification="
-        << static_cast<unsigned long>(it->second->get_last_notification())
-        << "\n"
-           "\tnext_notification="
-        << static_cast<unsigned long>(it->second->get_next_notification())
-        << "\n"
-           "\tno_more_notifications="
-        << it->second->get_no_more_notifications()
-        << "\n"
-           "\tcurrent_notification_number="
-        << it->second->get_notification_number()
-        << "\n"
-           "\tcurrent_notification_id="
-        << it->second->get_current_notification_id()
-        << "\n"
-           "\tnotifications_enabled="
-        << it->second->get_notifications_enabled()
-        << "\n"
-           "\tproblem_has_been_acknowledged="
-        << it->second->get_problem_has_been_acknowledged()
-        << "\n"
-           "\tacknowledgement_type="
-        << it->second->get_acknowledgement_type()
-        << "\n"
-           "\tactive_checks_enabled="
-        << it->second->get_checks_enabled()
-        << "\n"
-           "\tpassive_checks_enabled="
-        << it->second->get_accept_passive_checks()
-        << "\n"
-           "\tevent_handler_enabled="
-        << it->second->get_event_handler_enabled()
-        << "\n"
-           "\tflap_detection_enabled="
-        << it->second->get_flap_detection_enabled()
-        << "\n"
-           "\tprocess_performance_data="
-        << it->second->get_process_performance_data()
-        << "\n"
-           "\tobsess_over_host="
-        << it->second->get_obsess_over()
-        << "\n"
-           "\tlast_update="
-        << static_cast<unsigned long>(current_time)
-        << "\n"
-           "\tis_flapping="
-        << it->second->get_is_flapping()
-        << "\n"
-           "\tpercent_state_change="
-        << std::setprecision(2) << std::fixed
-        << it->second->get_percent_state_change()
-        << "\n"
-           "\tscheduled_downtime_depth="
-        << it->second->get_scheduled_downtime_depth() << "\n";
-
-    // custom variables
-    for (auto const& cv : it->second->custom_variables) {
-      if (!cv.first.empty())
-        stream << "\t_" << cv.first << "=" << cv.second.has_been_modified()
-               << ";" << cv.second.get_value() << "\n";
-    }
-    stream << "\t}\n\n";
+    checkable::status_blocks& hb(it->second->get_status_blocks());
+    if (hb.dirty || !hb.head)
+      xsddefault_render_host_status(*it->second);
+    blocks.push_back(hb.head);
+    blocks.push_back(last_update);
+    blocks.push_back(hb.tail);
   }
 
   // save service status data
   for (service_map::iterator it(service::services.begin()),
        end(service::services.end());
        it != end; ++it) {
-    stream << "servicestatus {\n"
-              "\thost_name="
-           << it->second->get_hostname()
-           << "\n"
-              "\tservice_description="
-           << it->second->get_description()
-           << "\n"
-              "\tmodified_attributes="
-           << it->second->get_modified_attributes()
-           << "\n"
-              "\tcheck_command="
-           << it->second->get_check_command()
-           << "\n"
-              "\tcheck_period="
-           << it->second->get_check_period()
-           << "\n"
-              "\tnotification_period="
-           << it->second->get_notification_period()
-           << "\n"
-              "\tcheck_interval="
-           << it->second->get_check_interval()
-           << "\n"
-              "\tretry_interval="
-           << it->second->get_retry_interval()
-           << "\n"
-              "\tevent_handler="
-           << it->second->get_event_handler()
-           << "\n"
-              "\thas_been_checked="
-           << it->second->has_been_checked()
-           << "\n"
-              "\tshould_be_scheduled="
-           << it->second->get_should_be_scheduled()
-           << "\n"
-              "\tcheck_execution_time="
-           << std::setprecision(3) << std::fixed
-           << it->second->get_execution_time()
-           << "\n"
-              "\tcheck_latency="
-           << std::setprecision(3) << std::fixed << it->second->get_latency()
-           << "\n"
-              "\tcheck_type="
-           << it->second->get_check_type()
-           << "\n"
-              "\tcurrent_state="
-           << it->second->get_current_state()
-           << "\n"
-              "\tlast_hard_state="
-           << it->second->get_last_hard_state()
-           << "\n"
-              "\tlast_event_id="
-           << it->second->get_last_event_id()
-           << "\n"
-              "\tcurrent_event_id="
-           << it->second->get_current_event_id()
-           << "\n"
-              "\tcurrent_problem_id="
-           << it->second->get_current_problem_id()
-           << "\n"
-              "\tlast_problem_id="
-           << it->second->get_last_problem_id()
-           << "\n"
-              "\tcurrent_attempt="
-           << it->second->get_current_attempt()
-           << "\n"
-              "\tmax_attempts="
-           << it->second->get_max_attempts()
-           << "\n"
-              "\tstate_type="
-           << it->second->get_state_type()
-           << "\n"
-              "\tlast_state_change="
-           << static_cast<unsigned long>(it->second->get_last_state_change())
-           << "\n"
-              "\tlast_hard_state_change="
-           << static_cast<unsigned long>(
-                  it->second->get_last_hard_state_change())
-           << "\n"
-              "\tlast_time_ok="
-           << static_cast<unsigned long>(it->second->get_last_time_ok())
-           << "\n"
-              "\tlast_time_warning="
-           << static_cast<unsigned long>(it->second->get_last_time_warning())
-           << "\n"
-              "\tlast_time_unknown="
-           << static_cast<unsigned long>(it->second->get_last_time_unknown())
-           << "\n"
-              "\tlast_time_critical="
-           << static_cast<unsigned long>(it->second->get_last_time_critical())
-           << "\n"
-              "\tplugin_output="
-           << it->second->get_plugin_output()
-           << "\n"
-              "\tlong_plugin_output="
-           << it->second->get_long_plugin_output()
-           << "\n"
-              "\tperformance_data="
-           << it->second->get_perf_data()
-           << "\n"
-              "\tlast_check="
-           << static_cast<unsigned long>(it->second->get_last_check())
-           << "\n"
-              "\tnext_check="
-           << static_cast<unsigned long>(it->second->get_next_check())
-           << "\n"
-              "\tcheck_options="
-           << it->second->get_check_options()
-           << "\n"
-              "\tcurrent_notification_number="
-           << it->second->get_notification_number()
-           << "\n"
-              "\tcurrent_notification_id="
-           << it->second->get_current_notification_id()
-           << "\n"
-              "\tlast_notification="
-           << static_cast<unsigned long>(it->second->get_last_notification())
-           << "\n"
-              "\tnext_notification="
-           << static_cast<unsigned long>(it->second->get_next_notification())
-           << "\n"
-              "\tno_more_notifications="
-           << it->second->get_no_more_notifications()
-           << "\n"
-              "\tnotifications_enabled="
-           << it->second->get_notifications_enabled()
-           << "\n"
-              "\tactive_checks_enabled="
-           << it->second->get_checks_enabled()
-           << "\n"
-              "\tpassive_checks_enabled="
-           << it->second->get_accept_passive_checks()
-           << "\n"
-              "\tevent_handler_enabled="
-           << it->second->get_event_handler_enabled()
-           << "\n"
-              "\tproblem_has_been_acknowledged="
-           << it->second->get_problem_has_been_acknowledged()
-           << "\n"
-              "\tacknowledgement_type="
-           << it->second->get_acknowledgement_type()
-           << "\n"
-              "\tflap_detection_enabled="
-           << it->second->get_flap_detection_enabled()
-           << "\n"
-              "\tprocess_performance_data="
-           << it->second->get_process_performance_data()
-           << "\n"
-              "\tobsess_over_service="
-           << it->second->get_obsess_over()
-           << "\n"
-              "\tlast_update="
-           << static_cast<unsigned long>(current_time)
-           << "\n"
-              "\tis_flapping="
-           << it->second->get_is_flapping()
-           << "\n"
-              "\tpercent_state_change="
-           << std::setprecision(2) << std::fixed
-           << it->second->get_percent_state_change()
-           << "\n"
-              "\tscheduled_downtime_depth="
-           << it->second->get_scheduled_downtime_depth() << "\n";
-
-    // custom variables
-    for (auto const& cv : it->second->custom_variables) {
-      if (!cv.first.empty())
-        stream << "\t_" << cv.first << "=" << cv.second.has_been_modified()
-               << ";" << cv.second.get_value() << "\n";
-    }
-    stream << "\t}\n\n";
+    checkable::status_blocks& sb(it->second->get_status_blocks());
+    if (sb.dirty || !sb.head)
+      xsddefault_render_service_status(*it->second);
+    blocks.push_back(sb.head);
+    blocks.push_back(last_update);
+    blocks.push_back(sb.tail);
   }
 
   // save contact status data
@@ -726,36 +830,41 @@ int xsddefault_save_status_data() {
        downtime_manager::instance().get_scheduled_downtimes())
     stream << *dt.second;
 
-  // Write data in buffer.
-  stream.flush();
-
-  // Prepare status file for overwrite.
-  if ((ftruncate(xsddefault_status_log_fd, 0) == -1) ||
-      (fsync(xsddefault_status_log_fd) == -1) ||
-      (lseek(xsddefault_status_log_fd, 0, SEEK_SET) == (off_t)-1)) {
-    char const* msg(strerror(errno));
-    logger(engine::logging::log_runtime_error, engine::logging::basic)
-        << "Error: Unable to update status data file '" << config->status_file()
-        << "': " << msg;
-    return ERROR;
-  }
-
-  // Write status file.
-  std::string data(stream.str());
-  char const* data_ptr(data.c_str());
-  unsigned int size(data.size());
-  while (size > 0) {
-    ssize_t wb(write(xsddefault_status_log_fd, data_ptr, size));
-    if (wb <= 0) {
-      char const* msg(strerror(errno));
-      logger(engine::logging::log_runtime_error, engine::logging::basic)
-          << "Error: Unable to update status data file '"
-          << config->status_file() << "': " << msg;
-      return ERROR;
+  // save broker callbacks latency
+  for (broker::callback_stat const* s :
+       broker::callback_stats::instance().get_stats()) {
+    stream << "nebcallbackstatus {\n"
+              "\tmodule="
+           << s->module
+           << "\n"
+              "\tcallback_type="
+           << broker::callback_stats::callback_type_name(s->callback_type)
+           << "\n"
+              "\tcalls="
+           << s->calls.load()
+           << "\n"
+              "\ttotal_time="
+           << std::setprecision(6) << std::fixed << s->total_ns.load() / 1e9
+           << "\n"
+              "\tmax_time="
+           << std::setprecision(6) << std::fixed << s->max_ns.load() / 1e9
+           << "\n"
+              "\thistogram=";
+    for (size_t i = 0; i < s->histogram.size(); ++i) {
+      if (i)
+        stream << ",";
+      stream << s->histogram[i].load();
     }
-    data_ptr += wb;
-    size -= wb;
+    stream << "\n"
+              "\t}\n\n";
   }
 
+  // save memory usage
+  stream << xsddefault_memory_status(current_time);
+
+  blocks.push_back(std::make_shared<std::string const>(stream.str()));
+
+  // The file is written and renamed by the writer thread.
+  xsddefault_writer->publish(std::move(blocks));
   return OK;
 }
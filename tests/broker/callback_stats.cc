@@ -0,0 +1,103 @@
+/*
+ * Copyright 2021 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/engine/broker/callback_stats.hh"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "com/centreon/engine/nebcallbacks.hh"
+#include "com/centreon/engine/nebmods.hh"
+#include "helper.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::broker;
+
+static int fast_callback(int, void*) {
+  return 0;
+}
+
+static int slow_callback(int, void*) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  return 0;
+}
+
+class CallbackStats : public ::testing::Test {
+ public:
+  void SetUp() override {
+    init_config_state();
+    neb_init_callback_list();
+    callback_stats::instance().reset();
+  }
+
+  void TearDown() override {
+    neb_free_callback_list();
+    deinit_config_state();
+  }
+
+  static callback_stat const* find(int type) {
+    for (callback_stat const* s : callback_stats::instance().get_stats())
+      if (s->callback_type == type)
+        return s;
+    return nullptr;
+  }
+};
+
+TEST_F(CallbackStats, CallsAreCounted) {
+  int module;
+  ASSERT_EQ(neb_register_callback(NEBCALLBACK_COMMENT_DATA, &module, 0,
+                                  &fast_callback),
+            0);
+  for (int i = 0; i < 10; ++i)
+    neb_make_callbacks(NEBCALLBACK_COMMENT_DATA, nullptr);
+
+  callback_stat const* s = find(NEBCALLBACK_COMMENT_DATA);
+  ASSERT_NE(s, nullptr);
+  ASSERT_EQ(s->module, "unknown");
+  ASSERT_EQ(s->calls, 10u);
+  ASSERT_LE(s->max_ns, s->total_ns);
+  uint64_t sum = 0;
+  for (std::atomic<uint64_t> const& b : s->histogram)
+    sum += b;
+  ASSERT_EQ(sum, 10u);
+}
+
+TEST_F(CallbackStats, SlowCallbackInHistogram) {
+  int module;
+  config->event_broker_callback_warning_threshold(1);
+  ASSERT_EQ(neb_register_callback(NEBCALLBACK_DOWNTIME_DATA, &module, 0,
+                                  &slow_callback),
+            0);
+  neb_make_callbacks(NEBCALLBACK_DOWNTIME_DATA, nullptr);
+
+  callback_stat const* s = find(NEBCALLBACK_DOWNTIME_DATA);
+  ASSERT_NE(s, nullptr);
+  ASSERT_EQ(s->calls, 1u);
+  ASSERT_GE(s->max_ns, 2000000u);
+  /* 2ms is in the [1ms, 10ms[ bucket. */
+  ASSERT_EQ(s->histogram[3], 1u);
+}
+
+TEST_F(CallbackStats, TypeName) {
+  ASSERT_EQ(std::string(callback_stats::callback_type_name(
+                NEBCALLBACK_SERVICE_CHECK_DATA)),
+            "service_check_data");
+  ASSERT_EQ(std::string(callback_stats::callback_type_name(-1)), "unknown");
+}
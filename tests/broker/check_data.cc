@@ -0,0 +1,240 @@
+/*
+ * Copyright 2021 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "../test_engine.hh"
+#include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/configuration/applier/contact.hh"
+#include "com/centreon/engine/configuration/applier/host.hh"
+#include "com/centreon/engine/configuration/applier/service.hh"
+#include "com/centreon/engine/nebcallbacks.hh"
+#include "com/centreon/engine/nebmods.hh"
+#include "com/centreon/engine/nebstructs.hh"
+#include "com/centreon/engine/string.hh"
+#include "helper.hh"
+
+using namespace com::centreon::engine;
+
+/* Counter of the allocations made by the current thread, only set inside
+ * an allocation_counter scope. The global operator new is replaced, so
+ * these tests run in their own executable, ut_allocations. */
+static thread_local size_t* _allocations = nullptr;
+
+void* operator new(std::size_t size) {
+  if (_allocations)
+    ++*_allocations;
+  void* p = std::malloc(size ? size : 1);
+  if (!p)
+    throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+
+/* Count the allocations of the current thread during its lifetime. */
+class allocation_counter {
+  size_t _count;
+
+ public:
+  allocation_counter() : _count{0} { _allocations = &_count; }
+  ~allocation_counter() noexcept { _allocations = nullptr; }
+  allocation_counter(allocation_counter const&) = delete;
+  allocation_counter& operator=(allocation_counter const&) = delete;
+  size_t count() const noexcept { return _count; }
+};
+
+/* Copies of the last brokered command name/args, nullptr when the struct
+ * had none. Fixed buffers are used to not allocate in the callbacks. */
+static char _name_buf[128];
+static char _args_buf[128];
+static char const* _command_name;
+static char const* _command_args;
+
+static void save(char const* name, char const* args) {
+  _command_name = nullptr;
+  _command_args = nullptr;
+  if (name)
+    _command_name = strncpy(_name_buf, name, sizeof(_name_buf) - 1);
+  if (args)
+    _command_args = strncpy(_args_buf, args, sizeof(_args_buf) - 1);
+}
+
+static int check_callback(int, void* data) {
+  nebstruct_host_check_data* ds{static_cast<nebstruct_host_check_data*>(data)};
+  save(ds->command_name, ds->command_args);
+  return 0;
+}
+
+static int service_check_callback(int, void* data) {
+  nebstruct_service_check_data* ds{
+      static_cast<nebstruct_service_check_data*>(data)};
+  save(ds->command_name, ds->command_args);
+  return 0;
+}
+
+class BrokerCheckData : public TestEngine {
+ public:
+  void SetUp() override {
+    init_config_state();
+    neb_init_callback_list();
+
+    configuration::applier::contact ct_aply;
+    configuration::contact ctct{new_configuration_contact("admin", true)};
+    ct_aply.add_object(ctct);
+    ct_aply.expand_objects(*config);
+    ct_aply.resolve_object(ctct);
+
+    configuration::host hst{new_configuration_host("test_host", "admin")};
+    configuration::applier::host hst_aply;
+    hst_aply.add_object(hst);
+
+    configuration::service svc{
+        new_configuration_service("test_host", "test_svc", "admin")};
+    configuration::applier::service svc_aply;
+    svc_aply.add_object(svc);
+
+    hst_aply.resolve_object(hst);
+    svc_aply.resolve_object(svc);
+
+    _host = host::hosts.begin()->second;
+    _svc = service::services.begin()->second;
+    _command_name = nullptr;
+    _command_args = nullptr;
+    neb_register_callback(NEBCALLBACK_HOST_CHECK_DATA, this, 0,
+                          &check_callback);
+    neb_register_callback(NEBCALLBACK_SERVICE_CHECK_DATA, this, 0,
+                          &service_check_callback);
+  }
+
+  void TearDown() override {
+    _host.reset();
+    _svc.reset();
+    neb_free_callback_list();
+    deinit_config_state();
+  }
+
+  void host_check(char const* cmd) {
+    timeval tv{0, 0};
+    broker_host_check(NEBTYPE_HOSTCHECK_INITIATE, NEBFLAG_NONE, NEBATTR_NONE,
+                      _host.get(), checkable::check_active, host::state_up,
+                      checkable::hard, tv, tv, cmd, 0.0, 0.0, 0, false, 0,
+                      nullptr, nullptr, nullptr, nullptr, nullptr);
+  }
+
+ protected:
+  std::shared_ptr<host> _host;
+  std::shared_ptr<service> _svc;
+};
+
+TEST_F(BrokerCheckData, CheckCommandIsSplit) {
+  _host->set_check_command("cmd!arg1!arg2");
+  host_check(_host->get_check_command().c_str());
+  ASSERT_EQ(std::string(_command_name), "cmd");
+  ASSERT_EQ(std::string(_command_args), "arg1!arg2");
+
+  _host->set_check_command("cmd");
+  host_check(_host->get_check_command().c_str());
+  ASSERT_EQ(std::string(_command_name), "cmd");
+  ASSERT_EQ(_command_args, nullptr);
+
+  host_check(nullptr);
+  ASSERT_EQ(_command_name, nullptr);
+  ASSERT_EQ(_command_args, nullptr);
+}
+
+TEST_F(BrokerCheckData, SplitLikeStrtok) {
+  char const* const cmds[]{"cmd!a!b", "!cmd!a", "cmd!", "cmd!!a", "!!", ""};
+  for (char const* cmd : cmds) {
+    std::string buf{cmd};
+    char* name{strtok(&buf[0], "!")};
+    char* args{strtok(nullptr, "\x0")};
+
+    /* Not the host check command: the split is done on the fly. */
+    host_check(cmd);
+    if (name)
+      ASSERT_EQ(std::string(_command_name), name) << cmd;
+    else
+      ASSERT_EQ(_command_name, nullptr) << cmd;
+    if (args)
+      ASSERT_EQ(std::string(_command_args), args) << cmd;
+    else
+      ASSERT_EQ(_command_args, nullptr) << cmd;
+  }
+}
+
+/* The split of the check command previously done by the broker for each
+ * event: a string::dup() of the command, cut by strtok(). */
+static void legacy_split(char const* cmd) {
+  char* command_buf{string::dup(cmd)};
+  char* command_name{strtok(command_buf, "!")};
+  char* command_args{strtok(nullptr, "\x0")};
+  save(command_name, command_args);
+  delete[] command_buf;
+}
+
+/* Allocations made to broker check events, before and after the split
+ * check command was cached on the checkables. The counts are reported as
+ * the allocations_before and allocations_after properties of the test. */
+TEST_F(BrokerCheckData, NoAllocationPerCheck) {
+  constexpr size_t checks = 10000;
+  _host->set_check_command("cmd!a_long_argument_to_avoid_small_strings!arg2");
+  _svc->set_check_command("cmd!a_long_argument_to_avoid_small_strings!arg2");
+  timeval tv{0, 0};
+
+  size_t before;
+  {
+    allocation_counter counter;
+    for (size_t i = 0; i < checks; ++i) {
+      legacy_split(_host->get_check_command().c_str());
+      legacy_split(_svc->get_check_command().c_str());
+    }
+    before = counter.count();
+  }
+
+  size_t after;
+  {
+    allocation_counter counter;
+    for (size_t i = 0; i < checks; ++i) {
+      host_check(_host->get_check_command().c_str());
+      broker_service_check(NEBTYPE_SERVICECHECK_INITIATE, NEBFLAG_NONE,
+                           NEBATTR_NONE, _svc.get(), checkable::check_active,
+                           tv, tv, _svc->get_check_command().c_str(), 0.0, 0.0,
+                           0, false, 0, nullptr, nullptr);
+    }
+    after = counter.count();
+  }
+  RecordProperty("allocations_before", static_cast<int>(before));
+  RecordProperty("allocations_after", static_cast<int>(after));
+
+  ASSERT_EQ(before, 2 * checks);
+  ASSERT_EQ(after, 0u);
+  ASSERT_EQ(std::string(_command_args),
+            "a_long_argument_to_avoid_small_strings!arg2");
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2021 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/nebcallbacks.hh"
+#include "com/centreon/engine/nebmods.hh"
+#include "helper.hh"
+
+using namespace com::centreon::engine;
+
+static int _first_calls;
+static int _second_calls;
+
+static int first_callback(int, void*) {
+  ++_first_calls;
+  return 0;
+}
+
+static int second_callback(int, void*) {
+  ++_second_calls;
+  return 0;
+}
+
+class BrokerSubscriptions : public ::testing::Test {
+ public:
+  void SetUp() override {
+    init_config_state();
+    neb_init_callback_list();
+    _first_calls = 0;
+    _second_calls = 0;
+  }
+
+  void TearDown() override {
+    neb_free_callback_list();
+    deinit_config_state();
+  }
+
+  static void program_state() {
+    broker_program_state(NEBTYPE_PROCESS_EVENTLOOPSTART, NEBFLAG_NONE,
+                         NEBATTR_NONE, nullptr);
+  }
+};
+
+TEST_F(BrokerSubscriptions, NoSubscription) {
+  for (int i = 0; i < NEBCALLBACK_NUMITEMS; ++i)
+    ASSERT_FALSE(neb_has_callbacks(i));
+  program_state();
+  ASSERT_EQ(_first_calls, 0);
+}
+
+TEST_F(BrokerSubscriptions, RegisterDeregister) {
+  int module;
+  ASSERT_EQ(neb_register_callback(NEBCALLBACK_PROCESS_DATA, &module, 0,
+                                  &first_callback),
+            OK);
+  ASSERT_EQ(neb_register_callback(NEBCALLBACK_PROCESS_DATA, &module, 1,
+                                  &second_callback),
+            OK);
+  ASSERT_TRUE(neb_has_callbacks(NEBCALLBACK_PROCESS_DATA));
+  ASSERT_FALSE(neb_has_callbacks(NEBCALLBACK_TIMED_EVENT_DATA));
+  program_state();
+  ASSERT_EQ(_first_calls, 1);
+  ASSERT_EQ(_second_calls, 1);
+
+  /* Removing the head of the list keeps the other callbacks. */
+  ASSERT_EQ(neb_deregister_callback(NEBCALLBACK_PROCESS_DATA, &first_callback),
+            OK);
+  ASSERT_TRUE(neb_has_callbacks(NEBCALLBACK_PROCESS_DATA));
+  program_state();
+  ASSERT_EQ(_first_calls, 1);
+  ASSERT_EQ(_second_calls, 2);
+
+  ASSERT_EQ(
+      neb_deregister_callback(NEBCALLBACK_PROCESS_DATA, &second_callback),
+      OK);
+  ASSERT_FALSE(neb_has_callbacks(NEBCALLBACK_PROCESS_DATA));
+  program_state();
+  ASSERT_EQ(_second_calls, 2);
+}
+
+TEST_F(BrokerSubscriptions, DeregisterModule) {
+  int module;
+  neb_register_callback(NEBCALLBACK_LOG_DATA, &module, 0, &first_callback);
+  neb_register_callback(NEBCALLBACK_HOST_CHECK_DATA, &module, 0,
+                        &second_callback);
+  ASSERT_TRUE(neb_has_callbacks(NEBCALLBACK_LOG_DATA));
+  ASSERT_TRUE(neb_has_callbacks(NEBCALLBACK_HOST_CHECK_DATA));
+  neb_deregister_module_callbacks(&module);
+  ASSERT_FALSE(neb_has_callbacks(NEBCALLBACK_LOG_DATA));
+  ASSERT_FALSE(neb_has_callbacks(NEBCALLBACK_HOST_CHECK_DATA));
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2021 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+
+#include "com/centreon/engine/checks/check_result_map.hh"
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <unordered_map>
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::checks;
+
+static check_result* fake_result(uintptr_t i) {
+  return reinterpret_cast<check_result*>(i);
+}
+
+TEST(CheckResultMap, InsertTake) {
+  check_result_map m(8);
+  m.insert(1, fake_result(10));
+  m.insert(2, fake_result(20));
+  m.insert(1, fake_result(11));
+  ASSERT_EQ(m.size(), 2u);
+  ASSERT_EQ(m.take(3), nullptr);
+  ASSERT_EQ(m.take(1), fake_result(11));
+  ASSERT_EQ(m.take(1), nullptr);
+  ASSERT_EQ(m.take(2), fake_result(20));
+  ASSERT_EQ(m.size(), 0u);
+}
+
+/* Random operations compared with an unordered_map, the table grows and
+ * removals shift colliding entries. */
+TEST(CheckResultMap, SameAsUnorderedMap) {
+  check_result_map m(8);
+  std::unordered_map<uint64_t, check_result*> ref;
+  srand(42);
+  for (int i = 0; i < 100000; ++i) {
+    uint64_t id(rand() % 2000 + 1);
+    if (rand() % 2) {
+      m.insert(id, fake_result(i + 1));
+      ref[id] = fake_result(i + 1);
+    } else {
+      auto it(ref.find(id));
+      check_result* expected(it == ref.end() ? nullptr : it->second);
+      if (it != ref.end())
+        ref.erase(it);
+      ASSERT_EQ(m.take(id), expected);
+    }
+    ASSERT_EQ(m.size(), ref.size());
+  }
+  for (auto const& p : ref)
+    ASSERT_EQ(m.take(p.first), p.second);
+  ASSERT_EQ(m.size(), 0u);
+}
+
+TEST(CheckResultMap, EraseIf) {
+  check_result_map m;
+  for (uint64_t id = 1; id <= 100; ++id)
+    m.insert(id, fake_result(id % 2 + 1));
+  m.erase_if([](check_result* r) { return r == fake_result(1); });
+  ASSERT_EQ(m.size(), 50u);
+  size_t count(0);
+  m.for_each([&count](check_result const* r) {
+    ASSERT_EQ(r, fake_result(2));
+    ++count;
+  });
+  ASSERT_EQ(count, 50u);
+  ASSERT_EQ(m.take(2), nullptr);
+  ASSERT_EQ(m.take(3), fake_result(2));
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2021 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+
+#include "com/centreon/engine/checks/check_result_pool.hh"
+
+#include <gtest/gtest.h>
+
+#include "com/centreon/engine/common.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::checks;
+
+static check_result* get_result(std::string const& output) {
+  timeval tv{1000, 0};
+  return check_result_pool::instance().get(
+      service_check, nullptr, checkable::check_passive, CHECK_OPTION_NONE,
+      false, 0.5, tv, tv, false, true, 2, output);
+}
+
+TEST(CheckResultPool, ResultsAreRecycled) {
+  check_result_pool& pool(check_result_pool::instance());
+  std::string output(1000, 'a');
+  check_result* first(get_result(output));
+  size_t capacity(first->get_output().capacity());
+  first->set_return_code(1);
+  size_t free_count(pool.free_count());
+  pool.put(first);
+  ASSERT_EQ(pool.free_count(), free_count + 1);
+
+  check_result* second(get_result("short"));
+  ASSERT_EQ(second, first);
+  ASSERT_EQ(pool.free_count(), free_count);
+  ASSERT_EQ(second->get_output(), "short");
+  ASSERT_EQ(second->get_output().capacity(), capacity);
+  ASSERT_EQ(second->get_return_code(), 2);
+  ASSERT_EQ(second->get_start_time().tv_sec, 1000);
+  pool.put(second);
+}
+
+TEST(CheckResultPool, LargeOutputsAreReleased) {
+  check_result_pool& pool(check_result_pool::instance());
+  std::string output(check_result_pool::max_output_capacity + 1, 'a');
+  check_result_pool::pointer result(get_result(output));
+  check_result* raw(result.get());
+  result.reset();
+  check_result* again(get_result(""));
+  ASSERT_EQ(again, raw);
+  ASSERT_LE(again->get_output().capacity(),
+            check_result_pool::max_output_capacity);
+  pool.put(again);
+}
@@ -0,0 +1,220 @@
+/*
+ * Copyright 2021 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "../test_engine.hh"
+#include "../timeperiod/utils.hh"
+#include "com/centreon/engine/checkable_state.hh"
+#include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/configuration/applier/contact.hh"
+#include "com/centreon/engine/configuration/applier/host.hh"
+#include "com/centreon/engine/configuration/applier/service.hh"
+#include "com/centreon/engine/globals.hh"
+#include "helper.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+
+class CheckableState : public TestEngine {
+ public:
+  void SetUp() override {
+    init_config_state();
+
+    configuration::applier::contact ct_aply;
+    configuration::contact ctct{new_configuration_contact("admin", true)};
+    ct_aply.add_object(ctct);
+    ct_aply.expand_objects(*config);
+    ct_aply.resolve_object(ctct);
+
+    configuration::host hst{new_configuration_host("test_host", "admin")};
+    configuration::applier::host hst_aply;
+    hst_aply.add_object(hst);
+    hst_aply.resolve_object(hst);
+  }
+
+  void TearDown() override { deinit_config_state(); }
+
+  void add_services(int count) {
+    configuration::applier::service svc_aply;
+    for (int i = 0; i < count; ++i) {
+      configuration::service svc{new_configuration_service(
+          "test_host", "test_svc" + std::to_string(i), "admin", i + 1)};
+      svc_aply.add_object(svc);
+      svc_aply.resolve_object(svc);
+    }
+  }
+};
+
+TEST_F(CheckableState, StatesAreReused) {
+  checkable_state_store store;
+  checkable* owner{reinterpret_cast<checkable*>(&store)};
+  checkable_state_store::handle h1{store.acquire(owner)};
+  checkable_state_store::handle h2{store.acquire(owner)};
+  ASSERT_EQ(store.size(), 2u);
+  ASSERT_EQ(h2.get(), h1.get() + 1);
+
+  checkable_state* first{h1.get()};
+  h1->next_check = 42;
+  h1.reset();
+  ASSERT_EQ(store.size(), 1u);
+  int count{0};
+  store.for_each([&count](checkable_state&) { ++count; });
+  ASSERT_EQ(count, 1);
+
+  /* A released state is handed out again with default values. */
+  h1 = store.acquire(owner);
+  ASSERT_EQ(h1.get(), first);
+  ASSERT_EQ(h1->next_check, 0);
+  ASSERT_TRUE(h1->should_be_scheduled);
+}
+
+TEST_F(CheckableState, ObjectsUseTheirStore) {
+  size_t services{checkable_state_store::services().size()};
+  add_services(3);
+  ASSERT_EQ(checkable_state_store::services().size(), services + 3);
+
+  std::shared_ptr<engine::service> svc{service::services.begin()->second};
+  svc->set_next_check(1000);
+  svc->set_is_executing(true);
+  int executing{0};
+  checkable_state_store::services().for_each(
+      [&executing, &svc](checkable_state& st) {
+        if (st.owner == svc.get()) {
+          ++executing;
+          ASSERT_TRUE(st.is_executing);
+          ASSERT_EQ(st.next_check, 1000);
+        }
+      });
+  ASSERT_EQ(executing, 1);
+
+  /* The orphaned check is found from its deadline. */
+  checks::checker::instance().add_check_without_command(service_check,
+                                                        svc.get(), 10000);
+  set_time(20000);
+  service::check_for_orphaned();
+  ASSERT_FALSE(svc->get_is_executing());
+
+  /* Removed services give their states back. */
+  service::services_by_id.erase(
+      {svc->get_host_id(), svc->get_service_id()});
+  service::services.erase({svc->get_hostname(), svc->get_description()});
+  svc.reset();
+  ASSERT_EQ(checkable_state_store::services().size(), services + 2);
+}
+
+TEST_F(CheckableState, FreshnessIndex) {
+  checkable_state_store store;
+  checkable* owner{reinterpret_cast<checkable*>(&store)};
+  checkable_state_store::handle h1{store.acquire(owner)};
+  checkable_state_store::handle h2{store.acquire(owner)};
+  checkable_state_store::handle h3{store.acquire(owner)};
+  store.watch_freshness(*h1, 100);
+  store.watch_freshness(*h2, 50);
+  store.watch_freshness(*h3, 200);
+
+  /* A new deadline replaces the previous one. */
+  store.watch_freshness(*h2, 150);
+  ASSERT_TRUE(store.pop_freshness_due(90).empty());
+  std::vector<checkable_state*> due{store.pop_freshness_due(150)};
+  ASSERT_EQ(due.size(), 2u);
+  ASSERT_EQ(due[0], h1.get());
+  ASSERT_EQ(due[1], h2.get());
+  ASSERT_EQ(h1->freshness_deadline, 0);
+
+  /* Released states are dropped. */
+  h3.reset();
+  ASSERT_TRUE(store.pop_freshness_due(1000).empty());
+  ASSERT_EQ(store.freshness_index_size(), 0u);
+}
+
+TEST_F(CheckableState, FreshnessSweep) {
+  add_services(3);
+  config->check_service_freshness(true);
+  set_time(1000);
+  checkable_state_store::services().reset_freshness(1000);
+  std::shared_ptr<engine::service> svc{service::services.begin()->second};
+  svc->set_has_been_checked(true);
+  svc->set_check_freshness(true);
+  svc->set_freshness_threshold(60);
+  svc->set_last_check(1000);
+  ASSERT_EQ(checkable_state_store::services().freshness_index_size(), 1u);
+
+  /* The deadline is computed by the first sweep... */
+  service::check_result_freshness();
+  ASSERT_FALSE(svc->get_is_being_freshened());
+  set_time(1060);
+  service::check_result_freshness();
+  ASSERT_FALSE(svc->get_is_being_freshened());
+
+  /* ...and reached once the result is stale. */
+  set_time(1061);
+  service::check_result_freshness();
+  ASSERT_TRUE(svc->get_is_being_freshened());
+
+  /* A new result gives a new deadline. */
+  svc->set_is_being_freshened(false);
+  svc->set_last_check(1100);
+  set_time(1101);
+  service::check_result_freshness();
+  ASSERT_FALSE(svc->get_is_being_freshened());
+  set_time(1161);
+  service::check_result_freshness();
+  ASSERT_TRUE(svc->get_is_being_freshened());
+}
+
+/* Sweep through the store compared to a sweep through the objects. Run it
+ * with --gtest_also_run_disabled_tests, the durations are test properties
+ * of the report. */
+TEST_F(CheckableState, DISABLED_Benchmark) {
+  constexpr int count = 20000;
+  constexpr int loops = 100;
+  add_services(count);
+  for (auto& p : service::services)
+    p.second->set_next_check(p.second->get_service_id() % 7 ? 10 : 30);
+
+  int found{0};
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < loops; ++i)
+    for (auto& p : service::services)
+      if (p.second->get_check_freshness() || p.second->get_next_check() > 20)
+        ++found;
+  std::chrono::duration<double> objects_d =
+      std::chrono::steady_clock::now() - start;
+
+  int store_found{0};
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < loops; ++i)
+    checkable_state_store::services().for_each(
+        [&store_found](checkable_state& st) {
+          if (st.check_freshness || st.next_check > 20)
+            ++store_found;
+        });
+  std::chrono::duration<double> store_d =
+      std::chrono::steady_clock::now() - start;
+
+  RecordProperty("store_sweep_us",
+                 static_cast<int>(store_d.count() / loops * 1e6));
+  RecordProperty("objects_sweep_us",
+                 static_cast<int>(objects_d.count() / loops * 1e6));
+  ASSERT_EQ(store_found, found);
+  ASSERT_GT(found, 0);
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2021 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+
+#include "com/centreon/engine/checks/latency_histogram.hh"
+
+#include <gtest/gtest.h>
+
+using namespace com::centreon::engine::checks;
+
+TEST(LatencyHistogram, Empty) {
+  latency_histogram h;
+  ASSERT_EQ(h.count(), 0u);
+  ASSERT_EQ(h.percentile(50), 0);
+  ASSERT_EQ(h.percentile(99), 0);
+}
+
+TEST(LatencyHistogram, Percentiles) {
+  latency_histogram h;
+  /* 90 fast checks, 9 checks delayed by 3s and one by 45s. */
+  for (int i = 0; i < 90; ++i)
+    h.add(0.003);
+  for (int i = 0; i < 9; ++i)
+    h.add(3);
+  h.add(45);
+  ASSERT_EQ(h.count(), 100u);
+  ASSERT_EQ(h.max(), 45);
+  ASSERT_EQ(h.percentile(50), 0.01);
+  ASSERT_EQ(h.percentile(90), 0.01);
+  ASSERT_EQ(h.percentile(95), 5);
+  ASSERT_EQ(h.percentile(99), 5);
+  ASSERT_EQ(h.percentile(100), 45);
+}
+
+TEST(LatencyHistogram, BoundedByMax) {
+  latency_histogram h;
+  h.add(-1);
+  h.add(0.2);
+  /* The bucket bound is larger than any value seen. */
+  ASSERT_EQ(h.percentile(100), 0.2);
+  ASSERT_EQ(h.percentile(50), 0.01);
+
+  /* The last bucket has no bound. */
+  h.add(500);
+  ASSERT_EQ(h.percentile(60), 0.25);
+  ASSERT_EQ(h.percentile(100), 500);
+
+  h.reset();
+  ASSERT_EQ(h.count(), 0u);
+  ASSERT_EQ(h.max(), 0);
+}
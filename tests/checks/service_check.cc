@@ -27,6 +27,7 @@
 
 #include "../test_engine.hh"
 #include "../timeperiod/utils.hh"
+#include "com/centreon/engine/checks/check_result_pool.hh"
 #include "com/centreon/engine/checks/checker.hh"
 #include "com/centreon/engine/configuration/applier/command.hh"
 #include "com/centreon/engine/configuration/applier/contact.hh"
@@ -580,3 +581,146 @@ TEST_F(ServiceCheck, CheckRemoveCheck) {
 
   checks::checker::instance().reap();
 }
+
+TEST_F(ServiceCheck, ResultsAreReapedInOrder) {
+  set_time(50000);
+  _svc->set_accept_passive_checks(true);
+  _svc->set_current_attempt(1);
+
+  set_time(50500);
+  std::time_t now{std::time(nullptr)};
+  for (char const* output : {"first", "second", "third"})
+    process_external_command(
+        fmt::format("[{}] PROCESS_SERVICE_CHECK_RESULT;test_host;test_svc;0;{}",
+                    now, output)
+            .c_str());
+  ASSERT_EQ(_svc->get_pending_check_results(), 3u);
+
+  checks::checker::instance().reap();
+  ASSERT_EQ(_svc->get_plugin_output(), "third");
+  ASSERT_EQ(_svc->get_pending_check_results(), 0u);
+}
+
+TEST_F(ServiceCheck, ResultsOfRemovedServiceAreDropped) {
+  set_time(50000);
+  _svc->set_accept_passive_checks(true);
+
+  std::time_t now{std::time(nullptr)};
+  for (int i = 0; i < 2; ++i)
+    process_external_command(
+        fmt::format(
+            "[{}] PROCESS_SERVICE_CHECK_RESULT;test_host;test_svc;2;critical",
+            now)
+            .c_str());
+
+  /* A reload destroys the service. */
+  engine::service::services.clear();
+  engine::service::services_by_id.clear();
+  _svc.reset();
+
+  uint64_t waiting, to_reap, bytes;
+  checks::checker::instance().get_check_results_usage(waiting, to_reap, bytes);
+  ASSERT_EQ(to_reap, 2u);
+
+  checks::checker::instance().reap();
+  checks::checker::instance().get_check_results_usage(waiting, to_reap, bytes);
+  ASSERT_EQ(waiting, 0u);
+  ASSERT_EQ(to_reap, 0u);
+}
+
+TEST_F(ServiceCheck, WaitingResultsOfRemovedServiceAreDropped) {
+  set_time(50000);
+  timeval tv{50000, 0};
+  check_result* result{checks::check_result_pool::instance().get(
+      service_check, _svc.get(), checkable::check_active, CHECK_OPTION_NONE,
+      true, 0.0, tv, tv, false, true, engine::service::state_ok, "")};
+  checks::checker::instance().add_check_result(4242, result, 50060);
+  ASSERT_EQ(_svc->get_pending_check_results(), 1u);
+
+  /* A reload destroys the service while its command never finishes. */
+  engine::service::services.clear();
+  engine::service::services_by_id.clear();
+  _svc.reset();
+
+  checks::checker::instance().reap();
+  uint64_t waiting, to_reap, bytes;
+  checks::checker::instance().get_check_results_usage(waiting, to_reap, bytes);
+  ASSERT_EQ(waiting, 0u);
+  ASSERT_EQ(to_reap, 0u);
+
+  /* The command may still end, its result is not found anymore. */
+  commands::result res;
+  res.command_id = 4242;
+  commands::command_listener& listener(checks::checker::instance());
+  listener.finished(res);
+  checks::checker::instance().get_check_results_usage(waiting, to_reap, bytes);
+  ASSERT_EQ(to_reap, 0u);
+}
+
+TEST_F(ServiceCheck, OverriddenChecksAreNotMistakenForEachOther) {
+  checks::checker& checker(checks::checker::instance());
+
+  /* A broker module overrides a check and gives its result in time. */
+  _svc->set_is_executing(true);
+  checker.add_check_without_command(service_check, _svc.get(), 1100);
+  _svc->set_is_executing(false);
+
+  /* The next check is overridden too, its deadline is later. */
+  _svc->set_is_executing(true);
+  checker.add_check_without_command(service_check, _svc.get(), 1200);
+
+  /* The deadline of the first check does not orphan the second one. */
+  ASSERT_TRUE(checker.get_orphaned_checks(service_check, 1150).empty());
+  std::vector<notifier*> orphaned{
+      checker.get_orphaned_checks(service_check, 1250)};
+  ASSERT_EQ(orphaned.size(), 1u);
+  ASSERT_EQ(orphaned[0], _svc.get());
+  _svc->set_is_executing(false);
+}
+
+/* A command that only counts its executions. */
+class counting_command : public commands::command {
+ public:
+  int runs = 0;
+
+  counting_command() : commands::command("counting", "/bin/true") {}
+  uint64_t run(std::string const&, nagios_macros&, uint32_t) override {
+    ++runs;
+    return 0;
+  }
+  void run(std::string const&,
+           nagios_macros&,
+           uint32_t,
+           commands::result&) override {
+    ++runs;
+  }
+};
+
+TEST_F(ServiceCheck, HostChecksAreCoalesced) {
+  counting_command cmd;
+  _host->set_check_command_ptr(&cmd);
+  set_time(1000);
+  _host->set_has_been_checked(true);
+  _host->set_last_check(995);
+
+  /* The last host check is older than the observation. */
+  _host->request_check(998);
+  ASSERT_EQ(cmd.runs, 1);
+  ASSERT_TRUE(_host->get_is_executing());
+
+  /* Other requests attach to the check being executed. */
+  for (int i = 0; i < 200; ++i)
+    _host->request_check(1000);
+  ASSERT_EQ(cmd.runs, 1);
+
+  /* A check started after the observation answers it. */
+  _host->set_is_executing(false);
+  _host->set_last_check(1000);
+  _host->request_check(999);
+  ASSERT_EQ(cmd.runs, 1);
+  _host->request_check(1001);
+  ASSERT_EQ(cmd.runs, 2);
+
+  _host->set_is_executing(false);
+  _host->set_check_command_ptr(nullptr);
+}
@@ -560,7 +560,7 @@ TEST_F(ServiceRetention, RetentionWithMultilineOutput) {
       _svc->get_service_id(), time(nullptr), "test1", "test2", false,
       comment::internal, false, (time_t)0);
 
-  comment::comments.insert({cmt->get_comment_id(), cmt});
+  comment::insert_comment(cmt);
 
   oss.str("");
   retention::dump::comments(oss);
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2021 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/engine/checks/timeout_wheel.hh"
+
+#include <gtest/gtest.h>
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::checks;
+
+static notifier* fake_notifier(uintptr_t i) {
+  return reinterpret_cast<notifier*>(i);
+}
+
+TEST(TimeoutWheel, ExpireInOrder) {
+  timeout_wheel w(16);
+  w.add(1005, 1, fake_notifier(1));
+  w.add(1010, 2, fake_notifier(2));
+  /* Same slot as the first one, but one round later. */
+  w.add(1021, 3, fake_notifier(3));
+  ASSERT_EQ(w.size(), 3u);
+
+  ASSERT_TRUE(w.expire(1000).empty());
+  std::vector<timeout_wheel::entry> expired{w.expire(1005)};
+  ASSERT_EQ(expired.size(), 1u);
+  ASSERT_EQ(expired[0].command_id, 1u);
+
+  expired = w.expire(1020);
+  ASSERT_EQ(expired.size(), 1u);
+  ASSERT_EQ(expired[0].command_id, 2u);
+  ASSERT_EQ(w.size(), 1u);
+
+  expired = w.expire(1021);
+  ASSERT_EQ(expired.size(), 1u);
+  ASSERT_EQ(expired[0].n, fake_notifier(3));
+  ASSERT_EQ(w.size(), 0u);
+}
+
+TEST(TimeoutWheel, LateAndPastDeadlines) {
+  timeout_wheel w(16);
+  w.expire(1000);
+  /* A deadline already passed expires on the next call. */
+  w.add(990, 1, fake_notifier(1));
+  w.add(1100, 2, fake_notifier(2));
+  ASSERT_EQ(w.expire(1001).size(), 1u);
+
+  /* A long time without call visits all the slots. */
+  ASSERT_EQ(w.expire(5000).size(), 1u);
+
+  /* So does a clock going back. */
+  w.add(4010, 3, fake_notifier(3));
+  ASSERT_EQ(w.expire(4020).size(), 1u);
+}
+
+TEST(TimeoutWheel, Remove) {
+  timeout_wheel w(16);
+  w.add(1005, 1, fake_notifier(1));
+  w.add(1006, 2, fake_notifier(2));
+  w.add(1030, 3, fake_notifier(1));
+  w.remove({fake_notifier(1)});
+  ASSERT_EQ(w.size(), 1u);
+  std::vector<timeout_wheel::entry> expired{w.expire(2000)};
+  ASSERT_EQ(expired.size(), 1u);
+  ASSERT_EQ(expired[0].command_id, 2u);
+}
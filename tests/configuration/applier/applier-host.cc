@@ -105,6 +105,40 @@ TEST_F(ApplierHost, HostRemoved) {
   ASSERT_EQ(get_host_id(h1->get_name()), 12u);
 }
 
+// Given a host configuration
+// When its address is changed or it is removed
+// Then the address index follows and other hosts sharing the address are
+// still found.
+TEST_F(ApplierHost, HostAddressIndex) {
+  configuration::applier::host hst_aply;
+  configuration::host hst;
+  ASSERT_TRUE(hst.parse("host_name", "test_host"));
+  ASSERT_TRUE(hst.parse("address", "127.0.0.1"));
+  ASSERT_TRUE(hst.parse("_HOST_ID", "12"));
+  hst_aply.add_object(hst);
+  engine::host* h1(engine::host::hosts["test_host"].get());
+  ASSERT_EQ(find_host_by_name_or_address("test_host"), h1);
+  ASSERT_EQ(find_host_by_name_or_address("127.0.0.1"), h1);
+
+  ASSERT_TRUE(hst.parse("address", "10.0.0.1"));
+  hst_aply.modify_object(hst);
+  ASSERT_EQ(find_host_by_name_or_address("127.0.0.1"), nullptr);
+  ASSERT_EQ(find_host_by_name_or_address("10.0.0.1"), h1);
+
+  configuration::host hst2;
+  ASSERT_TRUE(hst2.parse("host_name", "test_host2"));
+  ASSERT_TRUE(hst2.parse("address", "10.0.0.1"));
+  ASSERT_TRUE(hst2.parse("_HOST_ID", "13"));
+  hst_aply.add_object(hst2);
+  ASSERT_EQ(engine::host::hosts_by_address.count("10.0.0.1"), 2u);
+
+  hst_aply.remove_object(hst);
+  ASSERT_EQ(find_host_by_name_or_address("test_host"), nullptr);
+  ASSERT_EQ(find_host_by_name_or_address("10.0.0.1"),
+            engine::host::hosts["test_host2"].get());
+  ASSERT_EQ(engine::host::hosts_by_address.size(), 1u);
+}
+
 TEST_F(ApplierHost, HostParentChildUnreachable) {
   configuration::applier::host hst_aply;
   configuration::applier::command cmd_aply;
@@ -110,3 +110,140 @@ TEST_F(DowntimeExternalCommand, AddHostDowntime) {
             OK);
   ASSERT_EQ(0u, downtime_manager::instance().get_scheduled_downtimes().size());
 }
+
+TEST_F(DowntimeExternalCommand, IndexedLookups) {
+  configuration::applier::host hst_aply;
+  configuration::host hst;
+  ASSERT_TRUE(hst.parse("host_name", "test_srv"));
+  ASSERT_TRUE(hst.parse("address", "127.0.0.1"));
+  ASSERT_TRUE(hst.parse("_HOST_ID", "1"));
+  ASSERT_NO_THROW(hst_aply.add_object(hst));
+  configuration::host hst2;
+  ASSERT_TRUE(hst2.parse("host_name", "other_srv"));
+  ASSERT_TRUE(hst2.parse("address", "127.0.0.2"));
+  ASSERT_TRUE(hst2.parse("_HOST_ID", "2"));
+  ASSERT_NO_THROW(hst_aply.add_object(hst2));
+
+  set_time(20000);
+  time_t now = time(nullptr);
+  downtime_manager& dm(downtime_manager::instance());
+  uint64_t id1, id2, id3;
+  ASSERT_EQ(dm.schedule_downtime(downtime::host_downtime, "test_srv", "", now,
+                                 "admin", "first", now + 10, now + 100, true,
+                                 0, 0, &id1),
+            OK);
+  ASSERT_EQ(dm.schedule_downtime(downtime::host_downtime, "test_srv", "", now,
+                                 "admin", "triggered", now + 10, now + 100,
+                                 true, id1, 0, &id2),
+            OK);
+  ASSERT_EQ(dm.schedule_downtime(downtime::host_downtime, "other_srv", "",
+                                 now, "admin", "other", now + 20, now + 100,
+                                 true, 0, 0, &id3),
+            OK);
+  ASSERT_EQ(dm.get_scheduled_downtimes().size(), 3u);
+
+  ASSERT_EQ(dm.find_downtime(downtime::any_downtime, id2)->get_comment(),
+            "triggered");
+  ASSERT_EQ(dm.find_downtime(downtime::service_downtime, id2), nullptr);
+  ASSERT_EQ(dm.find_downtime(downtime::any_downtime, id3 + 1), nullptr);
+
+  /* Unscheduling a downtime also unschedules the ones it triggers. */
+  ASSERT_EQ(dm.unschedule_downtime(id1), OK);
+  ASSERT_EQ(dm.get_scheduled_downtimes().size(), 1u);
+  ASSERT_EQ(dm.find_downtime(downtime::any_downtime, id2), nullptr);
+
+  ASSERT_EQ(
+      dm.delete_downtime_by_hostname_service_description_start_time_comment(
+          "test_srv", "", {false, 0}, ""),
+      0);
+  ASSERT_EQ(
+      dm.delete_downtime_by_hostname_service_description_start_time_comment(
+          "other_srv", "", {true, now + 20}, ""),
+      1);
+  ASSERT_TRUE(dm.get_scheduled_downtimes().empty());
+}
+
+TEST_F(DowntimeExternalCommand, ExpireDowntimes) {
+  configuration::applier::host hst_aply;
+  configuration::host hst;
+  ASSERT_TRUE(hst.parse("host_name", "test_srv"));
+  ASSERT_TRUE(hst.parse("address", "127.0.0.1"));
+  ASSERT_TRUE(hst.parse("_HOST_ID", "1"));
+  ASSERT_NO_THROW(hst_aply.add_object(hst));
+
+  set_time(20000);
+  time_t now = time(nullptr);
+  downtime_manager& dm(downtime_manager::instance());
+  uint64_t id1, id2, id3;
+  ASSERT_EQ(dm.schedule_downtime(downtime::host_downtime, "test_srv", "", now,
+                                 "admin", "first", now + 10, now + 100, false,
+                                 0, 60, &id1),
+            OK);
+  ASSERT_EQ(dm.schedule_downtime(downtime::host_downtime, "test_srv", "", now,
+                                 "admin", "second", now + 10, now + 200,
+                                 false, 0, 60, &id2),
+            OK);
+  ASSERT_EQ(dm.schedule_downtime(downtime::host_downtime, "test_srv", "", now,
+                                 "admin", "third", now + 10, now + 50, false,
+                                 0, 60, &id3),
+            OK);
+  ASSERT_EQ(dm.unschedule_downtime(id3), OK);
+
+  /* Nothing is over yet. */
+  ASSERT_EQ(dm.check_for_expired_downtime(), OK);
+  ASSERT_EQ(dm.get_scheduled_downtimes().size(), 2u);
+
+  set_time(20150);
+  ASSERT_EQ(dm.check_for_expired_downtime(), OK);
+  ASSERT_EQ(dm.get_scheduled_downtimes().size(), 1u);
+  ASSERT_EQ(dm.find_downtime(downtime::any_downtime, id1), nullptr);
+  ASSERT_NE(dm.find_downtime(downtime::any_downtime, id2), nullptr);
+
+  set_time(20250);
+  ASSERT_EQ(dm.check_for_expired_downtime(), OK);
+  ASSERT_TRUE(dm.get_scheduled_downtimes().empty());
+}
+
+TEST_F(DowntimeExternalCommand, PendingFlexDowntimes) {
+  configuration::applier::host hst_aply;
+  configuration::host hst;
+  ASSERT_TRUE(hst.parse("host_name", "test_srv"));
+  ASSERT_TRUE(hst.parse("address", "127.0.0.1"));
+  ASSERT_TRUE(hst.parse("_HOST_ID", "1"));
+  ASSERT_NO_THROW(hst_aply.add_object(hst));
+  host* h{host::hosts.begin()->second.get()};
+
+  set_time(20000);
+  time_t now = time(nullptr);
+  downtime_manager& dm(downtime_manager::instance());
+  uint64_t id1, id2, id3;
+  ASSERT_EQ(dm.schedule_downtime(downtime::host_downtime, "test_srv", "", now,
+                                 "admin", "flex", now - 10, now + 100, false,
+                                 0, 60, &id1),
+            OK);
+  ASSERT_EQ(dm.schedule_downtime(downtime::host_downtime, "test_srv", "", now,
+                                 "admin", "later", now + 50, now + 100, false,
+                                 0, 60, &id2),
+            OK);
+  ASSERT_EQ(dm.schedule_downtime(downtime::host_downtime, "test_srv", "", now,
+                                 "admin", "fixed", now + 50, now + 100, true,
+                                 0, 0, &id3),
+            OK);
+
+  /* An up host starts nothing. */
+  h->set_current_state(host::state_up);
+  ASSERT_EQ(dm.check_pending_flex_host_downtime(h), OK);
+  ASSERT_FALSE(dm.find_downtime(downtime::any_downtime, id1)->is_in_effect());
+
+  /* Only the flexible downtime of the current window starts. */
+  h->set_current_state(host::state_down);
+  ASSERT_EQ(dm.check_pending_flex_host_downtime(h), OK);
+  ASSERT_TRUE(dm.find_downtime(downtime::any_downtime, id1)->is_in_effect());
+  ASSERT_FALSE(dm.find_downtime(downtime::any_downtime, id2)->is_in_effect());
+  ASSERT_FALSE(dm.find_downtime(downtime::any_downtime, id3)->is_in_effect());
+
+  set_time(20060);
+  ASSERT_EQ(dm.check_pending_flex_host_downtime(h), OK);
+  ASSERT_TRUE(dm.find_downtime(downtime::any_downtime, id2)->is_in_effect());
+  ASSERT_FALSE(dm.find_downtime(downtime::any_downtime, id3)->is_in_effect());
+}
@@ -23,6 +23,7 @@
 #include <grpcpp/create_channel.h>
 #include <iostream>
 #include <memory>
+#include <vector>
 #include "engine.grpc.pb.h"
 
 using namespace com::centreon::engine;
@@ -262,6 +263,23 @@ class EngineRPCClient {
     return true;
   }
 
+  bool ProcessCheckResults(std::vector<CheckResultBatch> const& batches,
+                           CheckResultsStatus* response) {
+    grpc::ClientContext context;
+    std::unique_ptr<grpc::ClientWriter<CheckResultBatch> > writer(
+        _stub->ProcessCheckResults(&context, response));
+    for (CheckResultBatch const& b : batches)
+      if (!writer->Write(b))
+        break;
+    writer->WritesDone();
+    grpc::Status status = writer->Finish();
+    if (!status.ok()) {
+      std::cout << "ProcessCheckResults failed." << std::endl;
+      return false;
+    }
+    return true;
+  }
+
   bool NewThresholdsFile(const ThresholdsFile& tf) {
     grpc::ClientContext context;
     CommandSuccess response;
@@ -1397,6 +1415,41 @@ int main(int argc, char** argv) {
     hc.set_output("Test external command");
     status = client.ProcessHostCheckResult(hc) ? 0 : 4;
     std::cout << "ProcessHostCheckResult: " << status << std::endl;
+  } else if (strcmp(argv[1], "ProcessCheckResults") == 0) {
+    /* Each argument is host[/service]:code, '#' before a name means it is an
+     * id. Results are sent by batches of two. */
+    std::vector<CheckResultBatch> batches;
+    for (int i = 2; i < argc; ++i) {
+      if ((i - 2) % 2 == 0)
+        batches.emplace_back();
+      CheckResult* r = batches.back().add_results();
+      std::string arg(argv[i]);
+      size_t colon = arg.rfind(':');
+      r->set_code(std::stol(arg.substr(colon + 1)));
+      r->set_output("Test external command");
+      arg.resize(colon);
+      size_t slash = arg.find('/');
+      std::string hst(arg.substr(0, slash));
+      if (hst[0] == '#')
+        r->set_host_id(std::stoul(hst.substr(1)));
+      else
+        r->set_host_name(hst);
+      if (slash != std::string::npos) {
+        std::string svc(arg.substr(slash + 1));
+        if (svc[0] == '#')
+          r->set_service_id(std::stoul(svc.substr(1)));
+        else
+          r->set_svc_desc(svc);
+      }
+    }
+    CheckResultsStatus response;
+    status = client.ProcessCheckResults(batches, &response) ? 0 : 1;
+    std::cout << "ProcessCheckResults: accepted=" << response.accepted()
+              << " rejected=" << response.rejected() << std::endl;
+    std::cout << "statuses:";
+    for (int s : response.statuses())
+      std::cout << " " << s;
+    std::cout << std::endl;
   } else if (strcmp(argv[1], "NewThresholdsFile") == 0) {
     ThresholdsFile tf;
     tf.set_filename(argv[2]);
@@ -676,7 +676,7 @@ TEST_F(EngineRpc, DeleteComment) {
   auto cmt = std::make_shared<comment>(
       comment::host, comment::user, _host->get_host_id(), 0, 10000,
       "test-admin", oss.str(), true, comment::external, false, 0);
-  comment::comments.insert({cmt->get_comment_id(), cmt});
+  comment::insert_comment(cmt);
 
   call_command_manager(th, &condvar, &mutex, &continuerunning);
 
@@ -735,7 +735,7 @@ TEST_F(EngineRpc, DeleteAllHostComments) {
     auto cmt = std::make_shared<comment>(
         comment::host, comment::user, _host->get_host_id(), 0, 10000,
         "test-admin", oss.str(), true, comment::external, false, 0);
-    comment::comments.insert({cmt->get_comment_id(), cmt});
+    comment::insert_comment(cmt);
   }
   ASSERT_EQ(comment::comments.size(), 10u);
 
@@ -750,7 +750,7 @@ TEST_F(EngineRpc, DeleteAllHostComments) {
     auto cmt = std::make_shared<comment>(
         comment::host, comment::user, _host->get_host_id(), 0, 10000,
         "test-admin", oss.str(), true, comment::external, false, 0);
-    comment::comments.insert({cmt->get_comment_id(), cmt});
+    comment::insert_comment(cmt);
   }
   ASSERT_EQ(comment::comments.size(), 10u);
   output = execute("DeleteAllHostComments byhostname test_host");
@@ -782,7 +782,7 @@ TEST_F(EngineRpc, DeleteAllServiceComments) {
         comment::service, comment::user, _host->get_host_id(),
         _svc->get_service_id(), 10000, "test-admin", oss.str(), true,
         comment::external, false, 0);
-    comment::comments.insert({cmt->get_comment_id(), cmt});
+    comment::insert_comment(cmt);
   }
   ASSERT_EQ(comment::comments.size(), 10u);
 
@@ -798,7 +798,7 @@ TEST_F(EngineRpc, DeleteAllServiceComments) {
         comment::service, comment::user, _host->get_host_id(),
         _svc->get_service_id(), 10000, "test-admin", oss.str(), true,
         comment::external, false, 0);
-    comment::comments.insert({cmt->get_comment_id(), cmt});
+    comment::insert_comment(cmt);
   }
   ASSERT_EQ(comment::comments.size(), 10u);
   output = execute("DeleteAllServiceComments bynames test_host test_svc");
@@ -827,7 +827,7 @@ TEST_F(EngineRpc, RemoveHostAcknowledgement) {
   auto cmt = std::make_shared<comment>(
       comment::host, comment::acknowledgment, _host->get_host_id(), 0, 10000,
       "test-admin", oss.str(), false, comment::external, false, 0);
-  comment::comments.insert({cmt->get_comment_id(), cmt});
+  comment::insert_comment(cmt);
 
   call_command_manager(th, &condvar, &mutex, &continuerunning);
   auto output = execute("RemoveHostAcknowledgement byhostid 12");
@@ -839,7 +839,7 @@ TEST_F(EngineRpc, RemoveHostAcknowledgement) {
   cmt = std::make_shared<comment>(
       comment::host, comment::acknowledgment, _host->get_host_id(), 0, 10000,
       "test-admin", oss.str(), false, comment::external, false, 0);
-  comment::comments.insert({cmt->get_comment_id(), cmt});
+  comment::insert_comment(cmt);
 
   output = execute("RemoveHostAcknowledgement byhostname test_host");
   {
@@ -867,7 +867,7 @@ TEST_F(EngineRpc, RemoveServiceAcknowledgement) {
       comment::service, comment::acknowledgment, _host->get_host_id(),
       _svc->get_service_id(), 10000, "test-admin", oss.str(), false,
       comment::external, false, 0);
-  comment::comments.insert({cmt->get_comment_id(), cmt});
+  comment::insert_comment(cmt);
 
   call_command_manager(th, &condvar, &mutex, &continuerunning);
 
@@ -882,7 +882,7 @@ TEST_F(EngineRpc, RemoveServiceAcknowledgement) {
                                   _host->get_host_id(), _svc->get_service_id(),
                                   10000, "test-admin", oss.str(), false,
                                   comment::external, false, 0);
-  comment::comments.insert({cmt->get_comment_id(), cmt});
+  comment::insert_comment(cmt);
 
   output = execute("RemoveServiceAcknowledgement byids 12 13");
   {
@@ -1783,6 +1783,31 @@ TEST_F(EngineRpc, ProcessHostCheckResultBadHost) {
   erpc.shutdown();
 }
 
+TEST_F(EngineRpc, ProcessCheckResults) {
+  enginerpc erpc("0.0.0.0", 40001);
+  std::unique_ptr<std::thread> th;
+  std::condition_variable condvar;
+  std::mutex mutex;
+  bool continuerunning = false;
+
+  call_command_manager(th, &condvar, &mutex, &continuerunning);
+  auto output = execute(
+      "ProcessCheckResults test_host/test_svc:0 '#12/#13:1' test_host:0 "
+      "unknown_host/test_svc:0 test_host/test_svc:5");
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    continuerunning = true;
+  }
+  condvar.notify_one();
+  th->join();
+
+  std::vector<std::string> expected{
+      "ProcessCheckResults: accepted=3 rejected=2", "statuses: 0 0 0 2 1"};
+  std::vector<std::string> result(output.begin(), output.end());
+  ASSERT_EQ(result, expected);
+  erpc.shutdown();
+}
+
 TEST_F(EngineRpc, NewThresholdsFile) {
   CreateFile(
       "/tmp/thresholds_file.json",
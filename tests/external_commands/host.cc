@@ -140,3 +140,54 @@ TEST_F(HostExternalCommand, AddHostComment) {
                      const_cast<char*>(cmd_del_last.c_str()));
   ASSERT_EQ(comment::comments.size(), 0u);
 }
+
+TEST_F(HostExternalCommand, DeleteHostAcknowledgementComments) {
+  configuration::applier::host hst_aply;
+  configuration::host hst;
+  configuration::host hst2;
+
+  ASSERT_TRUE(hst.parse("host_name", "test_srv"));
+  ASSERT_TRUE(hst.parse("address", "127.0.0.1"));
+  ASSERT_TRUE(hst.parse("_HOST_ID", "1"));
+  ASSERT_NO_THROW(hst_aply.add_object(hst));
+
+  ASSERT_TRUE(hst2.parse("host_name", "test_srv2"));
+  ASSERT_TRUE(hst2.parse("address", "127.0.0.1"));
+  ASSERT_TRUE(hst2.parse("_HOST_ID", "2"));
+  ASSERT_NO_THROW(hst_aply.add_object(hst2));
+
+  set_time(20000);
+  time_t now = time(nullptr);
+
+  auto add = [now](uint64_t host_id, comment::e_type entry_type,
+                   bool persistent) -> uint64_t {
+    std::shared_ptr<comment> com{
+        new comment(comment::host, entry_type, host_id, 0, now, "admin",
+                    "comment", persistent, comment::external, false, 0)};
+    comment::insert_comment(com);
+    return com->get_comment_id();
+  };
+  uint64_t ack1{add(1, comment::acknowledgment, false)};
+  uint64_t ack2{add(1, comment::acknowledgment, true)};
+  uint64_t user1{add(1, comment::user, false)};
+  uint64_t ack3{add(2, comment::acknowledgment, false)};
+  ASSERT_EQ(comment::comments.size(), 4u);
+
+  /* Only the non-persistent acknowledgement of test_srv is removed. */
+  comment::delete_host_acknowledgement_comments(
+      host::hosts["test_srv"].get());
+  ASSERT_EQ(comment::comments.size(), 3u);
+  ASSERT_EQ(comment::comments.count(ack1), 0u);
+  ASSERT_EQ(comment::comments.count(ack2), 1u);
+  ASSERT_EQ(comment::comments.count(user1), 1u);
+  ASSERT_EQ(comment::comments.count(ack3), 1u);
+
+  comment::delete_host_comments(1);
+  ASSERT_EQ(comment::comments.size(), 1u);
+  ASSERT_EQ(comment::comments.count(ack3), 1u);
+
+  /* The index follows deletions by id. */
+  ASSERT_TRUE(comment::delete_comment(ack3));
+  comment::delete_host_comments(2);
+  ASSERT_TRUE(comment::comments.empty());
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2021 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+
+#include "com/centreon/engine/logging/async_sink.hh"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "../timeperiod/utils.hh"
+#include "com/centreon/engine/logging/logger.hh"
+
+using namespace com::centreon::engine;
+
+static char const* log_path = "/tmp/centengine_ut_async_sink.log";
+
+class AsyncSink : public ::testing::Test {
+ public:
+  void SetUp() override { unlink(log_path); }
+  void TearDown() override { unlink(log_path); }
+
+  static std::string content() {
+    std::ifstream ifs(log_path);
+    std::ostringstream oss;
+    oss << ifs.rdbuf();
+    return oss.str();
+  }
+};
+
+TEST_F(AsyncSink, EachLineHasAHeader) {
+  set_time(1234);
+  logging::async_sink sink(log_path, false);
+  std::string msg("first\nsecond");
+  sink.log(logging::log_info_message, logging::basic, msg.c_str(), msg.size());
+  msg = "third\n";
+  sink.log(logging::log_info_message, logging::basic, msg.c_str(), msg.size());
+  sink.flush();
+  ASSERT_EQ(content(), "[1234] first\n[1234] second\n[1234] third\n");
+}
+
+TEST_F(AsyncSink, PidIsWritten) {
+  set_time(1234);
+  {
+    logging::async_sink sink(log_path, true);
+    sink.log(logging::log_info_message, logging::basic, "msg", 3);
+  }
+  std::ostringstream expected;
+  expected << "[1234] [" << getpid() << "] msg\n";
+  ASSERT_EQ(content(), expected.str());
+}
+
+TEST_F(AsyncSink, ConcurrentMessagesAreAllWritten) {
+  set_time(1234);
+  size_t const threads(4);
+  size_t const count(2 * logging::async_sink::queue_size);
+  std::string large(2 * logging::async_sink::inline_size, 'x');
+  logging::async_sink sink(log_path, false);
+  std::vector<std::thread> producers;
+  for (size_t t = 0; t < threads; ++t)
+    producers.emplace_back([&sink, count] {
+      for (size_t i = 0; i < count; ++i) {
+        std::string msg(std::to_string(i));
+        sink.log(logging::log_info_message, logging::basic, msg.c_str(),
+                 msg.size());
+      }
+    });
+  sink.log(logging::log_info_message, logging::basic, large.c_str(),
+           large.size());
+  for (std::thread& t : producers)
+    t.join();
+  sink.flush();
+
+  std::istringstream iss(content());
+  std::string line;
+  size_t lines(0), large_lines(0);
+  while (std::getline(iss, line)) {
+    ++lines;
+    if (line == "[1234] " + large)
+      ++large_lines;
+  }
+  ASSERT_EQ(lines, threads * count + 1);
+  ASSERT_EQ(large_lines, 1u);
+}
@@ -22,11 +22,15 @@
 #include <gtest/gtest.h>
 #include <time.h>
 
+#include <algorithm>
 #include <memory>
+#include <set>
+#include <vector>
 
 #include "../test_engine.hh"
 #include "../timeperiod/utils.hh"
 #include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/checks/exec_time_estimator.hh"
 #include "com/centreon/engine/configuration/applier/contact.hh"
 #include "com/centreon/engine/configuration/applier/host.hh"
 #include "com/centreon/engine/configuration/applier/service.hh"
@@ -152,3 +156,92 @@ TEST_F(LoopTest, ScheduledDowntime) {
    * consumed by the loop. */
   ASSERT_NO_THROW(events::loop::instance().run());
 }
+
+TEST_F(LoopTest, AdjustCheckSchedulingFlattensPeaks) {
+  configuration::applier::service svc_aply;
+  for (int i = 0; i < 4; ++i) {
+    configuration::service svc{new_configuration_service(
+        "test_host", "peak_svc" + std::to_string(i), "admin")};
+    svc_aply.add_object(svc);
+    svc_aply.resolve_object(svc);
+  }
+
+  set_time(1000);
+  config->auto_rescheduling_window(10);
+  /* All the services take 1s and start at the same second, the host check
+   * is alone. */
+  for (auto const& p : engine::service::services) {
+    checks::exec_time_estimator::instance().add(*p.second, 1.0);
+    events::loop::instance().reschedule_event(
+        new timed_event(timed_event::EVENT_SERVICE_CHECK, 1005, false, 0L,
+                        nullptr, true, p.second.get(), nullptr, 0),
+        events::loop::low);
+  }
+  checks::exec_time_estimator::instance().add(*_host, 1.0);
+  events::loop::instance().reschedule_event(
+      new timed_event(timed_event::EVENT_HOST_CHECK, 1002, false, 0L, nullptr,
+                      true, _host.get(), nullptr, 0),
+      events::loop::low);
+
+  events::loop::instance().adjust_check_scheduling();
+
+  /* One check per second, in the window. */
+  std::set<time_t> times{_host->get_next_check()};
+  ASSERT_EQ(_host->get_next_check(), 1002);
+  for (auto const& p : engine::service::services) {
+    time_t next_check{p.second->get_next_check()};
+    ASSERT_GT(next_check, 1000);
+    ASSERT_LE(next_check, 1010);
+    ASSERT_TRUE(times.insert(next_check).second);
+    timed_event* evt{events::loop::instance().find_event(
+        events::loop::low, timed_event::EVENT_SERVICE_CHECK, p.second.get())};
+    ASSERT_EQ(evt->run_time, next_check);
+  }
+  /* One service check stays at its time. */
+  ASSERT_EQ(times.count(1005), 1u);
+
+  /* A flat schedule is kept. */
+  events::loop::instance().adjust_check_scheduling();
+  for (auto const& p : engine::service::services)
+    ASSERT_TRUE(times.count(p.second->get_next_check()));
+  events::loop::instance().clear();
+}
+
+TEST_F(LoopTest, AdjustCheckSchedulingSpreadsLongChecks) {
+  configuration::applier::service svc_aply;
+  for (int i = 0; i < 2; ++i) {
+    configuration::service svc{new_configuration_service(
+        "test_host", "long_svc" + std::to_string(i), "admin")};
+    svc_aply.add_object(svc);
+    svc_aply.resolve_object(svc);
+  }
+
+  set_time(1000);
+  config->auto_rescheduling_window(12);
+  /* The three services take 3s and start at three following seconds: they
+   * overlap even though no second starts two checks. */
+  time_t start{1001};
+  for (auto const& p : engine::service::services) {
+    checks::exec_time_estimator::instance().add(*p.second, 3.0);
+    events::loop::instance().reschedule_event(
+        new timed_event(timed_event::EVENT_SERVICE_CHECK, start++, false, 0L,
+                        nullptr, true, p.second.get(), nullptr, 0),
+        events::loop::low);
+  }
+
+  events::loop::instance().adjust_check_scheduling();
+
+  /* One check runs at a time, the last one keeps its time. */
+  std::vector<time_t> times;
+  for (auto const& p : engine::service::services)
+    times.push_back(p.second->get_next_check());
+  std::sort(times.begin(), times.end());
+  ASSERT_EQ(times.size(), 3u);
+  ASSERT_GT(times.front(), 1000);
+  ASSERT_LE(times.back(), 1012);
+  ASSERT_GE(times[1] - times[0], 3);
+  ASSERT_GE(times[2] - times[1], 3);
+  ASSERT_GE(times[0] + 12 - times[2], 3);
+  ASSERT_NE(std::find(times.begin(), times.end(), 1003), times.end());
+  events::loop::instance().clear();
+}
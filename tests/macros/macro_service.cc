@@ -45,6 +45,7 @@
 #include <com/centreon/engine/macros/process.hh>
 #include <com/centreon/engine/macros.hh>
 #include "com/centreon/engine/timeperiod.hh"
+#include "com/centreon/engine/utils.hh"
 
 using namespace com::centreon;
 using namespace com::centreon::engine;
@@ -2087,4 +2088,62 @@ TEST_F(MacroService, LastServiceProblemID) {
   service::services[std::make_pair("test_host", "test_svc")]->set_long_plugin_output("test_long_output");
   process_macros_r(mac, "$LASTSERVICEPROBLEMID:test_host:test_svc$", out, 1);
   ASSERT_EQ(out, "0");
-}
\ No newline at end of file
+}
+TEST_F(MacroService, CheckCommandArgs) {
+  configuration::applier::host hst_aply;
+  configuration::applier::service svc_aply;
+  configuration::service svc;
+  configuration::host hst;
+  ASSERT_TRUE(hst.parse("host_name", "test_host"));
+  ASSERT_TRUE(hst.parse("address", "127.0.0.1"));
+  ASSERT_TRUE(hst.parse("_HOST_ID", "12"));
+  ASSERT_NO_THROW(hst_aply.add_object(hst));
+  ASSERT_TRUE(svc.parse("description", "test_svc"));
+  ASSERT_TRUE(svc.parse("host_name", "test_host"));
+  ASSERT_TRUE(svc.parse("_HOST_ID", "12"));
+  ASSERT_TRUE(svc.parse("_SERVICE_ID", "13"));
+  // We fake the expand_object
+  svc.set_host_id(12);
+
+  configuration::command cmd("cmd");
+  cmd.parse("command_line", "echo $ARG1$ $ARG2$");
+  svc.parse("check_command", "cmd!static\\!arg!$HOSTADDRESS$!!last");
+  configuration::applier::command cmd_aply;
+  cmd_aply.add_object(cmd);
+  ASSERT_NO_THROW(svc_aply.add_object(svc));
+  init_macros();
+
+  std::shared_ptr<engine::service> s{
+      service::services[std::make_pair("test_host", "test_svc")]};
+  s->set_check_command_ptr(commands::command::commands["cmd"].get());
+
+  /* Arguments are parsed once, with a flag on the ones with macros. */
+  checkable::command_args const& argv{s->get_check_command_argv()};
+  ASSERT_EQ(argv.size(), 4u);
+  ASSERT_EQ(argv[0].value, "static!arg");
+  ASSERT_FALSE(argv[0].has_macros);
+  ASSERT_EQ(argv[1].value, "$HOSTADDRESS$");
+  ASSERT_TRUE(argv[1].has_macros);
+  ASSERT_EQ(argv[2].value, "");
+  ASSERT_EQ(argv[3].value, "last");
+
+  /* Same $ARGn$ macros as with the raw check command. */
+  nagios_macros* mac(get_global_macros());
+  grab_host_macros_r(mac, host::hosts["test_host"].get());
+  std::string out;
+  ASSERT_EQ(get_check_command_line_r(mac, s.get(), out, 0), OK);
+  ASSERT_EQ(out, "echo $ARG1$ $ARG2$");
+  std::array<std::string, MAX_COMMAND_ARGUMENTS> cached{mac->argv};
+  ASSERT_EQ(cached[0], "static!arg");
+  ASSERT_EQ(cached[1], "127.0.0.1");
+  ASSERT_EQ(cached[3], "last");
+  get_raw_command_line_r(mac, s->get_check_command_ptr(),
+                         s->get_check_command(), out, 0);
+  ASSERT_EQ(mac->argv, cached);
+
+  /* A new check command replaces the arguments. */
+  s->set_check_command("cmd!other");
+  ASSERT_EQ(get_check_command_line_r(mac, s.get(), out, 0), OK);
+  ASSERT_EQ(mac->argv[0], "other");
+  ASSERT_EQ(mac->argv[1], "");
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2021 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/engine/memory_stats.hh"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+
+#include "../test_engine.hh"
+#include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/configuration/applier/contact.hh"
+#include "com/centreon/engine/configuration/applier/host.hh"
+#include "com/centreon/engine/configuration/applier/service.hh"
+#include "com/centreon/engine/modules/external_commands/commands.hh"
+#include "helper.hh"
+
+using namespace com::centreon::engine;
+
+static char const* profile_path = "/tmp/centengine_ut_memory_profile";
+
+class MemoryStats : public TestEngine {
+ public:
+  void SetUp() override {
+    init_config_state();
+
+    configuration::applier::contact ct_aply;
+    configuration::contact ctct{new_configuration_contact("admin", true)};
+    ct_aply.add_object(ctct);
+    ct_aply.expand_objects(*config);
+    ct_aply.resolve_object(ctct);
+
+    configuration::host hst{new_configuration_host("test_host", "admin")};
+    configuration::applier::host hst_aply;
+    hst_aply.add_object(hst);
+
+    configuration::service svc{
+        new_configuration_service("test_host", "test_svc", "admin")};
+    configuration::applier::service svc_aply;
+    svc_aply.add_object(svc);
+
+    hst_aply.resolve_object(hst);
+    svc_aply.resolve_object(svc);
+
+    _svc = service::services.begin()->second;
+    std::remove(profile_path);
+  }
+
+  void TearDown() override {
+    _svc.reset();
+    deinit_config_state();
+    std::remove(profile_path);
+  }
+
+  static memory_stats::usage find(std::string const& subsystem) {
+    for (memory_stats::usage const& u : memory_stats::get_usage())
+      if (u.subsystem == subsystem)
+        return u;
+    ADD_FAILURE() << "no subsystem " << subsystem;
+    return memory_stats::usage{subsystem, 0, 0};
+  }
+
+ protected:
+  std::shared_ptr<service> _svc;
+};
+
+TEST_F(MemoryStats, StringSize) {
+  ASSERT_EQ(memory_stats::string_size(""), 0u);
+  ASSERT_EQ(memory_stats::string_size("short"), 0u);
+  std::string long_str(1000, 'a');
+  ASSERT_GT(memory_stats::string_size(long_str), 1000u);
+}
+
+TEST_F(MemoryStats, ObjectsAreCounted) {
+  ASSERT_EQ(find("hosts").objects, 1u);
+  ASSERT_EQ(find("services").objects, 1u);
+  ASSERT_EQ(find("contacts").objects, 1u);
+  ASSERT_EQ(find("checkable_states").objects, 2u);
+
+  /* A long output is accounted to services. */
+  uint64_t before(find("services").bytes);
+  _svc->set_plugin_output(std::string(4096, 'x'));
+  ASSERT_GE(find("services").bytes, before + 4096);
+}
+
+TEST_F(MemoryStats, DumpMemoryProfile) {
+  std::ostringstream oss;
+  oss << '[' << std::time(nullptr) << ']' << " DUMP_MEMORY_PROFILE;"
+      << profile_path;
+  process_external_command(oss.str().c_str());
+  checks::checker::instance().reap();
+
+  std::ifstream ifs(profile_path);
+  ASSERT_TRUE(ifs.is_open());
+  std::ostringstream content;
+  content << ifs.rdbuf();
+  ASSERT_NE(content.str().find("\nservices "), std::string::npos);
+  ASSERT_NE(content.str().find("\ntotal_tracked "), std::string::npos);
+  ASSERT_NE(content.str().find("service test_host;test_svc\n"),
+            std::string::npos);
+}
@@ -1090,3 +1090,47 @@ TEST_F(HostNotification, HostEscalationRetention) {
 
   ASSERT_EQ(notification0, notification1);
 }
+
+// Given a host with the admin contact and a contactgroup also containing admin
+// Then admin is listed once in its resolved contacts
+// And the list is only built again when memberships change.
+TEST_F(HostNotification, ResolvedContactsAreDeduplicated) {
+  configuration::applier::contact ct_aply;
+  configuration::contact ctct{new_configuration_contact("test_contact", false)};
+  ct_aply.add_object(ctct);
+  ct_aply.expand_objects(*config);
+  ct_aply.resolve_object(ctct);
+
+  configuration::applier::contactgroup cg_aply;
+  configuration::contactgroup cg{
+      new_configuration_contactgroup("test_cg", "admin")};
+  cg_aply.add_object(cg);
+  cg_aply.expand_objects(*config);
+  cg_aply.resolve_object(cg);
+
+  configuration::applier::hostescalation he_aply;
+  configuration::hostescalation he{
+      new_configuration_hostescalation("test_host", "test_cg")};
+  he_aply.add_object(he);
+  he_aply.expand_objects(*config);
+  he_aply.resolve_object(he);
+
+  engine::contactgroup* grp{
+      engine::contactgroup::contactgroups["test_cg"].get()};
+  _host->get_contactgroups().insert({"test_cg", grp});
+  engine::contactgroup::members_changed();
+
+  ASSERT_EQ(_host->get_resolved_contacts().size(), 1u);
+  ASSERT_EQ(_host->get_resolved_contacts()[0]->get_name(), "admin");
+  ASSERT_EQ(_host->get_escalations().size(), 1u);
+  engine::escalation* esc{_host->get_escalations().front()};
+  ASSERT_EQ(esc->get_resolved_contacts().size(), 1u);
+
+  grp->get_members().insert(
+      {"test_contact", engine::contact::contacts["test_contact"].get()});
+  ASSERT_EQ(_host->get_resolved_contacts().size(), 1u);
+
+  engine::contactgroup::members_changed();
+  ASSERT_EQ(_host->get_resolved_contacts().size(), 2u);
+  ASSERT_EQ(esc->get_resolved_contacts().size(), 2u);
+}
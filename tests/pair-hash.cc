@@ -0,0 +1,49 @@
+/*
+ * Copyright 2021 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <unordered_set>
+
+#include "com/centreon/engine/hash.hh"
+
+TEST(PairHash, OrderMatters) {
+  pair_hash h;
+  ASSERT_NE(h(std::make_pair(std::string("srv"), std::string("ping"))),
+            h(std::make_pair(std::string("ping"), std::string("srv"))));
+  ASSERT_NE(h(std::make_pair(12ul, 13ul)), h(std::make_pair(13ul, 12ul)));
+}
+
+TEST(PairHash, SameNames) {
+  pair_hash h;
+  std::string a("cpu");
+  std::string b("memory");
+  ASSERT_NE(h(std::make_pair(a, a)), h(std::make_pair(b, b)));
+}
+
+TEST(PairHash, IdsDoNotCollide) {
+  pair_hash h;
+  std::unordered_set<size_t> hashes;
+  for (uint64_t host_id = 1; host_id <= 200; ++host_id)
+    for (uint64_t service_id = 1; service_id <= 200; ++service_id)
+      hashes.insert(h(std::make_pair(host_id, service_id)));
+  /* With a XOR of the ids, there were only 256 different values. */
+  ASSERT_EQ(hashes.size(), 200u * 200u);
+}
@@ -1,6 +1,96 @@
+#include <chrono>
+#include <random>
 #include "com/centreon/engine/utils.hh"
 #include "gtest/gtest.h"
 
+/* The former implementation, that splits lines with find()/substr(). It is
+ * the reference of the equivalence tests. */
+static void legacy_parse_check_output(std::string const& buffer,
+                                      std::string& short_buffer,
+                                      std::string& long_buffer,
+                                      std::string& pd_buffer,
+                                      bool escape_newlines_please,
+                                      bool newlines_are_escaped) {
+  bool long_pipe{false};
+  bool perfdata_already_filled{false};
+
+  bool eof{false};
+  std::string line;
+  /* pos_line is used to cut a line
+   * start_line is the position of the line begin
+   * end_line is the position of the line end. */
+  size_t start_line{0}, end_line, pos_line;
+  int line_number{1};
+  while (!eof) {
+    if (newlines_are_escaped &&
+        (pos_line = buffer.find("\\n", start_line)) != std::string::npos) {
+      end_line = pos_line;
+      pos_line += 2;
+    } else if ((pos_line = buffer.find("\n", start_line)) !=
+               std::string::npos) {
+      end_line = pos_line;
+      pos_line++;
+    } else {
+      end_line = buffer.size();
+      eof = true;
+    }
+    line = buffer.substr(start_line, end_line - start_line);
+    size_t pipe;
+    if (!long_pipe)
+      pipe = line.find_last_of('|');
+    else
+      pipe = std::string::npos;
+
+    if (pipe != std::string::npos) {
+      end_line = pipe;
+      /* Let's trim the output */
+      while (end_line > 1 && std::isspace(line[end_line - 1]))
+        end_line--;
+
+      /* Let's trim the output */
+      pipe++;
+      while (pipe < line.size() - 1 && std::isspace(line[pipe]))
+        pipe++;
+
+      if (line_number == 1) {
+        short_buffer.append(line.substr(0, end_line));
+        pd_buffer.append(line.substr(pipe));
+        perfdata_already_filled = true;
+      } else {
+        if (line_number > 2)
+          long_buffer.append(escape_newlines_please ? "\\n" : "\n");
+        long_buffer.append(line.substr(0, end_line));
+        if (perfdata_already_filled)
+          pd_buffer.append(" ");
+        pd_buffer.append(line.substr(pipe));
+        // Now, all new lines contain perfdata.
+        long_pipe = true;
+      }
+    } else {
+      /* Let's trim the output */
+      end_line = line.size();
+      while (end_line > 1 && std::isspace(line[end_line - 1]))
+        end_line--;
+      line.erase(end_line);
+      if (line_number == 1)
+        short_buffer.append(line);
+      else {
+        if (!long_pipe) {
+          if (line_number > 2)
+            long_buffer.append(escape_newlines_please ? "\\n" : "\n");
+          long_buffer.append(line);
+        } else {
+          if (perfdata_already_filled)
+            pd_buffer.append(" ");
+          pd_buffer.append(line);
+        }
+      }
+    }
+    start_line = pos_line;
+    line_number++;
+  }
+}
+
 TEST(ParseCheckOutput, singleLineWithoutPerfdata) {
   std::string buf = "The service is OK";
   std::string short_output;
@@ -182,3 +272,69 @@ TEST(ParseCheckOutput, CheckDummy) {
   ASSERT_EQ(long_output, "");
   ASSERT_EQ(perf_data, "v3metric1=1 v3metric2=18;1 v3metric3=12;1;2;0;");
 }
+
+TEST(ParseCheckOutput, SameAsLegacy) {
+  std::mt19937 gen(42);
+  char const alphabet[] = "ab |\\n\n \t=;";
+  for (int i = 0; i < 100000; ++i) {
+    std::string buf;
+    for (size_t len = gen() % 40; len; --len)
+      buf.push_back(alphabet[gen() % (sizeof(alphabet) - 1)]);
+    for (int flags = 0; flags < 4; ++flags) {
+      std::string short_output, long_output, perf_data;
+      std::string ref_short_output, ref_long_output, ref_perf_data;
+      parse_check_output(buf, short_output, long_output, perf_data, flags & 1,
+                         flags & 2);
+      legacy_parse_check_output(buf, ref_short_output, ref_long_output,
+                                ref_perf_data, flags & 1, flags & 2);
+      ASSERT_EQ(short_output, ref_short_output) << buf << " " << flags;
+      ASSERT_EQ(long_output, ref_long_output) << buf << " " << flags;
+      ASSERT_EQ(perf_data, ref_perf_data) << buf << " " << flags;
+    }
+  }
+}
+
+/* Throughput of the splitter compared to the former implementation on a
+ * large multi-line output with perfdata on each line. Run it with
+ * --gtest_also_run_disabled_tests, the figures are test properties of the
+ * report. */
+TEST(ParseCheckOutput, DISABLED_Benchmark) {
+  std::string buf;
+  for (int i = 0; i < 500; ++i)
+    buf.append("OK - line ")
+        .append(std::to_string(i))
+        .append(" of a large plugin output | metric")
+        .append(std::to_string(i))
+        .append("=1;2;3;0;10\n");
+  constexpr int loops = 200;
+
+  std::string short_output, long_output, perf_data;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < loops; ++i) {
+    short_output.clear();
+    long_output.clear();
+    perf_data.clear();
+    parse_check_output(buf, short_output, long_output, perf_data, true, true);
+  }
+  std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+
+  std::string ref_short_output, ref_long_output, ref_perf_data;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < loops; ++i) {
+    ref_short_output.clear();
+    ref_long_output.clear();
+    ref_perf_data.clear();
+    legacy_parse_check_output(buf, ref_short_output, ref_long_output,
+                              ref_perf_data, true, true);
+  }
+  std::chrono::duration<double> ref_d =
+      std::chrono::steady_clock::now() - start;
+
+  RecordProperty("kb_per_s",
+                 static_cast<int>(buf.size() * loops / d.count() / 1e3));
+  RecordProperty("legacy_kb_per_s",
+                 static_cast<int>(buf.size() * loops / ref_d.count() / 1e3));
+  ASSERT_EQ(short_output, ref_short_output);
+  ASSERT_EQ(long_output, ref_long_output);
+  ASSERT_EQ(perf_data, ref_perf_data);
+}
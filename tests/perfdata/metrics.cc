@@ -0,0 +1,179 @@
+/*
+ * Copyright 2021 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "com/centreon/engine/perfdata.hh"
+#include "com/centreon/engine/string.hh"
+
+using namespace com::centreon::engine;
+
+static std::string str(char const* s, size_t size) {
+  return std::string(s, size);
+}
+
+TEST(PerfdataMetrics, Full) {
+  std::string pd("rta=0.053ms;3000.000;5000.000;0; pl=0%;80;100;0;100");
+  perfdata p;
+  p.parse(pd);
+  ASSERT_EQ(p.metrics().size(), 2u);
+
+  perfdata::metric const& rta(p.metrics()[0]);
+  ASSERT_EQ(str(rta.text, rta.text_size), "rta=0.053ms;3000.000;5000.000;0;");
+  ASSERT_EQ(str(rta.label, rta.label_size), "rta");
+  ASSERT_EQ(str(rta.uom, rta.uom_size), "ms");
+  ASSERT_DOUBLE_EQ(rta.value, 0.053);
+  ASSERT_DOUBLE_EQ(rta.warning.low, 0.0);
+  ASSERT_DOUBLE_EQ(rta.warning.high, 3000.0);
+  ASSERT_FALSE(rta.warning.inside);
+  ASSERT_DOUBLE_EQ(rta.critical.high, 5000.0);
+  ASSERT_DOUBLE_EQ(rta.min, 0.0);
+  ASSERT_TRUE(std::isnan(rta.max));
+
+  perfdata::metric const& pl(p.metrics()[1]);
+  ASSERT_EQ(str(pl.label, pl.label_size), "pl");
+  ASSERT_EQ(str(pl.uom, pl.uom_size), "%");
+  ASSERT_DOUBLE_EQ(pl.max, 100.0);
+}
+
+TEST(PerfdataMetrics, QuotesAndTypes) {
+  std::string pd(
+      "'aa a aa'=2;3;7;1;9 g[a aa]=12;25;50;0;118 d[aa a]=28 'it''s'=1");
+  perfdata p;
+  p.parse(pd);
+  ASSERT_EQ(p.metrics().size(), 4u);
+  ASSERT_EQ(p.find("aa a aa")->value, 2.0);
+  ASSERT_EQ(p.find("a aa")->type, 'g');
+  ASSERT_EQ(str(p.find("a aa")->text, p.find("a aa")->text_size),
+            "g[a aa]=12;25;50;0;118");
+  ASSERT_EQ(p.find("aa a")->type, 'd');
+  ASSERT_EQ(p.find("aa a")->value, 28.0);
+  ASSERT_EQ(p.find("it's")->value, 1.0);
+  ASSERT_EQ(p.find("a"), nullptr);
+}
+
+/* A metric found by its label has the text given by extract_perfdata(). */
+TEST(PerfdataMetrics, SameAsExtractPerfdata) {
+  struct {
+    char const* perfdata;
+    char const* label;
+  } const cases[]{
+      {"'d[foo]'=1;2;3", "foo"},
+      {"'d[foo]'=1;2;3", "d[foo]"},
+      {"'g[foo bar]'=4 d[foo]=5", "foo bar"},
+      {"'g[foo bar]'=4 d[foo]=5", "foo"},
+      {"d[ab=1 g[c]=2", "c"},
+      {"d[ab=1 g[c]=2", "ab"},
+      {"d[ab=1 g[c]=2", "d[ab"},
+      {"a[x]=7 y=8", "x"},
+  };
+  for (auto const& c : cases) {
+    std::string pd(c.perfdata);
+    perfdata p;
+    p.parse(pd);
+    perfdata::metric const* m(p.find(c.label));
+    ASSERT_EQ(m ? str(m->text, m->text_size) : "",
+              string::extract_perfdata(pd, c.label))
+        << pd << " / " << c.label;
+  }
+
+  /* extract_perfdata() does not unescape quotes. */
+  std::string pd("a[x]=7 'it''s'=1 'd[l''a]'=2");
+  perfdata p;
+  p.parse(pd);
+  ASSERT_EQ(p.metrics().size(), 3u);
+  ASSERT_EQ(p.find("it''s"), nullptr);
+  perfdata::metric const* m(p.find("it's"));
+  ASSERT_NE(m, nullptr);
+  ASSERT_EQ(str(m->text, m->text_size),
+            string::extract_perfdata(pd, "it''s"));
+  m = p.find("l'a");
+  ASSERT_NE(m, nullptr);
+  ASSERT_EQ(m->type, 'd');
+  ASSERT_EQ(str(m->text, m->text_size),
+            string::extract_perfdata(pd, "l''a"));
+}
+
+TEST(PerfdataMetrics, Ranges) {
+  std::string pd("a=1;10:;~:5 b=2;@10:20;5:6 c=U;;;; =3 d");
+  perfdata p;
+  p.parse(pd);
+  ASSERT_EQ(p.metrics().size(), 3u);
+
+  perfdata::metric const& a(p.metrics()[0]);
+  ASSERT_DOUBLE_EQ(a.warning.low, 10.0);
+  ASSERT_TRUE(std::isinf(a.warning.high));
+  ASSERT_TRUE(std::isinf(a.critical.low) && a.critical.low < 0);
+  ASSERT_DOUBLE_EQ(a.critical.high, 5.0);
+
+  perfdata::metric const& b(p.metrics()[1]);
+  ASSERT_TRUE(b.warning.inside);
+  ASSERT_DOUBLE_EQ(b.warning.low, 10.0);
+  ASSERT_DOUBLE_EQ(b.warning.high, 20.0);
+  ASSERT_FALSE(b.critical.inside);
+  ASSERT_DOUBLE_EQ(b.critical.low, 5.0);
+
+  perfdata::metric const& c(p.metrics()[2]);
+  ASSERT_TRUE(std::isnan(c.value));
+  ASSERT_TRUE(std::isnan(c.warning.high));
+  ASSERT_TRUE(std::isnan(c.min));
+}
+
+TEST(PerfdataMetrics, NoSpaceBeforeValue) {
+  std::string pd("a= 1 b=\t2 c=3");
+  perfdata p;
+  p.parse(pd);
+  ASSERT_EQ(p.metrics().size(), 3u);
+  ASSERT_TRUE(std::isnan(p.find("a")->value));
+  ASSERT_TRUE(std::isnan(p.find("b")->value));
+  ASSERT_EQ(p.find("c")->value, 3.0);
+}
+
+TEST(PerfdataMetrics, SeveralEscapedLabels) {
+  std::string pd("'it''s'=1 'a''b''c'=2 x=3 'd''e'=4");
+  perfdata p;
+  p.parse(pd);
+  ASSERT_EQ(p.metrics().size(), 4u);
+  ASSERT_EQ(p.find("it's")->value, 1.0);
+  ASSERT_EQ(p.find("a'b'c")->value, 2.0);
+  ASSERT_EQ(p.find("d'e")->value, 4.0);
+
+  /* Parsing again replaces the unescaped labels. */
+  std::string other("'f''g'=5");
+  p.parse(other);
+  ASSERT_EQ(p.metrics().size(), 1u);
+  ASSERT_EQ(p.find("f'g")->value, 5.0);
+  ASSERT_EQ(p.find("it's"), nullptr);
+}
+
+TEST(PerfdataMetrics, ParseAgainReusesMemory) {
+  std::string pd("a=1 b=2 c=3");
+  perfdata p;
+  p.parse(pd);
+  perfdata::metric const* first{p.metrics().data()};
+  std::string other("x=4 y=5");
+  p.parse(other);
+  ASSERT_EQ(p.metrics().data(), first);
+  ASSERT_EQ(p.metrics().size(), 2u);
+  ASSERT_EQ(p.find("y")->value, 5.0);
+  p.parse("");
+  ASSERT_TRUE(p.metrics().empty());
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2021 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+
+#include "com/centreon/engine/profiler.hh"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace com::centreon::engine;
+
+class Profiler : public ::testing::Test {
+ public:
+  void TearDown() override { profiler::set_enabled(false); }
+};
+
+TEST_F(Profiler, NothingRecordedWhenDisabled) {
+  profiler::set_enabled(true);
+  profiler::set_enabled(false);
+  {
+    profiler::scope timer{profiler::macro_expansion};
+  }
+  ASSERT_EQ(profiler::get_stats()[profiler::macro_expansion].calls, 0u);
+}
+
+TEST_F(Profiler, ScopesAreCountedInHistogram) {
+  profiler::set_enabled(true);
+  for (int i = 0; i < 3; ++i) {
+    profiler::scope timer{profiler::status_dump};
+  }
+  profiler::record(profiler::status_dump, std::chrono::milliseconds(20));
+
+  profiler::phase_stat const s(profiler::get_stats()[profiler::status_dump]);
+  ASSERT_EQ(s.calls, 4u);
+  ASSERT_GE(s.total_ns, 20000000u);
+  ASSERT_EQ(s.max_ns, 20000000u);
+  /* 20ms is between the 10ms and the 100ms bounds. */
+  ASSERT_EQ(s.histogram[5], 1u);
+  uint64_t total(0);
+  for (uint64_t b : s.histogram)
+    total += b;
+  ASSERT_EQ(total, 4u);
+  ASSERT_EQ(profiler::get_stats()[profiler::notification].calls, 0u);
+}
+
+TEST_F(Profiler, EnablingResetsCounters) {
+  profiler::set_enabled(true);
+  profiler::record(profiler::command_spawn, std::chrono::microseconds(5));
+  ASSERT_EQ(profiler::get_stats()[profiler::command_spawn].calls, 1u);
+
+  profiler::set_enabled(false);
+  ASSERT_EQ(profiler::get_stats()[profiler::command_spawn].calls, 1u);
+  profiler::set_enabled(true);
+  ASSERT_EQ(profiler::get_stats()[profiler::command_spawn].calls, 0u);
+}
+
+TEST_F(Profiler, ThreadsAreAggregated) {
+  profiler::set_enabled(true);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+    threads.emplace_back([] {
+      for (int j = 0; j < 1000; ++j)
+        profiler::record(profiler::neb_callback,
+                         std::chrono::nanoseconds(100));
+    });
+  for (std::thread& t : threads)
+    t.join();
+
+  /* Counters of the exited threads are kept. */
+  profiler::phase_stat const s(profiler::get_stats()[profiler::neb_callback]);
+  ASSERT_EQ(s.calls, 4000u);
+  ASSERT_EQ(s.total_ns, 400000u);
+  ASSERT_EQ(s.histogram[0], 4000u);
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2021 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+
+#include "../test_engine.hh"
+#include "../timeperiod/utils.hh"
+#include "com/centreon/engine/configuration/applier/contact.hh"
+#include "com/centreon/engine/configuration/applier/host.hh"
+#include "com/centreon/engine/configuration/applier/service.hh"
+#include "com/centreon/engine/xsddefault.hh"
+#include "helper.hh"
+
+using namespace com::centreon::engine;
+
+static char const* status_path = "/tmp/centengine_ut_status.dat";
+
+class StatusFile : public TestEngine {
+ public:
+  void SetUp() override {
+    init_config_state();
+
+    configuration::applier::contact ct_aply;
+    configuration::contact ctct{new_configuration_contact("admin", true)};
+    ct_aply.add_object(ctct);
+    ct_aply.expand_objects(*config);
+    ct_aply.resolve_object(ctct);
+
+    configuration::host hst{new_configuration_host("test_host", "admin")};
+    configuration::applier::host hst_aply;
+    hst_aply.add_object(hst);
+
+    configuration::service svc{
+        new_configuration_service("test_host", "test_svc", "admin")};
+    configuration::applier::service svc_aply;
+    svc_aply.add_object(svc);
+
+    hst_aply.resolve_object(hst);
+    svc_aply.resolve_object(svc);
+
+    _host = host::hosts.begin()->second;
+    _svc = service::services.begin()->second;
+    config->status_file(status_path);
+    ASSERT_EQ(xsddefault_initialize_status_data(), OK);
+  }
+
+  void TearDown() override {
+    xsddefault_cleanup_status_data(true);
+    _host.reset();
+    _svc.reset();
+    deinit_config_state();
+  }
+
+  /* Write the status file and wait for the writer thread. */
+  static std::string dump() {
+    EXPECT_EQ(xsddefault_save_status_data(), OK);
+    xsddefault_cleanup_status_data(false);
+    std::ifstream ifs(status_path);
+    std::ostringstream oss;
+    oss << ifs.rdbuf();
+    xsddefault_initialize_status_data();
+    return oss.str();
+  }
+
+ protected:
+  std::shared_ptr<host> _host;
+  std::shared_ptr<service> _svc;
+};
+
+TEST_F(StatusFile, AllBlocksAreWritten) {
+  std::string content(dump());
+  ASSERT_EQ(content.find("#####"), 0u);
+  ASSERT_NE(content.find("info {\n\tcreated="), std::string::npos);
+  ASSERT_NE(content.find("programstatus {\n"), std::string::npos);
+  ASSERT_NE(content.find("hoststatus {\n\thost_name=test_host\n"),
+            std::string::npos);
+  ASSERT_NE(content.find("servicestatus {\n\thost_name=test_host\n"
+                         "\tservice_description=test_svc\n"),
+            std::string::npos);
+  ASSERT_NE(content.find("contactstatus {\n\tcontact_name=admin\n"),
+            std::string::npos);
+  ASSERT_NE(content.find("\twaiting_service_checks=0\n"), std::string::npos);
+  ASSERT_NE(content.find("memorystatus {\n\tsubsystem=hosts\n\tobjects=1\n"),
+            std::string::npos);
+  /* One last_update line per host and service. */
+  size_t count(0);
+  for (size_t pos(content.find("\tlast_update=")); pos != std::string::npos;
+       pos = content.find("\tlast_update=", pos + 1))
+    ++count;
+  ASSERT_EQ(count, 2u);
+  ASSERT_NE(access((std::string(status_path) + ".tmp").c_str(), F_OK), 0);
+}
+
+TEST_F(StatusFile, MemoryUsageComputedPerInterval) {
+  set_time(20000);
+  ASSERT_NE(dump().find("\tsubsystem=hosts\n\tobjects=1\n"),
+            std::string::npos);
+
+  configuration::host hst{new_configuration_host("other_host", "admin", 13)};
+  configuration::applier::host hst_aply;
+  hst_aply.add_object(hst);
+
+  /* The memory usage of the previous dump is written again. */
+  set_time(20299);
+  std::string content(dump());
+  ASSERT_NE(content.find("hoststatus {\n\thost_name=other_host\n"),
+            std::string::npos);
+  ASSERT_NE(content.find("\tsubsystem=hosts\n\tobjects=1\n"),
+            std::string::npos);
+
+  set_time(20300);
+  ASSERT_NE(dump().find("\tsubsystem=hosts\n\tobjects=2\n"),
+            std::string::npos);
+}
+
+TEST_F(StatusFile, BlocksRenderedOnUpdateStatus) {
+  _svc->set_plugin_output("first output");
+  _svc->update_status();
+  ASSERT_NE(dump().find("\tplugin_output=first output\n"), std::string::npos);
+
+  /* Without update_status(), the cached block is written again. */
+  _svc->set_plugin_output("second output");
+  std::string content(dump());
+  ASSERT_NE(content.find("\tplugin_output=first output\n"), std::string::npos);
+  ASSERT_EQ(content.find("second output"), std::string::npos);
+
+  _svc->update_status();
+  content = dump();
+  ASSERT_NE(content.find("\tplugin_output=second output\n"),
+            std::string::npos);
+  ASSERT_EQ(content.find("first output"), std::string::npos);
+}
+
+TEST_F(StatusFile, ModifiedServiceIsRenderedAgain) {
+  /* A passive service is never rescheduled by the reload. */
+  _svc->set_checks_enabled(false);
+  _svc->update_status();
+  std::string content(dump());
+  ASSERT_NE(content.find("\tactive_checks_enabled=0\n"), std::string::npos);
+  ASSERT_NE(content.find("\tnotifications_enabled=1\n"), std::string::npos);
+
+  configuration::service svc{
+      new_configuration_service("test_host", "test_svc", "admin")};
+  svc.parse("active_checks_enabled", "0");
+  svc.parse("notifications_enabled", "0");
+  svc.parse("check_interval", "7");
+  configuration::applier::service svc_aply;
+  svc_aply.modify_object(svc);
+
+  content = dump();
+  size_t pos(content.find("servicestatus {"));
+  ASSERT_NE(pos, std::string::npos);
+  ASSERT_NE(content.find("\tnotifications_enabled=0\n", pos),
+            std::string::npos);
+  ASSERT_NE(content.find("\tcheck_interval=7\n", pos),
+            std::string::npos);
+}